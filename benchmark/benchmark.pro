@@ -0,0 +1,32 @@
+# Decodes a directory of images the way the app decodes viewfinder frames
+# and reports how long each step takes. Needs nothing but QtCore and QtGui:
+#
+#   qmake && make && ./barcode-benchmark [options] DIR
+#
+# Images in a directory named after a format (QR_CODE, EAN_13, ...) are
+# expected to decode as that format. FILE.txt next to FILE.png holds the
+# text it's expected to decode to. ../test/corpus is laid out that way, and
+# so is the output of barcode-test --generate DIR.
+
+TEMPLATE = app
+TARGET = barcode-benchmark
+CONFIG += console
+CONFIG -= app_bundle
+QT = core gui
+
+INCLUDEPATH += \
+    ../src/scanner \
+    ../harbour-lib/include
+
+SOURCES += \
+    main.cpp \
+    ../src/scanner/Decoder.cpp \
+    ../src/scanner/ImageSource.cpp \
+    ../src/scanner/Profiler.cpp
+
+HEADERS += \
+    ../src/scanner/Decoder.h \
+    ../src/scanner/ImageSource.h \
+    ../src/scanner/Profiler.h
+
+include(../src/zxing/zxing.pri)
@@ -0,0 +1,380 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "Decoder.h"
+#include "ImageSource.h"
+
+#include <zxing/common/Arena.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <QVector>
+
+#include <algorithm>
+#include <new>
+#include <stdlib.h>
+
+// Same as in BarcodeScanner::Private::decodingThread()
+#define DEFAULT_MAX_SIZE (800)
+
+#define RET_OK          (0)
+#define RET_CMDLINE     (1)
+#define RET_NO_IMAGES   (2)
+
+// ==========================================================================
+// Counting operator new
+// ==========================================================================
+
+#if __cplusplus >= 201103L
+#  define BENCHMARK_NOTHROW noexcept
+#  define BENCHMARK_THROW_BAD_ALLOC
+#else
+#  define BENCHMARK_NOTHROW throw()
+#  define BENCHMARK_THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+static unsigned long gNewCount = 0;
+
+void* operator new(size_t aSize) BENCHMARK_THROW_BAD_ALLOC
+{
+    void* ptr = malloc(aSize ? aSize : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    gNewCount++;
+    return ptr;
+}
+
+void operator delete(void* aPtr) BENCHMARK_NOTHROW
+{
+    free(aPtr);
+}
+
+// zxing objects come from zxing::Arena, which only goes to the heap
+// when it has no block to recycle
+static unsigned long allocations()
+{
+    return gNewCount + zxing::Arena::heapAllocations();
+}
+
+// ==========================================================================
+// Statistics
+// ==========================================================================
+
+enum Stage {
+    STAGE_SCALE,    // Decoder::scaleDown()
+    STAGE_GRAY,     // ImageSource conversion to grayscale
+    STAGE_DECODE,   // Decoder::decode()
+    STAGE_ROTATED,  // Rotating by 90 degrees and decoding again
+    STAGE_TOTAL,
+    STAGE_COUNT
+};
+
+static const char* const STAGE_NAME[STAGE_COUNT] = {
+    "scale", "gray", "decode", "rotated", "total"
+};
+
+struct FormatStats {
+    FormatStats() : images(0), hits(0) {}
+    int images;
+    int hits;
+};
+
+class Benchmark {
+public:
+    Benchmark(int aMaxSize, int aRuns, bool aFresh);
+
+    bool run(QString aPath);
+    void report(QTextStream& aOut);
+
+private:
+    Decoder::Result decode(Decoder* aDecoder, QImage aImage, qint64* aTime);
+    static QString expectedFormat(QString aPath);
+    static QString expectedText(QString aPath);
+    static QString percentile(QVector<qint64> aSamples, int aPercent);
+
+private:
+    int iMaxSize;
+    int iRuns;
+    bool iFresh;
+    QScopedPointer<Decoder> iDecoder;
+    QVector<qint64> iSamples[STAGE_COUNT];
+    QMap<QString,FormatStats> iFormats;
+    unsigned long iAllocations;
+    int iDecodes;
+    int iImages;
+};
+
+Benchmark::Benchmark(int aMaxSize, int aRuns, bool aFresh) :
+    iMaxSize(aMaxSize),
+    iRuns(aRuns),
+    iFresh(aFresh),
+    iAllocations(0),
+    iDecodes(0),
+    iImages(0)
+{
+}
+
+QString Benchmark::expectedFormat(QString aPath)
+{
+    // The name of the directory, if it's a format name
+    const QString dir(QFileInfo(aPath).dir().dirName());
+    for (int i = zxing::BarcodeFormat::NONE + 1;
+         i <= zxing::BarcodeFormat::ASSUME_GS1; i++) {
+        if (dir == QLatin1String(zxing::BarcodeFormat::barcodeFormatNames[i])) {
+            return dir;
+        }
+    }
+    return QString();
+}
+
+QString Benchmark::expectedText(QString aPath)
+{
+    const QFileInfo info(aPath);
+    QFile file(info.dir().filePath(info.completeBaseName() + ".txt"));
+    if (file.open(QIODevice::ReadOnly)) {
+        QString text(QString::fromUtf8(file.readAll()));
+        // Editors like to add a newline at the end
+        if (text.endsWith('\n')) {
+            text.chop(1);
+        }
+        return text;
+    }
+    return QString();
+}
+
+// Runs the image through the same steps as a viewfinder frame in
+// BarcodeScanner::Private::decodingThread()
+Decoder::Result Benchmark::decode(Decoder* aDecoder, QImage aImage,
+    qint64* aTime)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    qreal scale;
+    QImage scaledImage(Decoder::scaleDown(aImage, iMaxSize, &scale));
+    aTime[STAGE_SCALE] = timer.nsecsElapsed();
+
+    ImageSource* source = new ImageSource(scaledImage,
+        aDecoder->bufferPool());
+    zxing::Ref<zxing::LuminanceSource> sourceRef(source);
+    source->getMatrix();
+    aTime[STAGE_GRAY] = timer.nsecsElapsed() - aTime[STAGE_SCALE];
+
+    Decoder::Result result(aDecoder->decode(sourceRef));
+    aTime[STAGE_DECODE] = timer.nsecsElapsed() - aTime[STAGE_SCALE] -
+        aTime[STAGE_GRAY];
+
+    if (!result.isValid()) {
+        // Try the other orientation for 1D bar codes
+        result = aDecoder->decodeRotated(scaledImage);
+        aTime[STAGE_ROTATED] = timer.nsecsElapsed() - aTime[STAGE_SCALE] -
+            aTime[STAGE_GRAY] - aTime[STAGE_DECODE];
+    } else {
+        aTime[STAGE_ROTATED] = -1;
+    }
+
+    aTime[STAGE_TOTAL] = timer.nsecsElapsed();
+    return result;
+}
+
+bool Benchmark::run(QString aPath)
+{
+    QImage image(aPath);
+    if (image.isNull()) {
+        qWarning("Can't load %s", qPrintable(aPath));
+        return false;
+    }
+
+    if (iFresh || !iDecoder) {
+        iDecoder.reset(new Decoder);
+    }
+
+    const QString format(expectedFormat(aPath));
+    const QString text(expectedText(aPath));
+    Decoder::Result result;
+    for (int i = 0; i < iRuns; i++) {
+        qint64 time[STAGE_COUNT];
+        const unsigned long allocated = allocations();
+        Decoder::Result r(decode(iDecoder.data(), image, time));
+        iAllocations += allocations() - allocated;
+        iDecodes++;
+        for (int s = 0; s < STAGE_COUNT; s++) {
+            if (time[s] >= 0) {
+                iSamples[s].append(time[s]);
+            }
+        }
+        if (!i) {
+            result = r;
+        }
+    }
+
+    const bool hit = result.isValid() &&
+        (format.isEmpty() || result.getFormatName() == format) &&
+        (text.isNull() || result.getText() == text);
+    FormatStats& stats = iFormats[format.isEmpty() ? QString("-") : format];
+    stats.images++;
+    if (hit) {
+        stats.hits++;
+    }
+    iImages++;
+    qDebug("%s %s%s", qPrintable(aPath), hit ? "OK" : "FAIL",
+        result.isValid() ? qPrintable(" " + result.getFormatName() + " " +
+        result.getText().left(40).simplified()) : "");
+    return true;
+}
+
+// Nearest rank, in milliseconds
+QString Benchmark::percentile(QVector<qint64> aSamples, int aPercent)
+{
+    if (aSamples.isEmpty()) {
+        return QString("-");
+    }
+    std::sort(aSamples.begin(), aSamples.end());
+    const int n = aSamples.count();
+    const int rank = qBound(0, (n * aPercent + 99) / 100 - 1, n - 1);
+    return QString::number(aSamples.at(rank) / 1000000.0, 'f', 2);
+}
+
+void Benchmark::report(QTextStream& aOut)
+{
+    aOut << iImages << " images, " << iRuns << " run(s) each, frames "
+        "scaled to " << iMaxSize << " pixels\n\n";
+
+    aOut << qSetFieldWidth(10) << left << "stage" << right << "runs" <<
+        "p50" << "p90" << "p99" << "max" << qSetFieldWidth(0) << " ms\n";
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const QVector<qint64>& samples(iSamples[s]);
+        aOut << qSetFieldWidth(10) << left << STAGE_NAME[s] << right <<
+            samples.count() << percentile(samples, 50) <<
+            percentile(samples, 90) << percentile(samples, 99) <<
+            percentile(samples, 100) << qSetFieldWidth(0) << "\n";
+    }
+
+    aOut << "\n" << qSetFieldWidth(20) << left << "format" <<
+        qSetFieldWidth(10) << right << "images" << "hits" << "rate" <<
+        qSetFieldWidth(0) << "\n";
+    QMapIterator<QString,FormatStats> it(iFormats);
+    while (it.hasNext()) {
+        it.next();
+        const FormatStats& stats(it.value());
+        aOut << qSetFieldWidth(20) << left << it.key() <<
+            qSetFieldWidth(10) << right << stats.images << stats.hits <<
+            QString::number(100.0 * stats.hits / stats.images, 'f', 1) + "%" <<
+            qSetFieldWidth(0) << "\n";
+    }
+
+    if (iDecodes) {
+        aOut << "\n" << QString::number((double)iAllocations / iDecodes,
+            'f', 1) << " heap allocations per frame\n";
+    }
+    aOut.flush();
+}
+
+// ==========================================================================
+// main
+// ==========================================================================
+
+static QtMessageHandler gDefaultMessageHandler = NULL;
+
+static void quietMessageHandler(QtMsgType aType,
+    const QMessageLogContext& aContext, const QString& aMessage)
+{
+    if (aType != QtDebugMsg) {
+        gDefaultMessageHandler(aType, aContext, aMessage);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decodes images the way the app "
+        "decodes viewfinder frames and reports how long it takes.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("DIR", "Directory with images, searched "
+        "recursively");
+    QCommandLineOption runsOption(QStringList() << "r" << "runs",
+        "Decode each image N times (default 1)", "N", "1");
+    QCommandLineOption sizeOption(QStringList() << "s" << "max-size",
+        "Scale images down to SIZE pixels (default 800)", "SIZE",
+        QString::number(DEFAULT_MAX_SIZE));
+    QCommandLineOption freshOption(QStringList() << "f" << "fresh",
+        "New decoder for each image (the app keeps one while scanning)");
+    QCommandLineOption verboseOption(QStringList() << "v" << "verbose",
+        "Print the result for each image");
+    parser.addOption(runsOption);
+    parser.addOption(sizeOption);
+    parser.addOption(freshOption);
+    parser.addOption(verboseOption);
+    parser.process(app);
+
+    const QStringList args(parser.positionalArguments());
+    const int runs = parser.value(runsOption).toInt();
+    const int maxSize = parser.value(sizeOption).toInt();
+    if (args.count() != 1 || runs < 1 || maxSize < 1) {
+        parser.showHelp(RET_CMDLINE);
+    }
+
+    if (!parser.isSet(verboseOption)) {
+        gDefaultMessageHandler = qInstallMessageHandler(quietMessageHandler);
+    }
+
+    QStringList filters;
+    filters << "*.png" << "*.jpg" << "*.jpeg" << "*.bmp" << "*.gif" <<
+        "*.pgm" << "*.ppm";
+    QStringList files;
+    QDirIterator it(args.at(0), filters, QDir::Files,
+        QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.append(it.next());
+    }
+    files.sort();
+
+    Benchmark benchmark(maxSize, runs, parser.isSet(freshOption));
+    int count = 0;
+    for (int i = 0; i < files.count(); i++) {
+        if (benchmark.run(files.at(i))) {
+            count++;
+        }
+    }
+
+    if (!count) {
+        qWarning("No images in %s", qPrintable(args.at(0)));
+        return RET_NO_IMAGES;
+    }
+
+    QTextStream out(stdout);
+    benchmark.report(out);
+    return RET_OK;
+}
@@ -0,0 +1,32 @@
+# Decodes image files (or whole directory trees) in parallel, the way the
+# app decodes viewfinder frames, and prints one JSON object per file:
+#
+#   qmake && make && ./barcode-decode [options] PATH...
+#
+# Each line has the file name, the text, format and corner points of the
+# bar code if one was found, and the time taken by each step in ms (the
+# same stages and readers Profiler reports). Files that can't be read get
+# an "error" instead, and make the exit status non-zero.
+
+TEMPLATE = app
+TARGET = barcode-decode
+CONFIG += console
+CONFIG -= app_bundle
+QT = core gui
+
+INCLUDEPATH += \
+    ../src/scanner \
+    ../harbour-lib/include
+
+SOURCES += \
+    main.cpp \
+    ../src/scanner/Decoder.cpp \
+    ../src/scanner/ImageSource.cpp \
+    ../src/scanner/Profiler.cpp
+
+HEADERS += \
+    ../src/scanner/Decoder.h \
+    ../src/scanner/ImageSource.h \
+    ../src/scanner/Profiler.h
+
+include(../src/zxing/zxing.pri)
@@ -0,0 +1,537 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "Decoder.h"
+#include "Profiler.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QJsonDocument>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <stdio.h>
+
+// Same as in BarcodeScanner::Private::decodingThread()
+#define DEFAULT_MAX_SIZE (800)
+
+#define RET_OK          (0)
+#define RET_ERR_FILES   (1)
+#define RET_CMDLINE     (2)
+
+// ==========================================================================
+// Options
+// ==========================================================================
+
+class Options {
+public:
+    Options() : iMaxSize(DEFAULT_MAX_SIZE), iInverted(false), iMirrored(false) {}
+
+    bool isRaw(QString aPath) const
+    {
+        return iRawSize.isValid() && (aPath.endsWith(".gray") ||
+            aPath.endsWith(".raw"));
+    }
+
+public:
+    int iMaxSize;
+    QSize iRawSize;     // Invalid unless raw input is enabled
+    bool iInverted;
+    bool iMirrored;
+};
+
+// ==========================================================================
+// MappedSource
+// ==========================================================================
+
+// Raw 8-bit grayscale frame, rows are read straight from the mapped file
+class MappedSource : public zxing::LuminanceSource {
+    Q_DISABLE_COPY(MappedSource)
+
+public:
+    MappedSource(QFile* aFile, const uchar* aData, int aWidth, int aHeight,
+        zxing::Ref<zxing::BufferPool> aPool);
+    ~MappedSource();
+
+    // Shares the mapped memory
+    QImage image() const;
+
+    zxing::ArrayRef<zxing::byte> getRow(int aY, zxing::ArrayRef<zxing::byte> aRow) const Q_DECL_OVERRIDE;
+    zxing::ArrayRef<zxing::byte> getMatrix() const Q_DECL_OVERRIDE;
+
+    static zxing::Ref<MappedSource> map(QString aPath, QSize aSize,
+        zxing::Ref<zxing::BufferPool> aPool, QString* aError);
+
+private:
+    QFile* iFile;
+    const uchar* iData;
+    zxing::Ref<zxing::BufferPool> iPool;
+    mutable zxing::ArrayRef<zxing::byte> iMatrix;
+};
+
+MappedSource::MappedSource(QFile* aFile, const uchar* aData, int aWidth,
+    int aHeight, zxing::Ref<zxing::BufferPool> aPool) :
+    zxing::LuminanceSource(aWidth, aHeight),
+    iFile(aFile),
+    iData(aData),
+    iPool(aPool)
+{
+}
+
+MappedSource::~MappedSource()
+{
+    // Closing the file unmaps it
+    delete iFile;
+}
+
+zxing::Ref<MappedSource> MappedSource::map(QString aPath, QSize aSize,
+    zxing::Ref<zxing::BufferPool> aPool, QString* aError)
+{
+    QFile* file = new QFile(aPath);
+    const qint64 size = (qint64)aSize.width() * aSize.height();
+    if (file->open(QIODevice::ReadOnly)) {
+        if (file->size() >= size) {
+            const uchar* data = file->map(0, size);
+            if (data) {
+                return zxing::Ref<MappedSource>(new MappedSource(file, data,
+                    aSize.width(), aSize.height(), aPool));
+            }
+        } else {
+            file->setErrorString(QString("Expected at least %1 bytes").
+                arg(size));
+        }
+    }
+    *aError = file->errorString();
+    delete file;
+    return zxing::Ref<MappedSource>();
+}
+
+QImage MappedSource::image() const
+{
+    static QVector<QRgb> gray;
+    static QMutex grayMutex;
+    grayMutex.lock();
+    if (gray.isEmpty()) {
+        gray.resize(256);
+        for (int i = 0; i < 256; i++) {
+            gray[i] = qRgb(i, i, i);
+        }
+    }
+    grayMutex.unlock();
+    QImage image(iData, getWidth(), getHeight(), getWidth(),
+        QImage::Format_Indexed8);
+    image.setColorTable(gray);
+    return image;
+}
+
+zxing::ArrayRef<zxing::byte> MappedSource::getRow(int aY, zxing::ArrayRef<zxing::byte> aRow) const
+{
+    const int width = getWidth();
+    if (aRow->size() != width) {
+        aRow.reset(zxing::ArrayRef<zxing::byte>(width));
+    }
+    memcpy(&aRow[0], iData + aY * width, width);
+    return aRow;
+}
+
+zxing::ArrayRef<zxing::byte> MappedSource::getMatrix() const
+{
+    // ArrayRef can't wrap someone else's memory, the matrix has to be
+    // copied once. It's the only copy of the frame made though.
+    if (!iMatrix) {
+        const int size = getWidth() * getHeight();
+        iMatrix = iPool ? iPool->getBytes(size) :
+            zxing::ArrayRef<zxing::byte>(size);
+        memcpy(&iMatrix[0], iData, size);
+    }
+    return iMatrix;
+}
+
+// ==========================================================================
+// WorkQueue
+// ==========================================================================
+
+// Paths waiting to be decoded. Bounded, so that walking a huge tree
+// doesn't get far ahead of the decoding threads.
+class WorkQueue {
+public:
+    WorkQueue(int aCapacity) : iCapacity(aCapacity), iClosed(false) {}
+
+    void put(QString aPath);
+    bool take(QString* aPath);
+    void close();
+
+private:
+    QMutex iMutex;
+    QWaitCondition iNotEmpty;
+    QWaitCondition iNotFull;
+    QQueue<QString> iQueue;
+    const int iCapacity;
+    bool iClosed;
+};
+
+void WorkQueue::put(QString aPath)
+{
+    iMutex.lock();
+    while (iQueue.count() >= iCapacity) {
+        iNotFull.wait(&iMutex);
+    }
+    iQueue.enqueue(aPath);
+    iNotEmpty.wakeOne();
+    iMutex.unlock();
+}
+
+// Returns false once the queue is closed and empty
+bool WorkQueue::take(QString* aPath)
+{
+    iMutex.lock();
+    while (iQueue.isEmpty() && !iClosed) {
+        iNotEmpty.wait(&iMutex);
+    }
+    const bool ok = !iQueue.isEmpty();
+    if (ok) {
+        *aPath = iQueue.dequeue();
+        iNotFull.wakeOne();
+    }
+    iMutex.unlock();
+    return ok;
+}
+
+void WorkQueue::close()
+{
+    iMutex.lock();
+    iClosed = true;
+    iNotEmpty.wakeAll();
+    iMutex.unlock();
+}
+
+// ==========================================================================
+// Output
+// ==========================================================================
+
+// One JSON object per line, lines from different threads don't mix
+class Output {
+public:
+    Output() : iErrors(0) {}
+
+    void write(QVariantMap aResult);
+    int errors() const { return iErrors; }
+
+private:
+    QMutex iMutex;
+    int iErrors;
+};
+
+void Output::write(QVariantMap aResult)
+{
+    const QByteArray line(QJsonDocument::fromVariant(aResult).
+        toJson(QJsonDocument::Compact));
+    iMutex.lock();
+    if (aResult.contains("error")) {
+        iErrors++;
+    }
+    fwrite(line.constData(), 1, line.size(), stdout);
+    fputc('\n', stdout);
+    iMutex.unlock();
+}
+
+// ==========================================================================
+// Worker
+// ==========================================================================
+
+// Decoders and their buffer pools aren't thread safe, each thread has its
+// own and keeps it for all the files it gets. The readers are reset for
+// each file, so that a file decodes the same way whichever thread picks
+// it up and whatever that thread had decoded before.
+class Worker : public QThread {
+public:
+    Worker(const Options& aOptions, WorkQueue* aQueue, Output* aOutput) :
+        iOptions(aOptions), iQueue(aQueue), iOutput(aOutput) {}
+
+protected:
+    void run() Q_DECL_OVERRIDE;
+
+private:
+    QVariantMap decodeFile(Decoder* aDecoder, QString aPath);
+    QImage load(QString aPath, qreal* aScale, QString* aError);
+    Decoder::Result decode(Decoder* aDecoder, QImage aImage,
+        bool aTryUpright, Profiler::Frame* aFrame);
+
+private:
+    const Options& iOptions;
+    WorkQueue* iQueue;
+    Output* iOutput;
+};
+
+void Worker::run()
+{
+    Decoder decoder;
+    decoder.setTryInverted(iOptions.iInverted);
+    decoder.setTryMirrored(iOptions.iMirrored);
+    QString path;
+    while (iQueue->take(&path)) {
+        decoder.reset();
+        iOutput->write(decodeFile(&decoder, path));
+    }
+}
+
+// Large photos are decoded straight to the size they are going to be
+// scaled down to anyway, which is a lot faster (for JPEG) and keeps
+// full size images out of memory
+QImage Worker::load(QString aPath, qreal* aScale, QString* aError)
+{
+    QImageReader reader(aPath);
+    reader.setAutoTransform(true);
+    const QSize size(reader.size());
+    const int maxSize = iOptions.iMaxSize;
+    *aScale = 1;
+    if (size.width() > maxSize || size.height() > maxSize) {
+        const QSize scaledSize(size.scaled(maxSize, maxSize,
+            Qt::KeepAspectRatio));
+        reader.setScaledSize(scaledSize);
+        *aScale = (size.height() > size.width()) ?
+            (size.height() / (qreal)scaledSize.height()) :
+            (size.width() / (qreal)scaledSize.width());
+    }
+    QImage image(reader.read());
+    if (image.isNull()) {
+        *aError = reader.errorString();
+    }
+    return image;
+}
+
+// The same steps as BarcodeScanner::Private::decodingThread() takes after
+// cropping. Points are converted back to aImage coordinates.
+Decoder::Result Worker::decode(Decoder* aDecoder, QImage aImage,
+    bool aTryUpright, Profiler::Frame* aFrame)
+{
+    qreal scale;
+    Profiler::Timer scaleTimer(aFrame, Profiler::StageScale);
+    QImage scaledImage(Decoder::scaleDown(aImage, iOptions.iMaxSize, &scale));
+    scaleTimer.stop();
+
+    Decoder::Result result;
+    if (aTryUpright) {
+        result = aDecoder->decode(scaledImage, aFrame);
+    }
+    if (!result.isValid()) {
+        // Try the other orientation for 1D bar codes
+        result = aDecoder->decodeRotated(scaledImage, aFrame);
+    }
+
+    if (result.isValid() && scale > 1) {
+        QList<QPointF> points = result.getPoints();
+        for (int i = 0; i < points.size(); i++) {
+            points[i] *= scale;
+        }
+        result = Decoder::Result(result.getText(), points,
+            result.getFormat());
+    }
+    return result;
+}
+
+QVariantMap Worker::decodeFile(Decoder* aDecoder, QString aPath)
+{
+    QVariantMap map;
+    map.insert("file", aPath);
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    Profiler::Frame frame;
+    Decoder::Result result;
+    QString error;
+    qreal scale = 1;
+    qint64 loadTime;
+    Profiler::Timer totalTimer(&frame, Profiler::StageTotal);
+    if (iOptions.isRaw(aPath)) {
+        zxing::Ref<MappedSource> source(MappedSource::map(aPath,
+            iOptions.iRawSize, aDecoder->bufferPool(), &error));
+        loadTime = loadTimer.nsecsElapsed();
+        if (source) {
+            const int maxSize = iOptions.iMaxSize;
+            const bool fits = source->getWidth() <= maxSize &&
+                source->getHeight() <= maxSize;
+            frame.iWidth = source->getWidth();
+            frame.iHeight = source->getHeight();
+            if (fits) {
+                // No need to scale, decode what's in the file
+                result = aDecoder->decode(zxing::Ref<zxing::LuminanceSource>
+                    (source), &frame);
+            }
+            if (!result.isValid()) {
+                result = decode(aDecoder, source->image(), !fits, &frame);
+            }
+        }
+    } else {
+        QImage image(load(aPath, &scale, &error));
+        loadTime = loadTimer.nsecsElapsed();
+        if (!image.isNull()) {
+            frame.iWidth = image.width();
+            frame.iHeight = image.height();
+            result = decode(aDecoder, image, true, &frame);
+        }
+    }
+    totalTimer.stop();
+
+    if (!error.isEmpty()) {
+        map.insert("error", error);
+        return map;
+    }
+
+    map.insert("found", result.isValid());
+    if (result.isValid()) {
+        QVariantList points;
+        const QList<QPointF> found(result.getPoints());
+        for (int i = 0; i < found.size(); i++) {
+            // Relative to the file, not to what QImageReader gave us
+            points.append(QVariant(QVariantList() <<
+                found.at(i).x() * scale << found.at(i).y() * scale));
+        }
+        map.insert("text", result.getText());
+        map.insert("format", result.getFormatName());
+        map.insert("points", points);
+    }
+
+    // Milliseconds, like the profiler
+    const QVariantMap times(frame.toVariantMap());
+    map.insert("load", loadTime / 1000000.0);
+    map.insert("stages", times.value("stages"));
+    map.insert("readers", times.value("readers"));
+    return map;
+}
+
+// ==========================================================================
+// main
+// ==========================================================================
+
+// Queues files and everything under directories that we know how to read
+static void addPath(WorkQueue* aQueue, QString aPath,
+    const QStringList& aFilters)
+{
+    if (QFileInfo(aPath).isDir()) {
+        QDirIterator it(aPath, aFilters, QDir::Files,
+            QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            aQueue->put(it.next());
+        }
+    } else {
+        aQueue->put(aPath);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decodes bar codes in image files "
+        "and prints the results as JSON, one line per file.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("PATH", "Image file or directory, "
+        "searched recursively", "PATH...");
+    QCommandLineOption jobsOption(QStringList() << "j" << "jobs",
+        "Number of decoding threads (default is one per core)", "N");
+    QCommandLineOption sizeOption(QStringList() << "s" << "max-size",
+        QString("Scale images down to fit into SIZE x SIZE (default %1)").
+        arg(DEFAULT_MAX_SIZE), "SIZE");
+    QCommandLineOption rawOption(QStringList() << "r" << "raw",
+        "Read .gray and .raw files as 8-bit grayscale frames of this size",
+        "WxH");
+    QCommandLineOption invertedOption(QStringList() << "i" << "inverted",
+        "Also look for light on dark codes");
+    QCommandLineOption mirroredOption(QStringList() << "m" << "mirrored",
+        "Also look for mirrored codes");
+    parser.addOption(jobsOption);
+    parser.addOption(sizeOption);
+    parser.addOption(rawOption);
+    parser.addOption(invertedOption);
+    parser.addOption(mirroredOption);
+    parser.process(app);
+
+    const QStringList paths(parser.positionalArguments());
+    if (paths.isEmpty()) {
+        parser.showHelp(RET_CMDLINE);
+    }
+
+    bool ok = true;
+    int jobs = QThread::idealThreadCount();
+    Options options;
+    if (parser.isSet(jobsOption)) {
+        jobs = parser.value(jobsOption).toInt(&ok);
+        ok = ok && jobs > 0;
+    }
+    if (ok && parser.isSet(sizeOption)) {
+        options.iMaxSize = parser.value(sizeOption).toInt(&ok);
+        ok = ok && options.iMaxSize > 0;
+    }
+    if (ok && parser.isSet(rawOption)) {
+        const QStringList size(parser.value(rawOption).split('x'));
+        if (size.count() == 2) {
+            options.iRawSize = QSize(size.at(0).toInt(), size.at(1).toInt());
+        }
+        ok = !options.iRawSize.isEmpty();
+    }
+    if (!ok) {
+        parser.showHelp(RET_CMDLINE);
+    }
+    options.iInverted = parser.isSet(invertedOption);
+    options.iMirrored = parser.isSet(mirroredOption);
+
+    QStringList filters;
+    const QList<QByteArray> formats(QImageReader::supportedImageFormats());
+    for (int i = 0; i < formats.count(); i++) {
+        filters.append("*." + QString::fromLatin1(formats.at(i)));
+    }
+    if (options.iRawSize.isValid()) {
+        filters.append("*.gray");
+        filters.append("*.raw");
+    }
+
+    // A couple of files per thread is enough to keep them all busy
+    WorkQueue queue(2 * jobs);
+    Output output;
+    QList<Worker*> workers;
+    for (int i = 0; i < jobs; i++) {
+        Worker* worker = new Worker(options, &queue, &output);
+        workers.append(worker);
+        worker->start();
+    }
+    for (int i = 0; i < paths.count(); i++) {
+        addPath(&queue, paths.at(i), filters);
+    }
+    queue.close();
+    for (int i = 0; i < workers.count(); i++) {
+        workers.at(i)->wait();
+        delete workers.at(i);
+    }
+    fflush(stdout);
+    return output.errors() ? RET_ERR_FILES : RET_OK;
+}
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 import QtQuick 2.0
 import Sailfish.Silica 1.0
+import org.nemomobile.notifications 1.0
 import harbour.barcode 1.0
 
 import "../js/Utils.js" as Utils
@@ -51,6 +52,27 @@ Page {
         }
     }
 
+    Connections {
+        target: HistoryModel
+        onExportFinished: {
+            if (path) {
+                //: Pop-up notification, %1 is the path of the PDF file
+                //% "QR codes saved to %1"
+                exportNotification.previewBody = qsTrId("notification-codes_exported").arg(path)
+            } else {
+                //: Pop-up notification
+                //% "Failed to export QR codes"
+                exportNotification.previewBody = qsTrId("notification-export_failed")
+            }
+            exportNotification.publish()
+        }
+    }
+
+    Notification {
+        id: exportNotification
+        expireTimeout: 3000
+    }
+
     SilicaListView {
         id: historyList
 
@@ -177,6 +199,14 @@ Page {
 
         PullDownMenu {
             visible: !historyPage.empty
+            busy: HistoryModel.exporting
+            MenuItem {
+                //: Pulley menu item (writes a PDF file to the Pictures folder)
+                //% "Export QR codes"
+                text: qsTrId("history-menu-export_codes")
+                enabled: !HistoryModel.exporting
+                onClicked: HistoryModel.exportCodes()
+            }
             MenuItem {
                 //: Pulley menu item
                 //% "Delete all"
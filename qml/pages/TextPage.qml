@@ -188,6 +188,26 @@ ContactCard { id: card; PullDownMenu { MenuItem { id: saveMenu; onClicked: page.
                 width: parent.width
             }
 
+            Image {
+                id: qrCode
+
+                // The image is a whole number of pixels per module, at most this big
+                readonly property int maxSize: Math.min(parent.width, Math.min(textPage.width, textPage.height) - 2 * Theme.horizontalPageMargin)
+
+                anchors.horizontalCenter: parent.horizontalCenter
+                source: textPage.text.length ? ("image://qrcode/M/" + encodeURIComponent(textPage.text)) : ""
+                sourceSize: Qt.size(maxSize, maxSize)
+                visible: status === Image.Ready
+                asynchronous: true
+                cache: false
+            }
+
+            Item {
+                visible: qrCode.visible
+                height: Theme.paddingLarge
+                width: parent.width
+            }
+
             Image {
                 id: image
 
@@ -24,6 +24,7 @@ THE SOFTWARE.
 
 #include "HistoryModel.h"
 #include "HistoryImageProvider.h"
+#include "QrCodeImageProvider.h"
 #include "Database.h"
 
 #include "HarbourDebug.h"
@@ -33,10 +34,14 @@ THE SOFTWARE.
 #include <QThreadPool>
 #include <QFileInfo>
 #include <QImage>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QStandardPaths>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QSqlTableModel>
+#include <QtConcurrent>
 
 #define DEFAULT_MAX_COUNT (100)
 
@@ -122,6 +127,101 @@ void HistoryModel::SaveTask::performTask()
     HDEBUG("done");
 }
 
+// ==========================================================================
+// HistoryModel::ExportTask
+// Writes QR codes for the texts to a PDF file a sheet row at a time. The
+// codes of a row are encoded in parallel, drawn and dropped, and each page
+// goes to the file as soon as it's full.
+// ==========================================================================
+
+class HistoryModel::ExportTask : public HarbourTask {
+    Q_OBJECT
+public:
+    static const int COLUMNS = 4;
+    static const int RESOLUTION = 300; // dpi
+    static const int MARGIN = 10; // mm
+
+    ExportTask(QThreadPool* aPool, QStringList aTexts, QString aPath);
+    void performTask() Q_DECL_OVERRIDE;
+
+    static QImage encode(const QString& aText);
+
+public:
+    QStringList iTexts;
+    QString iPath;
+    bool iOk;
+};
+
+HistoryModel::ExportTask::ExportTask(QThreadPool* aPool, QStringList aTexts,
+    QString aPath) : HarbourTask(aPool), iTexts(aTexts), iPath(aPath),
+    iOk(false)
+{
+}
+
+QImage HistoryModel::ExportTask::encode(const QString& aText)
+{
+    return QrCodeImageProvider::encode(aText,
+        QrCodeImageProvider::DEFAULT_EC_LEVEL);
+}
+
+void HistoryModel::ExportTask::performTask()
+{
+    QPdfWriter pdf(iPath);
+    pdf.setCreator(QCoreApplication::applicationName());
+    pdf.setResolution(RESOLUTION);
+    pdf.setPageSize(QPageSize(QPageSize::A4));
+    pdf.setPageMargins(QMarginsF(MARGIN, MARGIN, MARGIN, MARGIN),
+        QPageLayout::Millimeter);
+
+    QPainter painter;
+    if (!painter.begin(&pdf)) {
+        HWARN("Failed to write" << qPrintable(iPath));
+        return;
+    }
+
+    QFont font(painter.font());
+    font.setPointSize(7);
+    painter.setFont(font);
+    const QFontMetrics metrics(painter.fontMetrics());
+    const int cellWidth = pdf.width() / COLUMNS;
+    const int cellHeight = cellWidth + metrics.height();
+    const int rowsPerPage = qMax(pdf.height() / cellHeight, 1);
+    int row = 0;
+    for (int i = 0; i < iTexts.count(); i += COLUMNS) {
+        const QStringList texts(iTexts.mid(i, COLUMNS));
+        const QList<QImage> codes(QtConcurrent::blockingMapped
+            <QList<QImage> >(texts, encode));
+        if (row == rowsPerPage) {
+            pdf.newPage();
+            row = 0;
+        }
+        const int y = row * cellHeight;
+        for (int k = 0; k < codes.count(); k++) {
+            const int x = k * cellWidth;
+            const QImage code(codes.at(k));
+            if (!code.isNull()) {
+                // A whole number of device pixels per module
+                const QImage img(QrCodeImageProvider::render(code, cellWidth));
+                painter.drawImage(x + (cellWidth - img.width()) / 2,
+                    y + (cellWidth - img.height()) / 2, img);
+            }
+            painter.drawText(QRect(x, y + cellWidth, cellWidth,
+                metrics.height()), Qt::AlignHCenter | Qt::AlignTop,
+                metrics.elidedText(texts.at(k).simplified(), Qt::ElideRight,
+                cellWidth));
+        }
+        row++;
+    }
+    // QPdfWriter doesn't report most write errors, at least catch
+    // the file that never made it to the disk
+    iOk = painter.end() && QFileInfo(iPath).size() > 0;
+    HDEBUG(iTexts.count() << "codes =>" << qPrintable(iPath) << iOk);
+    if (!iOk) {
+        HWARN("Failed to write" << qPrintable(iPath));
+        QFile::remove(iPath);
+    }
+}
+
 // ==========================================================================
 // HistoryModel::PurgeTask
 // ==========================================================================
@@ -194,9 +294,11 @@ public:
 private Q_SLOTS:
     void onSaveDone();
     void onCleanupDone();
+    void onExportDone();
 
 public:
     QThreadPool* iThreadPool;
+    ExportTask* iExportTask;
     TriState iHaveImages;
     bool iSaveImages;
     int iMaxCount;
@@ -215,6 +317,7 @@ const QString HistoryModel::Private::DB_FIELD[] = {
 HistoryModel::Private::Private(HistoryModel* aPublicModel) :
     QSqlTableModel(aPublicModel, Database::database()),
     iThreadPool(new QThreadPool(this)),
+    iExportTask(NULL),
     iHaveImages(Maybe),
     iSaveImages(true),
     iMaxCount(DEFAULT_MAX_COUNT),
@@ -378,6 +481,23 @@ void HistoryModel::Private::onCleanupDone()
     }
 }
 
+void HistoryModel::Private::onExportDone()
+{
+    ExportTask* task = qobject_cast<ExportTask*>(sender());
+    HASSERT(task);
+    HASSERT(task == iExportTask);
+    if (task) {
+        HistoryModel* model = historyModel();
+        const QString path(task->iOk ? task->iPath : QString());
+        if (task == iExportTask) {
+            iExportTask = NULL;
+        }
+        task->release();
+        Q_EMIT model->exportingChanged();
+        Q_EMIT model->exportFinished(path);
+    }
+}
+
 // ==========================================================================
 // HistoryModel
 // ==========================================================================
@@ -469,6 +589,11 @@ void HistoryModel::setSaveImages(bool aValue)
     }
 }
 
+bool HistoryModel::exporting() const
+{
+    return iPrivate->iExportTask != NULL;
+}
+
 QVariantMap HistoryModel::get(int aRow)
 {
     QString id;
@@ -563,6 +688,42 @@ void HistoryModel::commitChanges()
     }
 }
 
+// Writes the codes to a PDF file in the Pictures folder, exportFinished()
+// gets its path (or an empty string if it couldn't be written). Only one
+// export runs at a time, false is returned while another one is running.
+bool HistoryModel::exportCodes()
+{
+    if (iPrivate->iExportTask) {
+        HDEBUG("already exporting");
+    } else {
+        QStringList texts;
+        const int n = rowCount();
+        for (int i = 0; i < n; i++) {
+            const QString text(data(index(i, 0), Qt::UserRole +
+                Private::FIELD_VALUE).toString());
+            if (!text.isEmpty()) {
+                texts.append(text);
+            }
+        }
+        if (!texts.isEmpty()) {
+            QDir dir(QStandardPaths::writableLocation(QStandardPaths::PicturesLocation));
+            if (!dir.exists()) {
+                dir.mkpath(".");
+            }
+            const QString path(dir.path() + QDir::separator() + "qrcodes-" +
+                QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss") +
+                ".pdf");
+            HDEBUG(texts.count() << "codes =>" << qPrintable(path));
+            iPrivate->iExportTask = new ExportTask(iPrivate->iThreadPool,
+                texts, path);
+            iPrivate->iExportTask->submit(iPrivate, SLOT(onExportDone()));
+            Q_EMIT exportingChanged();
+            return true;
+        }
+    }
+    return false;
+}
+
 QString HistoryModel::formatTimestamp(QString aTimestamp)
 {
     static const QString format("dd.MM.yyyy  hh:mm:ss");
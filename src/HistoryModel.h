@@ -41,6 +41,7 @@ class HistoryModel: public QSortFilterProxyModel {
     Q_PROPERTY(int maxCount READ maxCount WRITE setMaxCount NOTIFY maxCountChanged)
     Q_PROPERTY(bool saveImages READ saveImages WRITE setSaveImages NOTIFY saveImagesChanged)
     Q_PROPERTY(bool hasImages READ hasImages NOTIFY hasImagesChanged)
+    Q_PROPERTY(bool exporting READ exporting NOTIFY exportingChanged)
 
 public:
     HistoryModel(QObject* aParent = NULL);
@@ -52,12 +53,15 @@ public:
     bool saveImages() const;
     void setSaveImages(bool aValue);
 
+    bool exporting() const;
+
     Q_INVOKABLE QVariantMap get(int row);
     Q_INVOKABLE QString getValue(int row);
     Q_INVOKABLE QString insert(QImage image, QString value, QString format);
     Q_INVOKABLE void remove(int row);
     Q_INVOKABLE void removeAll();
     Q_INVOKABLE void commitChanges();
+    Q_INVOKABLE bool exportCodes();
 
     // Utilities
     Q_INVOKABLE static QString formatTimestamp(QString timestamp);
@@ -76,12 +80,15 @@ Q_SIGNALS:
     void maxCountChanged();
     void hasImagesChanged();
     void saveImagesChanged();
+    void exportingChanged();
+    void exportFinished(QString path);
 
 private:
     class Private;
     class SaveTask;
     class CleanupTask;
     class PurgeTask;
+    class ExportTask;
     Private* iPrivate;
 };
 
@@ -0,0 +1,266 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "QrCodeImageProvider.h"
+#include "HarbourDebug.h"
+
+#include <zxing/EncodeHint.h>
+#include <zxing/Exception.h>
+#include <zxing/qrcode/encoder/Encoder.h>
+
+#include <QCache>
+#include <QMutex>
+#include <QUrl>
+
+// ==========================================================================
+// QrCodeImageProvider::Private
+// ==========================================================================
+
+class QrCodeImageProvider::Private {
+public:
+    static const int QUIET_ZONE = 4;
+    static const int DEFAULT_MODULE_SIZE = 4;
+    static const int MAX_CODES_COST = 256*1024;
+    static const int MAX_IMAGES_COST = 4*1024*1024;
+
+    static QrCodeImageProvider* gInstance;
+
+    Private();
+
+    static zxing::qrcode::ErrorCorrectionLevel* ecLevel(QString aName);
+    static void insert(QCache<QString,QImage>& aCache, QString aKey, QImage aImage);
+
+public:
+    QMutex iMutex;
+    // One pixel per module, keyed by "level/text"
+    QCache<QString,QImage> iCodes;
+    // Ready to show, keyed by "size/level/text"
+    QCache<QString,QImage> iImages;
+};
+
+QrCodeImageProvider* QrCodeImageProvider::Private::gInstance = NULL;
+
+QrCodeImageProvider::Private::Private() :
+    iCodes(MAX_CODES_COST),
+    iImages(MAX_IMAGES_COST)
+{
+}
+
+zxing::qrcode::ErrorCorrectionLevel* QrCodeImageProvider::Private::ecLevel(QString aName)
+{
+    if (aName == QLatin1String("L")) {
+        return &zxing::qrcode::ErrorCorrectionLevel::L;
+    } else if (aName == QLatin1String("M")) {
+        return &zxing::qrcode::ErrorCorrectionLevel::M;
+    } else if (aName == QLatin1String("Q")) {
+        return &zxing::qrcode::ErrorCorrectionLevel::Q;
+    } else if (aName == QLatin1String("H")) {
+        return &zxing::qrcode::ErrorCorrectionLevel::H;
+    } else {
+        return NULL;
+    }
+}
+
+void QrCodeImageProvider::Private::insert(QCache<QString,QImage>& aCache,
+    QString aKey, QImage aImage)
+{
+    // QCache deletes the object right away if it's too expensive
+    const int cost = aImage.byteCount();
+    if (cost <= aCache.maxCost()) {
+        aCache.insert(aKey, new QImage(aImage), cost);
+    }
+}
+
+// ==========================================================================
+// QrCodeImageProvider
+// ==========================================================================
+
+const QString QrCodeImageProvider::DEFAULT_EC_LEVEL("M");
+
+QrCodeImageProvider::QrCodeImageProvider() :
+    QQuickImageProvider(Image),
+    iPrivate(new Private)
+{
+    if (!Private::gInstance) {
+        Private::gInstance = this;
+    }
+}
+
+QrCodeImageProvider::~QrCodeImageProvider()
+{
+    delete iPrivate;
+    if (Private::gInstance == this) {
+        Private::gInstance = Q_NULLPTR;
+    }
+}
+
+QrCodeImageProvider* QrCodeImageProvider::instance()
+{
+    return Private::gInstance;
+}
+
+QImage QrCodeImageProvider::encode(QString aText, QString aEcLevel)
+{
+    QImage img;
+    zxing::qrcode::ErrorCorrectionLevel* level = Private::ecLevel(aEcLevel);
+    if (!level) {
+        HWARN("Invalid error correction level" << aEcLevel);
+        return img;
+    }
+    const QByteArray utf8(aText.toUtf8());
+    try {
+        // Plain ASCII may fit into the numeric or alphanumeric mode,
+        // anything else is written as UTF-8 bytes after an ECI header
+        zxing::EncodeHint hints;
+        const bool ascii = (utf8.length() == aText.length());
+        if (!ascii) {
+            hints.setCharacterSet("UTF-8");
+        }
+        zxing::Ref<zxing::qrcode::QRCode> code(zxing::qrcode::Encoder::
+            encode(std::string(utf8.constData(), utf8.length()), *level,
+            ascii ? NULL : &hints));
+        zxing::Ref<zxing::qrcode::ByteMatrix> matrix(code->getMatrix());
+        const int n = (int)matrix->getWidth();
+        img = QImage(n, n, QImage::Format_Mono);
+        img.setColor(0, qRgb(255, 255, 255));
+        img.setColor(1, qRgb(0, 0, 0));
+        img.fill(0);
+        for (int y = 0; y < n; y++) {
+            uchar* line = img.scanLine(y);
+            for (int x = 0; x < n; x++) {
+                if (matrix->get(x, y) == 1) {
+                    line[x >> 3] |= (0x80 >> (x & 7));
+                }
+            }
+        }
+        HDEBUG(aText << "=> version" <<
+            code->getVersion()->getVersionNumber());
+    } catch (zxing::Exception const& e) {
+        HWARN("Failed to encode" << aText << e.what());
+    }
+    return img;
+}
+
+// Each module becomes a square of the same whole number of pixels.
+// The first row of pixels of each module row is built a pixel at
+// a time, the other rows are copies of it. If aMaxSize leaves less
+// than a pixel per module (quiet zone included), the image is scaled
+// down to aMaxSize.
+QImage QrCodeImageProvider::render(const QImage& aCode, int aMaxSize)
+{
+    const int n = aCode.width();
+    const int total = n + 2 * Private::QUIET_ZONE;
+    const int scale = (aMaxSize > 0) ? qMax(aMaxSize / total, 1) :
+        Private::DEFAULT_MODULE_SIZE;
+    const int size = total * scale;
+    QImage img(size, size, QImage::Format_Mono);
+    img.setColor(0, qRgb(255, 255, 255));
+    img.setColor(1, qRgb(0, 0, 0));
+    img.fill(0);
+    const int bytesPerLine = img.bytesPerLine();
+    for (int y = 0; y < n; y++) {
+        const uchar* src = aCode.constScanLine(y);
+        const int top = (y + Private::QUIET_ZONE) * scale;
+        uchar* dest = img.scanLine(top);
+        for (int x = 0; x < n; x++) {
+            if (src[x >> 3] & (0x80 >> (x & 7))) {
+                const int left = (x + Private::QUIET_ZONE) * scale;
+                for (int i = left; i < left + scale; i++) {
+                    dest[i >> 3] |= (0x80 >> (i & 7));
+                }
+            }
+        }
+        for (int i = 1; i < scale; i++) {
+            memcpy(img.scanLine(top + i), dest, bytesPerLine);
+        }
+    }
+    if (aMaxSize > 0 && size > aMaxSize) {
+        // Less than a pixel per module won't scan anyway, but it must
+        // not take more room than was asked for
+        return img.scaled(aMaxSize, aMaxSize, Qt::IgnoreAspectRatio,
+            Qt::SmoothTransformation);
+    }
+    return img;
+}
+
+QImage QrCodeImageProvider::requestImage(const QString& aId, QSize* aSize,
+    const QSize& aRequested)
+{
+    QImage img;
+    // We are expecting "level/text"
+    const int slash = aId.indexOf('/');
+    if (slash > 0) {
+        const QString text(QUrl::fromPercentEncoding(aId.mid(slash + 1).toUtf8()));
+        int maxSize = 0;
+        if (aRequested.width() > 0 && aRequested.height() > 0) {
+            maxSize = qMin(aRequested.width(), aRequested.height());
+        } else if (aRequested.width() > 0) {
+            maxSize = aRequested.width();
+        } else if (aRequested.height() > 0) {
+            maxSize = aRequested.height();
+        }
+        img = image(text, aId.left(slash), maxSize);
+    } else {
+        HWARN("Invalid QR code image id" << aId);
+    }
+
+    if (!img.isNull() && aSize) {
+        *aSize = img.size();
+    }
+
+    return img;
+}
+
+QImage QrCodeImageProvider::image(QString aText, QString aEcLevel, int aMaxSize)
+{
+    QImage img;
+    if (!aText.isEmpty()) {
+        const QString codeKey(aEcLevel + QChar('/') + aText);
+        const QString imageKey(QString::number(aMaxSize) + QChar('/') + codeKey);
+        iPrivate->iMutex.lock();
+        QImage* cached = iPrivate->iImages.object(imageKey);
+        if (cached) {
+            img = *cached;
+        } else {
+            QImage code;
+            QImage* cachedCode = iPrivate->iCodes.object(codeKey);
+            if (cachedCode) {
+                code = *cachedCode;
+            } else {
+                // Encoded under the mutex so that the same text is never encoded twice
+                code = encode(aText, aEcLevel);
+                if (!code.isNull()) {
+                    Private::insert(iPrivate->iCodes, codeKey, code);
+                }
+            }
+            if (!code.isNull()) {
+                img = render(code, aMaxSize);
+                Private::insert(iPrivate->iImages, imageKey, img);
+            }
+        }
+        iPrivate->iMutex.unlock();
+    }
+    return img;
+}
@@ -0,0 +1,63 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef QRCODEIMAGEPROVIDER_H
+#define QRCODEIMAGEPROVIDER_H
+
+#include <QImage>
+#include <QQuickImageProvider>
+
+// Renders text as a QR code. The image id is "L/text", "M/text", "Q/text"
+// or "H/text" (the error correction level), with the text percent-encoded.
+// The requested size is the largest the image can be, each module is the
+// same whole number of pixels and there's a 4 module white quiet zone.
+class QrCodeImageProvider : public QQuickImageProvider {
+public:
+    QrCodeImageProvider();
+    ~QrCodeImageProvider();
+
+    static const QString DEFAULT_EC_LEVEL;
+
+    static QrCodeImageProvider* instance();
+
+    QImage requestImage(const QString& aId, QSize* aSize,
+        const QSize& aRequested) Q_DECL_OVERRIDE;
+
+    // Null image if the text doesn't fit into a QR code
+    QImage image(QString aText, QString aEcLevel, int aMaxSize);
+
+    // One pixel per module and no quiet zone, null if the text doesn't fit.
+    // Thread safe and not cached.
+    static QImage encode(QString aText, QString aEcLevel);
+    // Scales the output of encode() and adds the quiet zone, the result
+    // is no larger than aMaxSize unless that's zero
+    static QImage render(const QImage& aCode, int aMaxSize);
+
+private:
+    class Private;
+    Private* iPrivate;
+};
+
+#endif // QRCODEIMAGEPROVIDER_H
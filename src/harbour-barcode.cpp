@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include <MGConfItem>
 
 #include "scanner/BarcodeScanner.h"
+#include "scanner/Profiler.h"
 
 #include "HarbourDebug.h"
 #include "HarbourDisplayBlanking.h"
@@ -45,6 +46,7 @@ THE SOFTWARE.
 #include "Database.h"
 #include "HistoryImageProvider.h"
 #include "HistoryModel.h"
+#include "QrCodeImageProvider.h"
 #include "Settings.h"
 
 #ifndef APP_VERSION
@@ -62,6 +64,7 @@ static void register_types(QQmlEngine* engine, const char* uri, int v1, int v2)
     qmlRegisterType<BarcodeScanner>(uri, v1, v2, "BarcodeScanner");
     qmlRegisterType<Settings>(uri, v1, v2, "Settings");
     qmlRegisterSingletonType<HistoryModel>(uri, v1, v2, "HistoryModel", HistoryModel::createSingleton);
+    qmlRegisterSingletonType<Profiler>(uri, v1, v2, "Profiler", Profiler::createSingleton);
 }
 
 static QSize toSize(QVariant var)
@@ -140,6 +143,7 @@ int main(int argc, char *argv[])
     QQmlEngine* engine = view->engine();
     register_types(engine, "harbour.barcode", 1, 0);
     engine->addImageProvider("scanner", new HistoryImageProvider);
+    engine->addImageProvider("qrcode", new QrCodeImageProvider);
     engine->addImageProvider(providerDefault, new HarbourImageProvider);
     engine->addImageProvider(providerDarkOnLight, new HarbourImageProvider);
 
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "BarcodeScanner.h"
 #include "ImageSource.h"
 #include "Decoder.h"
+#include "Profiler.h"
 
 #include "HarbourDebug.h"
 
@@ -235,19 +236,22 @@ void BarcodeScanner::Private::decodingThread()
     Decoder::Result result;
     QImage image;
     qreal scale = 1;
-    bool rotated = false;
-    int scaledWidth = 0;
 
     const int maxSize = 800;
 
     iDecodingMutex.lock();
     while (!iAbortScan && !result.isValid()) {
+        // Frame statistics are only collected if someone wants them
+        Profiler::Frame profilerFrame;
+        Profiler::Frame* frame = Profiler::isEnabled() ? &profilerFrame : NULL;
+        Profiler::Timer grabTimer(frame, Profiler::StageGrab);
         emit needImage();
         int rotation;
         QRect viewFinderRect;
         while (iCaptureImage.isNull() && !iAbortScan) {
             iDecodingEvent.wait(&iDecodingMutex);
         }
+        grabTimer.stop();
         if (iAbortScan) {
             image = QImage();
         } else {
@@ -262,10 +266,12 @@ void BarcodeScanner::Private::decodingThread()
 #if HARBOUR_DEBUG
             QTime time(QTime::currentTime());
 #endif
+            Profiler::Timer totalTimer(frame, Profiler::StageTotal);
             saveDebugImage(image, "debug_screenshot.bmp");
 
             // Crop the image - we only need the viewfinder area
             // Grabbed image is always in portrait orientation
+            Profiler::Timer cropTimer(frame, Profiler::StageCrop);
             rotation %= 360;
             switch (rotation) {
             default:
@@ -305,51 +311,44 @@ void BarcodeScanner::Private::decodingThread()
                 break;
             }
 
+            cropTimer.stop();
             HDEBUG("extracted" << image);
             saveDebugImage(image, "debug_cropped.bmp");
 
-            QImage scaledImage;
-            if (image.width() > maxSize || image.height() > maxSize) {
-                Qt::TransformationMode mode = Qt::SmoothTransformation;
-                if (image.height() > image.width()) {
-                    scaledImage = image.scaledToHeight(maxSize, mode);
-                    scale = image.height()/(qreal)maxSize;
-                    HDEBUG("scaled to height" << scale << scaledImage);
-                } else {
-                    scaledImage = image.scaledToWidth(maxSize, mode);
-                    scale = image.width()/(qreal)maxSize;
-                    HDEBUG("scaled to width" << scale << scaledImage);
-                }
+            Profiler::Timer scaleTimer(frame, Profiler::StageScale);
+            QImage scaledImage(Decoder::scaleDown(image, maxSize, &scale));
+            scaleTimer.stop();
+            if (frame) {
+                frame->iWidth = scaledImage.width();
+                frame->iHeight = scaledImage.height();
+            }
+            if (scale > 1) {
                 saveDebugImage(scaledImage, "debug_scaled.bmp");
-            } else {
-                scaledImage = image;
-                scale = 1;
             }
 
-            ImageSource* source = new ImageSource(scaledImage);
+            ImageSource* source = new ImageSource(scaledImage,
+                decoder.bufferPool());
             saveDebugImage(source->grayscaleImage(), "debug_grayscale.bmp");
 
             // Ref takes ownership of ImageSource:
             zxing::Ref<zxing::LuminanceSource> sourceRef(source);
 
             HDEBUG("decoding screenshot ...");
-            result = decoder.decode(sourceRef);
+            result = decoder.decode(sourceRef, frame);
 
             if (!result.isValid()) {
                 // try the other orientation for 1D bar code
-                QTransform transform;
-                transform.rotate(90);
-                scaledImage = scaledImage.transformed(transform);
-                saveDebugImage(scaledImage, "debug_rotated.bmp");
+                saveDebugImage(scaledImage.transformed(QTransform().rotate(90)),
+                    "debug_rotated.bmp");
                 HDEBUG("decoding rotated screenshot ...");
-                result = decoder.decode(scaledImage);
-                // We need scaled width for rotating the points back
-                scaledWidth = scaledImage.width();
-                rotated = true;
-            } else {
-                rotated = false;
+                result = decoder.decodeRotated(scaledImage, frame);
             }
             HDEBUG("decoding took" << time.elapsed() << "ms");
+            if (frame) {
+                totalTimer.stop();
+                frame->iFormat = result.getFormat();
+                Profiler::record(*frame);
+            }
         }
         iDecodingMutex.lock();
     }
@@ -357,18 +356,13 @@ void BarcodeScanner::Private::decodingThread()
 
     if (result.isValid()) {
         HDEBUG("decoding succeeded:" << result.getText() << result.getPoints());
-        if (scale > 1 || rotated) {
-            // The image could be a) scaled and b) rotated. Convert
-            // points to the original coordinate system
+        if (scale > 1) {
+            // The image was scaled down, convert points to the original
+            // coordinate system
             QList<QPointF> points = result.getPoints();
             const int n = points.size();
             for (int i = 0; i < n; i++) {
                 QPointF p(points.at(i));
-                if (rotated) {
-                    const qreal x = p.rx();
-                    p.setX(p.ry());
-                    p.setY(scaledWidth - x);
-                }
                 p *= scale;
                 HDEBUG(points[i] << "=>" << p);
                 points[i] = p;
@@ -28,12 +28,20 @@ THE SOFTWARE.
 #include "HarbourDebug.h"
 
 #include <QAtomicInt>
+#include <QTransform>
 
 #include <zxing/DecodeHints.h>
 #include <zxing/MultiFormatReader.h>
 #include <zxing/Binarizer.h>
 #include <zxing/BinaryBitmap.h>
+#include <zxing/common/Arena.h>
+#include <zxing/common/BufferPool.h>
 #include <zxing/common/GlobalHistogramBinarizer.h>
+#include <zxing/aztec/AztecReader.h>
+#include <zxing/datamatrix/DataMatrixReader.h>
+#include <zxing/oned/MultiFormatOneDReader.h>
+#include <zxing/pdf417/PDF417Reader.h>
+#include <zxing/qrcode/QRCodeReader.h>
 
 // ==========================================================================
 // Decoder::Result::Private
@@ -131,59 +139,141 @@ QString Decoder::Result::getFormatName() const
 // Decoder::Private
 // ==========================================================================
 
-class Decoder::Private {
+class Decoder::Private : public zxing::MultiFormatReader::Observer {
 public:
+    class Binarizer;
+
     Private();
     ~Private();
 
-    zxing::Ref<zxing::Result> decode(zxing::Ref<zxing::LuminanceSource> aSource);
+    Result decode(zxing::Ref<zxing::LuminanceSource> aSource,
+        zxing::MultiFormatReader* aReader, Profiler::Frame* aFrame);
+    zxing::Ref<zxing::Result> decodeBitmap(zxing::Ref<zxing::LuminanceSource> aSource,
+        zxing::MultiFormatReader* aReader, Profiler::Frame* aFrame);
+
+    static Profiler::Reader readerType(zxing::Reader* aReader);
+
+    // zxing::MultiFormatReader::Observer
+    void readerStarted(zxing::Reader* aReader) Q_DECL_OVERRIDE;
+    void readerFinished(zxing::Reader* aReader, bool aFound) Q_DECL_OVERRIDE;
 
 public:
+    // Enough for the gray image and a few black matrices of a full size frame
+    static const size_t BUFFER_POOL_SIZE = 4*1024*1024;
+
     zxing::MultiFormatReader* iReader;
+    zxing::MultiFormatReader* iRotatedReader;
     zxing::DecodeHints iHints;
+    zxing::Ref<zxing::BufferPool> iBufferPool;
+    Profiler::Frame* iFrame;
+    QElapsedTimer iReaderTimer;
+};
+
+// Times black matrices, each reader builds its own
+class Decoder::Private::Binarizer : public zxing::GlobalHistogramBinarizer {
+public:
+    Binarizer(zxing::Ref<zxing::LuminanceSource> aSource,
+        Profiler::Frame* aFrame) :
+        zxing::GlobalHistogramBinarizer(aSource), iFrame(aFrame) {}
+
+    zxing::Ref<zxing::BitMatrix> getBlackMatrix() Q_DECL_OVERRIDE
+    {
+        Profiler::Timer timer(iFrame, Profiler::StageBinarize);
+        return zxing::GlobalHistogramBinarizer::getBlackMatrix();
+    }
+
+private:
+    Profiler::Frame* iFrame;
 };
 
 Decoder::Private::Private() :
     iReader(new zxing::MultiFormatReader),
-    iHints(zxing::DecodeHints::DEFAULT_HINT)
+    iRotatedReader(new zxing::MultiFormatReader),
+    iHints(zxing::DecodeHints::DEFAULT_HINT),
+    iBufferPool(new zxing::BufferPool(BUFFER_POOL_SIZE)),
+    iFrame(NULL)
 {
+    // Readers are created once and keep their state between frames
+    iReader->setHints(iHints);
+    // Rotated frames have readers of their own, so that QR and DataMatrix
+    // tracking doesn't get upright and rotated coordinates mixed up
+    iRotatedReader->setHints(iHints);
 }
 
 Decoder::Private::~Private()
 {
+    HDEBUG("buffer pool:" << iBufferPool->getHits() << "hits," <<
+        iBufferPool->getMisses() << "misses," << iBufferPool->getSize() <<
+        "bytes");
     delete iReader;
+    delete iRotatedReader;
 }
 
-zxing::Ref<zxing::Result> Decoder::Private::decode(zxing::Ref<zxing::LuminanceSource> aSource)
+zxing::Ref<zxing::Result> Decoder::Private::decodeBitmap(zxing::Ref<zxing::LuminanceSource> aSource,
+    zxing::MultiFormatReader* aReader, Profiler::Frame* aFrame)
 {
-    zxing::Ref<zxing::Binarizer> binarizer(new zxing::GlobalHistogramBinarizer(aSource));
+    zxing::Ref<zxing::Binarizer> binarizer(new Binarizer(aSource, aFrame));
+    binarizer->setBufferPool(iBufferPool);
     zxing::Ref<zxing::BinaryBitmap> bitmap(new zxing::BinaryBitmap(binarizer));
-    return iReader->decode(bitmap, iHints);
+    // Only watch the readers when someone is interested
+    iFrame = aFrame;
+    aReader->setObserver(aFrame ? this : NULL);
+    try {
+        zxing::Ref<zxing::Result> result(aReader->decodeWithState(bitmap));
+        iFrame = NULL;
+        return result;
+    } catch (...) {
+        iFrame = NULL;
+        throw;
+    }
 }
 
-// ==========================================================================
-// Decoder
-// ==========================================================================
-
-Decoder::Decoder() : iPrivate(new Private)
+Profiler::Reader Decoder::Private::readerType(zxing::Reader* aReader)
 {
+    if (dynamic_cast<zxing::qrcode::QRCodeReader*>(aReader)) {
+        return Profiler::ReaderQrCode;
+    } else if (dynamic_cast<zxing::datamatrix::DataMatrixReader*>(aReader)) {
+        return Profiler::ReaderDataMatrix;
+    } else if (dynamic_cast<zxing::aztec::AztecReader*>(aReader)) {
+        return Profiler::ReaderAztec;
+    } else if (dynamic_cast<zxing::pdf417::PDF417Reader*>(aReader)) {
+        return Profiler::ReaderPdf417;
+    } else {
+        return Profiler::ReaderOneD;
+    }
 }
 
-Decoder::~Decoder()
+void Decoder::Private::readerStarted(zxing::Reader*)
 {
-    delete iPrivate;
+    iReaderTimer.start();
 }
 
-Decoder::Result Decoder::decode(QImage aImage)
+void Decoder::Private::readerFinished(zxing::Reader* aReader, bool)
 {
-    zxing::Ref<zxing::LuminanceSource> source(new ImageSource(aImage));
-    return decode(source);
+    if (iFrame) {
+        const Profiler::Reader type = readerType(aReader);
+        iFrame->add(type, iReaderTimer.nsecsElapsed());
+        if (aReader->wasTracked()) {
+            iFrame->iReaderTracked[type]++;
+        }
+    }
 }
 
-Decoder::Result Decoder::decode(zxing::Ref<zxing::LuminanceSource> aSource)
+Decoder::Result Decoder::Private::decode(zxing::Ref<zxing::LuminanceSource> aSource,
+    zxing::MultiFormatReader* aReader, Profiler::Frame* aFrame)
 {
+    Profiler::Timer timer(aFrame, Profiler::StageDecode);
+    if (aFrame) {
+        // ImageSource keeps the gray image, converting it here rather
+        // than in the first reader doesn't add any work
+        Profiler::Timer grayscale(aFrame, Profiler::StageGrayscale);
+        aSource->getMatrix();
+    }
+
+    // Temporary zxing objects are recycled until the frame is done
+    zxing::Arena::Scope arena;
     try {
-        zxing::Ref<zxing::Result> result(iPrivate->decode(aSource));
+        zxing::Ref<zxing::Result> result(decodeBitmap(aSource, aReader, aFrame));
 
         QList<QPointF> points;
         zxing::ArrayRef<zxing::Ref<zxing::ResultPoint> > found(result->getResultPoints());
@@ -192,10 +282,112 @@ Decoder::Result Decoder::decode(zxing::Ref<zxing::LuminanceSource> aSource)
             points.append(QPointF(point.getX(), point.getY()));
         }
 
-        return Result(result->getText()->getText().c_str(), points,
-            result->getBarcodeFormat());
+        const std::string& text(result->getText()->getText());
+        return Result(QString::fromUtf8(text.data(), (int)text.size()),
+            points, result->getBarcodeFormat());
     } catch (zxing::Exception& e) {
         HDEBUG("Exception:" << e.what());
         return Result();
     }
 }
+
+// ==========================================================================
+// Decoder
+// ==========================================================================
+
+Decoder::Decoder() : iPrivate(new Private)
+{
+}
+
+Decoder::~Decoder()
+{
+    delete iPrivate;
+}
+
+Decoder::Result Decoder::decode(QImage aImage, Profiler::Frame* aFrame)
+{
+    zxing::Ref<zxing::LuminanceSource> source(new ImageSource(aImage,
+        iPrivate->iBufferPool));
+    return decode(source, aFrame);
+}
+
+void Decoder::setTryInverted(bool aTryInverted)
+{
+    if (iPrivate->iHints.getTryInverted() != aTryInverted) {
+        iPrivate->iHints.setTryInverted(aTryInverted);
+        reset();
+    }
+}
+
+void Decoder::setTryMirrored(bool aTryMirrored)
+{
+    if (iPrivate->iHints.getTryMirrored() != aTryMirrored) {
+        iPrivate->iHints.setTryMirrored(aTryMirrored);
+        reset();
+    }
+}
+
+void Decoder::reset()
+{
+    // setHints() creates new readers
+    iPrivate->iReader->setHints(iPrivate->iHints);
+    iPrivate->iRotatedReader->setHints(iPrivate->iHints);
+}
+
+zxing::Ref<zxing::BufferPool> Decoder::bufferPool() const
+{
+    return iPrivate->iBufferPool;
+}
+
+QImage Decoder::scaleDown(QImage aImage, int aMaxSize, qreal* aScale)
+{
+    if (aImage.width() > aMaxSize || aImage.height() > aMaxSize) {
+        QImage scaledImage;
+        Qt::TransformationMode mode = Qt::SmoothTransformation;
+        if (aImage.height() > aImage.width()) {
+            scaledImage = aImage.scaledToHeight(aMaxSize, mode);
+            *aScale = aImage.height()/(qreal)aMaxSize;
+            HDEBUG("scaled to height" << *aScale << scaledImage);
+        } else {
+            scaledImage = aImage.scaledToWidth(aMaxSize, mode);
+            *aScale = aImage.width()/(qreal)aMaxSize;
+            HDEBUG("scaled to width" << *aScale << scaledImage);
+        }
+        return scaledImage;
+    } else {
+        *aScale = 1;
+        return aImage;
+    }
+}
+
+Decoder::Result Decoder::decode(zxing::Ref<zxing::LuminanceSource> aSource,
+    Profiler::Frame* aFrame)
+{
+    return iPrivate->decode(aSource, iPrivate->iReader, aFrame);
+}
+
+Decoder::Result Decoder::decodeRotated(QImage aImage, Profiler::Frame* aFrame)
+{
+    Profiler::Timer rotateTimer(aFrame, Profiler::StageRotate);
+    QTransform transform;
+    transform.rotate(90);
+    const QImage rotatedImage(aImage.transformed(transform));
+    rotateTimer.stop();
+
+    zxing::Ref<zxing::LuminanceSource> source(new ImageSource(rotatedImage,
+        iPrivate->iBufferPool));
+    Result result(iPrivate->decode(source, iPrivate->iRotatedReader, aFrame));
+    if (result.isValid()) {
+        // Rotate the points back
+        QList<QPointF> points = result.getPoints();
+        const int width = rotatedImage.width();
+        for (int i = 0; i < points.size(); i++) {
+            QPointF& p(points[i]);
+            const qreal x = p.x();
+            p.setX(p.y());
+            p.setY(width - x);
+        }
+        result = Result(result.getText(), points, result.getFormat());
+    }
+    return result;
+}
@@ -30,9 +30,12 @@ THE SOFTWARE.
 #include <QString>
 #include <QMetaType>
 
+#include "Profiler.h"
+
 #include <zxing/BarcodeFormat.h>
 #include <zxing/LuminanceSource.h>
 #include <zxing/common/Counted.h>
+#include <zxing/common/BufferPool.h>
 
 class Decoder {
     Q_DISABLE_COPY(Decoder)
@@ -43,8 +46,33 @@ public:
     Decoder();
     ~Decoder();
 
-    Result decode(QImage aImage);
-    Result decode(zxing::Ref<zxing::LuminanceSource> aSource);
+    // aFrame, if not NULL, collects the time taken by each step
+    Result decode(QImage aImage, Profiler::Frame* aFrame = NULL);
+    Result decode(zxing::Ref<zxing::LuminanceSource> aSource,
+        Profiler::Frame* aFrame = NULL);
+
+    // Second attempt at an image that didn't decode, turned by 90 degrees
+    // for 1D codes. The readers that look at it are kept apart from those
+    // decode() uses. The points are rotated back to aImage coordinates.
+    Result decodeRotated(QImage aImage, Profiler::Frame* aFrame = NULL);
+
+    // Light on dark codes (phone screens) and mirror images (codes seen
+    // through glass) cost extra attempts on frames that don't decode,
+    // both are off by default. Changing either resets the readers.
+    void setTryInverted(bool aTryInverted);
+    void setTryMirrored(bool aTryMirrored);
+
+    // Forgets what the readers remember about previous frames, for when
+    // the next image has nothing to do with the last one. The buffer pool
+    // is kept.
+    void reset();
+
+    // Frame buffers are recycled through this pool
+    zxing::Ref<zxing::BufferPool> bufferPool() const;
+
+    // Scales the image down (if necessary) to fit into aMaxSize x aMaxSize,
+    // aScale receives the original size divided by the new one
+    static QImage scaleDown(QImage aImage, int aMaxSize, qreal* aScale);
 
 private:
     class Private;
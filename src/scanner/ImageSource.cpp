@@ -24,27 +24,19 @@ THE SOFTWARE.
 
 #include "ImageSource.h"
 
-ImageSource::ImageSource(QImage aImage) :
-    zxing::LuminanceSource(aImage.width(), aImage.height())
+ImageSource::ImageSource(QImage aImage, zxing::Ref<zxing::BufferPool> aPool) :
+    zxing::LuminanceSource(aImage.width(), aImage.height()),
+    iPool(aPool)
 {
     if (aImage.depth() == 32) {
         iImage = aImage;
     } else {
         iImage = aImage.convertToFormat(QImage::Format_RGB32);
     }
-
-    const int height =  getHeight();
-    iGrayRows = new zxing::byte*[height];
-    memset(iGrayRows, 0, sizeof(iGrayRows[0]) * height);
 }
 
 ImageSource::~ImageSource()
 {
-    const int height =  iImage.height();
-    for (int i = 0; i < height; i++) {
-        delete [] iGrayRows [i];
-    }
-    delete [] iGrayRows;
 }
 
 zxing::ArrayRef<zxing::byte> ImageSource::getRow(int aY, zxing::ArrayRef<zxing::byte> aRow) const
@@ -59,36 +51,40 @@ zxing::ArrayRef<zxing::byte> ImageSource::getRow(int aY, zxing::ArrayRef<zxing::
 
 zxing::ArrayRef<zxing::byte> ImageSource::getMatrix() const
 {
-    const int width = getWidth();
-    const int height =  getHeight();
-    zxing::ArrayRef<zxing::byte> matrix(width*height);
-    zxing::byte* m = &matrix[0];
-
-    for (int y = 0; y < height; y++) {
-        memcpy(m, getGrayRow(y), width);
-        m += width;
-    }
-
-    return matrix;
+    // Callers only read the matrix, no need to copy it
+    convertToGray();
+    return iGrayImage;
 }
 
 const zxing::byte* ImageSource::getGrayRow(int aY) const
 {
-    if (!iGrayRows[aY]) {
-        const int width = iImage.width();
-        zxing::byte* row = new zxing::byte[width];
-        const QRgb* pixels = (const QRgb*)iImage.scanLine(aY);
-        for (int x = 0; x < width; x++) {
-            const QRgb rgb = *pixels++;
-            // This is significantly faster than gGray() but is
-            // just as good for our purposes
-            row[x] = (zxing::byte)((((rgb & 0x00ff0000) >> 16) +
-                ((rgb & 0x0000ff00) >> 8) +
-                (rgb & 0xff))/3);
+    convertToGray();
+    return &iGrayImage[aY * getWidth()];
+}
+
+void ImageSource::convertToGray() const
+{
+    if (!iGrayImage) {
+        // The whole image is needed for the black matrix anyway, and
+        // converting it in one go keeps it in a single (pooled) buffer
+        const int width = getWidth();
+        const int height = getHeight();
+        iGrayImage = iPool ? iPool->getBytes(width * height) :
+            zxing::ArrayRef<zxing::byte>(width * height);
+        zxing::byte* row = &iGrayImage[0];
+        for (int y = 0; y < height; y++) {
+            const QRgb* pixels = (const QRgb*)iImage.scanLine(y);
+            for (int x = 0; x < width; x++) {
+                const QRgb rgb = *pixels++;
+                // This is significantly faster than gGray() but is
+                // just as good for our purposes
+                row[x] = (zxing::byte)((((rgb & 0x00ff0000) >> 16) +
+                    ((rgb & 0x0000ff00) >> 8) +
+                    (rgb & 0xff))/3);
+            }
+            row += width;
         }
-        iGrayRows[aY] = row;
     }
-    return iGrayRows[aY];
 }
 
 QImage ImageSource::grayscaleImage() const
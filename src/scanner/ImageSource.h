@@ -28,13 +28,15 @@ THE SOFTWARE.
 #include <QImage>
 #include <zxing/LuminanceSource.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/BufferPool.h>
 
 class ImageSource : public zxing::LuminanceSource
 {
     Q_DISABLE_COPY(ImageSource)
 
 public:
-    ImageSource(QImage aImage);
+    ImageSource(QImage aImage, zxing::Ref<zxing::BufferPool> aPool =
+        zxing::Ref<zxing::BufferPool>());
     ~ImageSource();
     
     QImage grayscaleImage() const;
@@ -44,10 +46,11 @@ public:
 
 private:
     const zxing::byte* getGrayRow(int aY) const;
+    void convertToGray() const;
 
 private:
     QImage iImage;
-    mutable zxing::byte** iGrayRows;
+    zxing::Ref<zxing::BufferPool> iPool;
     mutable zxing::ArrayRef<zxing::byte> iGrayImage;
 };
 
@@ -0,0 +1,233 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "Profiler.h"
+
+#include "HarbourDebug.h"
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMutex>
+
+#include <zxing/BarcodeFormat.h>
+
+static const char* const STAGE_NAMES[Profiler::StageCount] = {
+    "grab", "crop", "scale", "grayscale", "binarize", "decode", "rotate",
+    "total"
+};
+
+static const char* const READER_NAMES[Profiler::ReaderCount] = {
+    "oned", "qrcode", "datamatrix", "aztec", "pdf417"
+};
+
+// ==========================================================================
+// Profiler::Frame
+// ==========================================================================
+
+Profiler::Frame::Frame() :
+    iTimestamp(QDateTime::currentMSecsSinceEpoch()),
+    iWidth(0),
+    iHeight(0),
+    iFormat(zxing::BarcodeFormat::NONE)
+{
+    for (int i = 0; i < StageCount; i++) {
+        iStageTime[i] = -1;
+    }
+    for (int i = 0; i < ReaderCount; i++) {
+        iReaderTime[i] = -1;
+        iReaderRuns[i] = 0;
+        iReaderTracked[i] = 0;
+    }
+}
+
+void Profiler::Frame::add(Stage aStage, qint64 aNanoseconds)
+{
+    // Some stages (binarization in particular) happen more than once
+    if (iStageTime[aStage] < 0) {
+        iStageTime[aStage] = aNanoseconds;
+    } else {
+        iStageTime[aStage] += aNanoseconds;
+    }
+}
+
+void Profiler::Frame::add(Reader aReader, qint64 aNanoseconds)
+{
+    if (iReaderTime[aReader] < 0) {
+        iReaderTime[aReader] = aNanoseconds;
+    } else {
+        iReaderTime[aReader] += aNanoseconds;
+    }
+    iReaderRuns[aReader]++;
+}
+
+QVariantMap Profiler::Frame::toVariantMap() const
+{
+    // Milliseconds are easier to read
+    QVariantMap stages;
+    for (int i = 0; i < StageCount; i++) {
+        if (iStageTime[i] >= 0) {
+            stages.insert(STAGE_NAMES[i], iStageTime[i] / 1000000.0);
+        }
+    }
+
+    QVariantMap readers;
+    for (int i = 0; i < ReaderCount; i++) {
+        if (iReaderRuns[i]) {
+            QVariantMap reader;
+            reader.insert("time", iReaderTime[i] / 1000000.0);
+            reader.insert("runs", iReaderRuns[i]);
+            reader.insert("tracked", iReaderTracked[i]);
+            readers.insert(READER_NAMES[i], reader);
+        }
+    }
+
+    QVariantMap map;
+    map.insert("timestamp", iTimestamp);
+    map.insert("width", iWidth);
+    map.insert("height", iHeight);
+    if (iFormat != zxing::BarcodeFormat::NONE) {
+        map.insert("format", QString(QLatin1String(zxing::BarcodeFormat::
+            barcodeFormatNames[iFormat])));
+    }
+    map.insert("stages", stages);
+    map.insert("readers", readers);
+    return map;
+}
+
+// ==========================================================================
+// Profiler::Private
+// ==========================================================================
+
+class Profiler::Private {
+public:
+    static QAtomicInt gEnabled;
+    static QMutex gMutex;
+    static Profiler* gInstance;
+    static Frame gFrames[MAX_FRAMES];
+    static int gFirst;
+    static int gCount;
+};
+
+QAtomicInt Profiler::Private::gEnabled(0);
+QMutex Profiler::Private::gMutex;
+Profiler* Profiler::Private::gInstance = NULL;
+Profiler::Frame Profiler::Private::gFrames[Profiler::MAX_FRAMES];
+int Profiler::Private::gFirst = 0;
+int Profiler::Private::gCount = 0;
+
+// ==========================================================================
+// Profiler
+// ==========================================================================
+
+Profiler::Profiler(QObject* aParent) :
+    QObject(aParent)
+{
+    Private::gMutex.lock();
+    Private::gInstance = this;
+    Private::gMutex.unlock();
+}
+
+Profiler::~Profiler()
+{
+    Private::gMutex.lock();
+    if (Private::gInstance == this) {
+        Private::gInstance = NULL;
+    }
+    Private::gMutex.unlock();
+}
+
+QObject* Profiler::createSingleton(QQmlEngine*, QJSEngine*)
+{
+    // The engine takes ownership of singletons
+    return new Profiler;
+}
+
+bool Profiler::isEnabled()
+{
+    return Private::gEnabled.load() != 0;
+}
+
+void Profiler::record(const Frame& aFrame)
+{
+    Private::gMutex.lock();
+    if (Private::gCount < MAX_FRAMES) {
+        Private::gFrames[(Private::gFirst + Private::gCount++) %
+            MAX_FRAMES] = aFrame;
+    } else {
+        // Overwrite the oldest one
+        Private::gFrames[Private::gFirst] = aFrame;
+        Private::gFirst = (Private::gFirst + 1) % MAX_FRAMES;
+    }
+    if (Private::gInstance) {
+        // Emitted on the main thread
+        QMetaObject::invokeMethod(Private::gInstance, "framesChanged",
+            Qt::QueuedConnection);
+    }
+    Private::gMutex.unlock();
+}
+
+bool Profiler::enabled() const
+{
+    return isEnabled();
+}
+
+void Profiler::setEnabled(bool aEnabled)
+{
+    if (Private::gEnabled.fetchAndStoreOrdered(aEnabled) != (int)aEnabled) {
+        HDEBUG(aEnabled);
+        Q_EMIT enabledChanged();
+    }
+}
+
+QVariantList Profiler::frames() const
+{
+    QVariantList list;
+    Private::gMutex.lock();
+    for (int i = 0; i < Private::gCount; i++) {
+        list.append(Private::gFrames[(Private::gFirst + i) % MAX_FRAMES].
+            toVariantMap());
+    }
+    Private::gMutex.unlock();
+    return list;
+}
+
+void Profiler::clear()
+{
+    Private::gMutex.lock();
+    const bool changed = (Private::gCount > 0);
+    Private::gFirst = Private::gCount = 0;
+    Private::gMutex.unlock();
+    if (changed) {
+        Q_EMIT framesChanged();
+    }
+}
+
+QString Profiler::toJson() const
+{
+    return QString::fromUtf8(QJsonDocument(QJsonArray::
+        fromVariantList(frames())).toJson());
+}
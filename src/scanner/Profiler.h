@@ -0,0 +1,139 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef BARCODE_PROFILER_H
+#define BARCODE_PROFILER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QVariantList>
+
+class QQmlEngine;
+class QJSEngine;
+
+// Where the time goes while decoding viewfinder frames. Always compiled
+// in, but nothing is measured until it's enabled. The last MAX_FRAMES
+// frames are kept and can be read from QML or as JSON.
+class Profiler : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QVariantList frames READ frames NOTIFY framesChanged)
+
+public:
+    enum Stage {
+        StageGrab,      // Waiting for the window to be grabbed
+        StageCrop,      // Cutting out (and rotating) the viewfinder area
+        StageScale,     // Scaling it down
+        StageGrayscale, // Converting it to grayscale
+        StageBinarize,  // Building black matrices (readers do it)
+        StageDecode,    // Decoder::decode() including all of the above
+        StageRotate,    // Rotating the frame for the second attempt
+        StageTotal,     // Everything but grabbing
+        StageCount
+    };
+
+    enum Reader {
+        ReaderOneD,
+        ReaderQrCode,
+        ReaderDataMatrix,
+        ReaderAztec,
+        ReaderPdf417,
+        ReaderCount
+    };
+
+    static const int MAX_FRAMES = 100;
+
+    class Frame;
+    class Timer;
+
+    Profiler(QObject* aParent = Q_NULLPTR);
+    ~Profiler();
+
+    // Thread safe, called by the decoding thread
+    static bool isEnabled();
+    static void record(const Frame& aFrame);
+
+    bool enabled() const;
+    void setEnabled(bool aEnabled);
+
+    QVariantList frames() const;
+
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE QString toJson() const;
+
+    // Callback for qmlRegisterSingletonType<Profiler>
+    static QObject* createSingleton(QQmlEngine* aEngine, QJSEngine* aScript);
+
+Q_SIGNALS:
+    void enabledChanged();
+    void framesChanged();
+
+private:
+    class Private;
+};
+
+// Times are in nanoseconds, negative if the stage was skipped or the
+// reader didn't run
+class Profiler::Frame {
+public:
+    Frame();
+
+    void add(Stage aStage, qint64 aNanoseconds);
+    void add(Reader aReader, qint64 aNanoseconds);
+    QVariantMap toVariantMap() const;
+
+public:
+    qint64 iTimestamp;
+    int iWidth;
+    int iHeight;
+    int iFormat;
+    qint64 iStageTime[StageCount];
+    qint64 iReaderTime[ReaderCount];
+    int iReaderRuns[ReaderCount];
+    int iReaderTracked[ReaderCount]; // Runs that found the code where it was
+};
+
+// Adds the time until stop() or going out of scope to the stage. Does
+// nothing without a frame, which is what the decoding thread passes around
+// when profiling is disabled.
+class Profiler::Timer {
+    Q_DISABLE_COPY(Timer)
+
+public:
+    Timer(Frame* aFrame, Stage aStage) : iFrame(aFrame), iStage(aStage)
+        { if (iFrame) iTimer.start(); }
+    ~Timer()
+        { stop(); }
+
+    void stop()
+        { if (iFrame) { iFrame->add(iStage, iTimer.nsecsElapsed()); iFrame = NULL; } }
+
+private:
+    Frame* iFrame;
+    Stage iStage;
+    QElapsedTimer iTimer;
+};
+
+#endif // BARCODE_PROFILER_H
@@ -34,6 +34,21 @@ namespace zxing {
 		return source_;
 	}
 
+  void Binarizer::setBufferPool(Ref<BufferPool> pool) {
+    bufferPool_ = pool;
+  }
+
+  Ref<BufferPool> Binarizer::getBufferPool() const {
+    return bufferPool_;
+  }
+
+  Ref<BitMatrix> Binarizer::newBitMatrix(int width, int height) const {
+    if (bufferPool_) {
+      return bufferPool_->getBitMatrix(width, height);
+    }
+    return Ref<BitMatrix>(new BitMatrix(width, height));
+  }
+
   int Binarizer::getWidth() const {
     return source_->getWidth();
   }
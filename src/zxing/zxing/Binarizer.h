@@ -24,12 +24,17 @@
 #include <zxing/common/BitArray.h>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/common/Counted.h>
+#include <zxing/common/BufferPool.h>
 
 namespace zxing {
 
 class Binarizer : public Counted {
  private:
   Ref<LuminanceSource> source_;
+  Ref<BufferPool> bufferPool_;
+
+ protected:
+  Ref<BitMatrix> newBitMatrix(int width, int height) const;
 
  public:
   Binarizer(Ref<LuminanceSource> source);
@@ -39,6 +44,10 @@ class Binarizer : public Counted {
   virtual Ref<BitMatrix> getBlackMatrix() = 0;
 
   Ref<LuminanceSource> getLuminanceSource() const ;
+
+  /* Black matrices are taken from here, if set */
+  void setBufferPool(Ref<BufferPool> pool);
+  Ref<BufferPool> getBufferPool() const;
   virtual Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source) = 0;
 
   int getWidth() const;
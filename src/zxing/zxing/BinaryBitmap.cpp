@@ -32,7 +32,7 @@ BinaryBitmap::BinaryBitmap(Ref<Binarizer> binarizer) : binarizer_(binarizer) {
 BinaryBitmap::~BinaryBitmap() {
 }
 
-Ref<BitArray> BinaryBitmap::getBlackRow(int y, Ref<BitArray> row) {
+Ref<BitArray> BinaryBitmap::getBlackRow(int y, Ref<BitArray> const& row) {
     return binarizer_->getBlackRow(y, row);
 }
 
@@ -35,7 +35,7 @@ namespace zxing {
 		BinaryBitmap(Ref<Binarizer> binarizer);
 		virtual ~BinaryBitmap();
 		
-		Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+		Ref<BitArray> getBlackRow(int y, Ref<BitArray> const& row);
 		Ref<BitMatrix> getBlackMatrix();
 		
 		Ref<LuminanceSource> getLuminanceSource() const;
@@ -49,6 +49,8 @@ const zxing::DecodeHintType DecodeHints::UPC_EAN_EXTENSION_HINT = 1 << BarcodeFo
 const zxing::DecodeHintType DecodeHints::ASSUME_GS1 = 1 << BarcodeFormat::ASSUME_GS1;
 const zxing::DecodeHintType DecodeHints::TRYHARDER_HINT = 1 << 31;
 const zxing::DecodeHintType DecodeHints::CHARACTER_SET = 1 << 30;
+const zxing::DecodeHintType DecodeHints::TRY_INVERTED_HINT = 1 << 27;
+const zxing::DecodeHintType DecodeHints::TRY_MIRRORED_HINT = 1 << 25;
 
 const zxing::DecodeHints DecodeHints::PRODUCT_HINT(
   DecodeHints::UPC_A_HINT |
@@ -64,6 +66,7 @@ const zxing::DecodeHints DecodeHints::ONED_HINT(
   DecodeHints::CODE_128_HINT |
   DecodeHints::ITF_HINT |
   DecodeHints::CODABAR_HINT |
+  DecodeHints::RSS_EXPANDED_HINT |
   DecodeHints::PRODUCT_HINT
   );
 
@@ -150,6 +153,30 @@ bool DecodeHints::getTryHarder() const {
   return (hints & TRYHARDER_HINT) != 0;
 }
 
+void DecodeHints::setTryInverted(bool toset) {
+  if (toset) {
+    hints |= TRY_INVERTED_HINT;
+  } else {
+    hints &= ~TRY_INVERTED_HINT;
+  }
+}
+
+bool DecodeHints::getTryInverted() const {
+  return (hints & TRY_INVERTED_HINT) != 0;
+}
+
+void DecodeHints::setTryMirrored(bool toset) {
+  if (toset) {
+    hints |= TRY_MIRRORED_HINT;
+  } else {
+    hints &= ~TRY_MIRRORED_HINT;
+  }
+}
+
+bool DecodeHints::getTryMirrored() const {
+  return (hints & TRY_MIRRORED_HINT) != 0;
+}
+
 void DecodeHints::setResultPointCallback(Ref<ResultPointCallback> const& _callback) {
   callback = _callback;
 }
@@ -56,6 +56,9 @@ class DecodeHints {
 
   static const DecodeHintType TRYHARDER_HINT;
   static const DecodeHintType CHARACTER_SET;
+  // Retry QR codes as light on dark, and as seen from the back
+  static const DecodeHintType TRY_INVERTED_HINT;
+  static const DecodeHintType TRY_MIRRORED_HINT;
   // static const DecodeHintType ALLOWED_LENGTHS = 1 << 29;
   // static const DecodeHintType ASSUME_CODE_39_CHECK_DIGIT = 1 << 28;
   // static const DecodeHintType NEED_RESULT_POINT_CALLBACK = 1 << 26;
@@ -74,6 +77,10 @@ class DecodeHints {
   void clear() {hints=0;}
   void setTryHarder(bool toset);
   bool getTryHarder() const;
+  void setTryInverted(bool toset);
+  bool getTryInverted() const;
+  void setTryMirrored(bool toset);
+  bool getTryMirrored() const;
 
   void setResultPointCallback(Ref<ResultPointCallback> const&);
   Ref<ResultPointCallback> getResultPointCallback() const;
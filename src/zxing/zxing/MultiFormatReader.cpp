@@ -33,14 +33,14 @@ using zxing::MultiFormatReader;
 using zxing::DecodeHints;
 using zxing::BinaryBitmap;
 
-MultiFormatReader::MultiFormatReader() {}
+MultiFormatReader::MultiFormatReader() : observer_(NULL) {}
   
 Ref<Result> MultiFormatReader::decode(Ref<BinaryBitmap> image) {
   setHints(DecodeHints::DEFAULT_HINT);
   return decodeInternal(image);
 }
 
-Ref<Result> MultiFormatReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+Ref<Result> MultiFormatReader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
   setHints(hints);
   return decodeInternal(image);
 }
@@ -53,7 +53,7 @@ Ref<Result> MultiFormatReader::decodeWithState(Ref<BinaryBitmap> image) {
   return decodeInternal(image);
 }
 
-void MultiFormatReader::setHints(DecodeHints hints) {
+void MultiFormatReader::setHints(DecodeHints const& hints) {
   hints_ = hints;
   readers_.clear();
   bool tryHarder = hints.getTryHarder();
@@ -109,12 +109,27 @@ void MultiFormatReader::setHints(DecodeHints hints) {
   }
 }
 
+void MultiFormatReader::setObserver(Observer* observer) {
+  observer_ = observer;
+}
+
 Ref<Result> MultiFormatReader::decodeInternal(Ref<BinaryBitmap> image) {
   for (unsigned int i = 0; i < readers_.size(); i++) {
+    Reader* reader = readers_[i];
+    if (observer_) {
+      observer_->readerStarted(reader);
+    }
     try {
-      return readers_[i]->decode(image, hints_);
+      Ref<Result> result(reader->decode(image, hints_));
+      if (observer_) {
+        observer_->readerFinished(reader, true);
+      }
+      return result;
     } catch (ReaderException const& re) {
       (void)re;
+      if (observer_) {
+        observer_->readerFinished(reader, false);
+      }
       // continue
     }
   }
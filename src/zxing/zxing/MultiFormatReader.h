@@ -28,19 +28,35 @@
 
 namespace zxing {
   class MultiFormatReader : public Reader {
+  public:
+    /**
+     * Told when each reader starts and stops looking at a bitmap, so
+     * that the caller can time them. A reader that throws anything but
+     * ReaderException doesn't get finished.
+     */
+    class Observer {
+    public:
+      virtual ~Observer() {}
+      virtual void readerStarted(Reader* reader) = 0;
+      virtual void readerFinished(Reader* reader, bool found) = 0;
+    };
+
   private:
     Ref<Result> decodeInternal(Ref<BinaryBitmap> image);
   
     std::vector<Ref<Reader> > readers_;
     DecodeHints hints_;
+    Observer* observer_;
 
   public:
     MultiFormatReader();
     
     Ref<Result> decode(Ref<BinaryBitmap> image);
-    Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+    Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
     Ref<Result> decodeWithState(Ref<BinaryBitmap> image);
-    void setHints(DecodeHints hints);
+    void setHints(DecodeHints const& hints);
+    // Not owned, NULL (the default) to stop observing
+    void setObserver(Observer* observer);
     ~MultiFormatReader();
   };
 }
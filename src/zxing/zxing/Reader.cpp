@@ -28,4 +28,8 @@ Ref<Result> Reader::decode(Ref<BinaryBitmap> image) {
   return decode(image, DecodeHints::DEFAULT_HINT);
 }
 
+bool Reader::wasTracked() const {
+  return false;
+}
+
 }
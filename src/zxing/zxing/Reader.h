@@ -31,7 +31,9 @@ namespace zxing {
    Reader() {}
   public:
    virtual Ref<Result> decode(Ref<BinaryBitmap> image);
-   virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints) = 0;
+   virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints) = 0;
+   // Whether the last decode() looked where an earlier one had found the code
+   virtual bool wasTracked() const;
    virtual ~Reader();
 };
 
@@ -54,7 +54,7 @@ Ref<Result> AztecReader::decode(Ref<zxing::BinaryBitmap> image) {
   return result;
 }
         
-Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints) {
+Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints const&) {
   //cout << "decoding with hints not supported for aztec" << "\n" << flush;
   return this->decode(image);
 }
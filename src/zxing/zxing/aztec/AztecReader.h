@@ -39,7 +39,7 @@ class AztecReader : public Reader {
  public:
   AztecReader();
   virtual Ref<Result> decode(Ref<BinaryBitmap> image);
-  virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
   virtual ~AztecReader();
 };
         
@@ -20,9 +20,6 @@
  */
 
 #include <zxing/aztec/decoder/Decoder.h>
-#ifndef NO_ICONV
-#include <iconv.h>
-#endif
 #include <iostream>
 #include <zxing/FormatException.h>
 #include <zxing/common/reedsolomon/ReedSolomonDecoder.h>
@@ -30,8 +27,7 @@
 #include <zxing/common/reedsolomon/GenericGF.h>
 #include <zxing/common/IllegalArgumentException.h>
 #include <zxing/common/DecoderResult.h>
-
-#include <qglobal.h>
+#include <zxing/common/TextDecoder.h>
 
 using zxing::aztec::Decoder;
 using zxing::DecoderResult;
@@ -40,30 +36,14 @@ using zxing::BitArray;
 using zxing::BitMatrix;
 using zxing::Ref;
 
+using zxing::common::TextDecoder;
+
 using std::string;
 
 namespace {
   void add(string& result, char character) {
-#ifndef NO_ICONV
-    char character2 = character & 0xff;
-    char s[] =  {character2};
-    char* ss = s;
-    size_t sl = sizeof(s);
-    char d[4];
-    char* ds = d;
-    size_t dl = sizeof(d);
-    iconv_t ic = iconv_open("UTF-8", "ISO-8859-1");
-#if defined(Q_OS_SYMBIAN)
-    iconv(ic, (const char**)&ss, &sl, &ds, &dl);
-#else
-    iconv(ic, (char**)&ss, &sl, &ds, &dl);
-#endif
-    iconv_close(ic);
-    d[sizeof(d)-dl] = 0;
-    result.append(d);
-#else
-    result.push_back(character);
-#endif
+    zxing::byte b = (zxing::byte) character;
+    TextDecoder::append(result, &b, 1, TextDecoder::ISO8859_1);
   }
 
   const int NB_BITS_COMPACT[] = {
@@ -181,7 +161,7 @@ Ref<DecoderResult> Decoder::decode(Ref<zxing::aztec::AztecDetectorResult> detect
   return Ref<DecoderResult>(new DecoderResult(arrayOut, result));
 }
         
-Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
+Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> const& correctedBits) {
   int endIndex = codewordSize_ * ddata_->getNBDatablocks() - invertedBitCount_;
   if (endIndex > (int)correctedBits->getSize()) {
     // std::printf("invalid input\n");
@@ -287,7 +267,7 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
             
 }
         
-Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
+Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> const& rawbits) {
   //return rawbits;
   // std::printf("decoding stuff:%d datablocks in %d layers\n", ddata_->getNBDatablocks(), ddata_->getNBLayers());
             
@@ -481,7 +461,7 @@ Ref<BitMatrix> Decoder::removeDashedLines(Ref<zxing::BitMatrix> matrix) {
   return newMatrix;
 }
         
-int Decoder::readCode(Ref<zxing::BitArray> rawbits, int startIndex, int length) {
+int Decoder::readCode(Ref<zxing::BitArray> const& rawbits, int startIndex, int length) {
   int res = 0;
             
   for (int i = startIndex; i < startIndex + length; i++) {
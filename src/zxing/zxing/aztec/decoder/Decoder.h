@@ -51,11 +51,11 @@ class Decoder : public Counted {
   Ref<AztecDetectorResult> ddata_;
   int invertedBitCount_;
             
-  Ref<String> getEncodedData(Ref<BitArray> correctedBits);
-  Ref<BitArray> correctBits(Ref<BitArray> rawbits);
+  Ref<String> getEncodedData(Ref<BitArray> const& correctedBits);
+  Ref<BitArray> correctBits(Ref<BitArray> const& rawbits);
   Ref<BitArray> extractBits(Ref<BitMatrix> matrix);
   static Ref<BitMatrix> removeDashedLines(Ref<BitMatrix> matrix);
-  static int readCode(Ref<BitArray> rawbits, int startIndex, int length);
+  static int readCode(Ref<BitArray> const& rawbits, int startIndex, int length);
             
             
  public:
@@ -0,0 +1,320 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2012 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/aztec/detector/BullsEyeFinder.h>
+#include <zxing/common/detector/MathUtils.h>
+#include <zxing/ZXing.h>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+using zxing::aztec::BullsEyeFinder;
+using zxing::aztec::Point;
+using zxing::Ref;
+using zxing::BitMatrix;
+using zxing::common::detector::MathUtils;
+
+namespace {
+
+int numberOfTrailingZeros(unsigned int i) {
+#if defined(__clang__) || defined(__GNUC__)
+  return __builtin_ctz(i);
+#else
+  int n = 0;
+  while ((i & 1) == 0) {
+    i >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+int bitCount(unsigned int i) {
+#if defined(__clang__) || defined(__GNUC__)
+  return __builtin_popcount(i);
+#else
+  int n = 0;
+  for (; i != 0; i &= i - 1) {
+    n++;
+  }
+  return n;
+#endif
+}
+
+bool isBlack(BitMatrix& image, int t, int fixed, bool vertical) {
+  return vertical ? image.get(fixed, t) : image.get(t, fixed);
+}
+
+}
+
+// Rows between two scanned rows; the centre module has to be at least this tall
+int BullsEyeFinder::ROW_SKIP = 2;
+// At most this many centres are handed to the detector
+int BullsEyeFinder::MAX_CANDIDATES = 3;
+// White, black, white, black centre, white, black, white
+int BullsEyeFinder::RING_RUNS = 7;
+// Rows with shorter runs than this on average are noise. A bull's eye has
+// runs of at least ROW_SKIP pixels and the quiet zone around a symbol
+// makes up for the data modules
+int BullsEyeFinder::MIN_MEAN_RUN = 3;
+
+BullsEyeFinder::BullsEyeFinder(Ref<BitMatrix> image)
+  : image_(image), runs_(image->getWidth() + 1) {
+}
+
+/**
+ * Splits row y into runs, a word at a time: each set bit of
+ * bits ^ (bits << 1) is a pixel that differs from its left hand neighbour.
+ * Whenever a white run ends, it and the six runs before it are tested
+ * as the pattern; a run shorter than ROW_SKIP rules out every window
+ * containing it, so noisy rows rarely get as far as foundPattern().
+ * Rows of pixel noise are rejected by their number of changes before
+ * any of that.
+ */
+void BullsEyeFinder::scanRow(int y) {
+  BitMatrix const& image = *image_;
+  int width = image.getWidth();
+  if (countChanges(y) * MIN_MEAN_RUN > width) {
+    return;
+  }
+
+  int* runs = &runs_[0];
+  int numRuns = 0;
+  int lastShortRun = -1;
+  int runStart = 0;
+  unsigned int previous = 0;
+  for (int x = 0; x < width; x += 32) {
+    unsigned int bits = (unsigned int) image.getBulk(x, y);
+    unsigned int changes = bits ^ ((bits << 1) | previous);
+    while (changes != 0) {
+      int end = x + numberOfTrailingZeros(changes);
+      if (end >= width) {
+        break;
+      }
+      int run = end - runStart;
+      if (run < ROW_SKIP) {
+        lastShortRun = numRuns;
+      }
+      runs[numRuns] = run;
+      // Even runs are white; the pattern has to be closed by black on both sides
+      if ((numRuns & 1) == 0 && numRuns > RING_RUNS && lastShortRun <= numRuns - RING_RUNS) {
+        checkPattern(runs + numRuns - RING_RUNS + 1, end, y);
+      }
+      numRuns++;
+      runStart = end;
+      changes &= changes - 1;
+    }
+    previous = bits >> 31;
+  }
+}
+
+int BullsEyeFinder::countChanges(int y) const {
+  BitMatrix const& image = *image_;
+  int width = image.getWidth();
+  int count = 0;
+  unsigned int previous = 0;
+  for (int x = 0; x < width; x += 32) {
+    unsigned int bits = (unsigned int) image.getBulk(x, y);
+    count += bitCount(bits ^ ((bits << 1) | previous));
+    previous = bits >> 31;
+  }
+  return count;
+}
+
+/**
+ * @param runs the seven runs of a possible pattern
+ * @param end column just past the last of them
+ */
+void BullsEyeFinder::checkPattern(int const* runs, int end, int y) {
+  float moduleSize;
+  if (!foundPattern(runs, &moduleSize)) {
+    return;
+  }
+  int centerX = end - runs[6] - runs[5] - runs[4] - (runs[3] + 1) / 2;
+  if (!probeRings(centerX, y, moduleSize)) {
+    return;
+  }
+  float verticalSize = moduleSize;
+  float centerY = crossCheck(centerX, y, true, &verticalSize);
+  if (isnan_z(centerY)) {
+    return;
+  }
+  float horizontalSize = moduleSize;
+  float refinedX = crossCheck(centerX, int(centerY), false, &horizontalSize);
+  if (isnan_z(refinedX)) {
+    return;
+  }
+  addCandidate(refinedX, centerY, (verticalSize + horizontalSize) / 2.0f);
+}
+
+bool BullsEyeFinder::foundPattern(int const* runs, float* moduleSize) {
+  int total = 0;
+  for (int i = 0; i < RING_RUNS; i++) {
+    total += runs[i];
+  }
+  // Modules smaller than the row skip would fall between scanned rows anyway
+  if (total < RING_RUNS * ROW_SKIP) {
+    return false;
+  }
+  // Each run within half a module of total / 7. Noise fails this at a
+  // random run, so all of them are checked without branching
+  bool off = false;
+  for (int i = 0; i < RING_RUNS; i++) {
+    int run = 2 * RING_RUNS * runs[i];
+    off |= (run <= total) | (run >= 3 * total);
+  }
+  *moduleSize = total / float(RING_RUNS);
+  return !off;
+}
+
+/**
+ * A quick look above and below the centre module before crossCheck()
+ * walks the column: the middles of the two nearest rings have to be
+ * white and black. Most patterns found in noise or in the data area of
+ * a symbol fail here.
+ */
+bool BullsEyeFinder::probeRings(int x, int y, float moduleSize) const {
+  BitMatrix const& image = *image_;
+  int height = image.getHeight();
+  int maxCount = int(moduleSize * 2) + 1;
+  int top = y;
+  while (top > 0 && y - top < maxCount && image.get(x, top - 1)) {
+    top--;
+  }
+  int bottom = y;
+  while (bottom + 1 < height && bottom - y < maxCount && image.get(x, bottom + 1)) {
+    bottom++;
+  }
+  for (int ring = 1; ring <= 2; ring++) {
+    int offset = int(moduleSize * (ring - 0.5f));
+    bool black = (ring & 1) == 0;
+    if (top - 1 - offset < 0 || bottom + 1 + offset >= height ||
+        image.get(x, top - 1 - offset) != black ||
+        image.get(x, bottom + 1 + offset) != black) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Walks out from a pixel of the centre module along a column (or a row) and
+ * checks that the same seven runs are there, each closed by the next ring.
+ *
+ * @param moduleSize in: size seen by the row scan, out: size seen here
+ * @return centre of the centre module along the walked line, or NaN
+ */
+float BullsEyeFinder::crossCheck(int x, int y, bool vertical, float* moduleSize) {
+  BitMatrix& image = *image_;
+  int fixed = vertical ? x : y;
+  int pos = vertical ? y : x;
+  int limit = vertical ? image.getHeight() : image.getWidth();
+  int maxCount = int(*moduleSize * 2) + 1;
+  int counts[7] = {0, 0, 0, 0, 0, 0, 0};
+
+  if (!isBlack(image, pos, fixed, vertical)) {
+    return nan();
+  }
+
+  int t = pos;
+  while (t >= 0 && isBlack(image, t, fixed, vertical)) {
+    counts[3]++;
+    t--;
+  }
+  int start = t + 1;
+  for (int state = 2; state >= 0; state--) {
+    bool black = (state & 1) != 0;
+    while (t >= 0 && isBlack(image, t, fixed, vertical) == black && counts[state] <= maxCount) {
+      counts[state]++;
+      t--;
+    }
+    if (t < 0 || counts[state] > maxCount) {
+      return nan();
+    }
+  }
+
+  t = pos + 1;
+  while (t < limit && isBlack(image, t, fixed, vertical)) {
+    counts[3]++;
+    t++;
+  }
+  int end = t;
+  if (counts[3] > maxCount) {
+    return nan();
+  }
+  for (int state = 4; state < RING_RUNS; state++) {
+    bool black = (state & 1) != 0;
+    while (t < limit && isBlack(image, t, fixed, vertical) == black && counts[state] <= maxCount) {
+      counts[state]++;
+      t++;
+    }
+    if (t >= limit || counts[state] > maxCount) {
+      return nan();
+    }
+  }
+
+  float size;
+  if (!foundPattern(counts, &size) || 2 * std::abs(size - *moduleSize) >= *moduleSize) {
+    return nan();
+  }
+  *moduleSize = size;
+  return (start + end - 1) / 2.0f;
+}
+
+void BullsEyeFinder::addCandidate(float x, float y, float moduleSize) {
+  for (size_t i = 0; i < candidates_.size(); i++) {
+    Candidate& candidate = candidates_[i];
+    if (std::abs(candidate.x - x) <= candidate.moduleSize &&
+        std::abs(candidate.y - y) <= candidate.moduleSize) {
+      float count = float(candidate.count);
+      candidate.x = (candidate.x * count + x) / (count + 1);
+      candidate.y = (candidate.y * count + y) / (count + 1);
+      candidate.moduleSize = (candidate.moduleSize * count + moduleSize) / (count + 1);
+      candidate.count++;
+      return;
+    }
+  }
+  Candidate candidate = { x, y, moduleSize, 1 };
+  candidates_.push_back(candidate);
+}
+
+namespace {
+
+struct MoreConfirmed {
+  template <typename T>
+  bool operator()(T const& a, T const& b) const {
+    return a.count > b.count;
+  }
+};
+
+}
+
+vector<Ref<Point> > BullsEyeFinder::find() {
+  candidates_.clear();
+  int height = image_->getHeight();
+  for (int y = ROW_SKIP / 2; y < height; y += ROW_SKIP) {
+    scanRow(y);
+  }
+
+  std::stable_sort(candidates_.begin(), candidates_.end(), MoreConfirmed());
+  vector<Ref<Point> > centers;
+  for (size_t i = 0; i < candidates_.size() && int(i) < MAX_CANDIDATES; i++) {
+    centers.push_back(Ref<Point>(new Point(MathUtils::round(candidates_[i].x),
+                                           MathUtils::round(candidates_[i].y))));
+  }
+  return centers;
+}
@@ -20,8 +20,8 @@
  */
 
 #include <zxing/aztec/detector/Detector.h>
+#include <zxing/aztec/detector/BullsEyeFinder.h>
 #include <zxing/common/GridSampler.h>
-#include <zxing/common/detector/WhiteRectangleDetector.h>
 #include <zxing/common/reedsolomon/ReedSolomonDecoder.h>
 #include <zxing/common/reedsolomon/ReedSolomonException.h>
 #include <zxing/common/reedsolomon/GenericGF.h>
@@ -49,8 +49,25 @@ Detector::Detector(Ref<BitMatrix> image):
 }
         
 Ref<AztecDetectorResult> Detector::detect() {
-  Ref<Point> pCenter = getMatrixCenter();
-            
+  std::vector<Ref<Point> > centers = BullsEyeFinder(image_).find();
+  if (centers.empty()) {
+    throw NotFoundException("no bull's eye found");
+  }
+  for (size_t i = 0; ; i++) {
+    try {
+      return detect(centers[i]);
+    } catch (zxing::Exception const& e) {
+      // Sampling a false bull's eye can fail in other ways than not
+      // finding the code, the next candidate may still be the real one
+      (void)e;
+      if (i + 1 == centers.size()) {
+        throw;
+      }
+    }
+  }
+}
+
+Ref<AztecDetectorResult> Detector::detect(Ref<Point> pCenter) {
   std::vector<Ref<Point> > bullEyeCornerPoints = getBullEyeCornerPoints(pCenter);
             
   extractParameters(bullEyeCornerPoints);
@@ -176,7 +193,7 @@ Detector::getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints) {
   return ArrayRef< Ref<ResultPoint> >(array);
 }
         
-void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool compact) {
+void Detector::correctParameterData(Ref<zxing::BitArray> const& parameterData, bool compact) {
   int numCodewords;
   int numDataCodewords;
             
@@ -301,57 +318,6 @@ std::vector<Ref<Point> > Detector::getBullEyeCornerPoints(Ref<zxing::aztec::Poin
             
 }
         
-Ref<Point> Detector::getMatrixCenter() {
-  Ref<ResultPoint> pointA, pointB, pointC, pointD;
-  try {
-                
-    std::vector<Ref<ResultPoint> > cornerPoints = WhiteRectangleDetector(image_).detect();
-    pointA = cornerPoints[0];
-    pointB = cornerPoints[1];
-    pointC = cornerPoints[2];
-    pointD = cornerPoints[3];
-                
-  } catch (NotFoundException const& e) {
-    (void)e;
-                
-    int cx = image_->getWidth() / 2;
-    int cy = image_->getHeight() / 2;
-                
-    pointA = getFirstDifferent(Ref<Point>(new Point(cx+7, cy-7)), false,  1, -1)->toResultPoint();
-    pointB = getFirstDifferent(Ref<Point>(new Point(cx+7, cy+7)), false,  1,  1)->toResultPoint();
-    pointC = getFirstDifferent(Ref<Point>(new Point(cx-7, cy+7)), false, -1, -1)->toResultPoint();
-    pointD = getFirstDifferent(Ref<Point>(new Point(cx-7, cy-7)), false, -1, -1)->toResultPoint();
-                                      
-  }
-            
-  int cx = MathUtils::round((pointA->getX() + pointD->getX() + pointB->getX() + pointC->getX()) / 4.0f);
-  int cy = MathUtils::round((pointA->getY() + pointD->getY() + pointB->getY() + pointC->getY()) / 4.0f);
-            
-  try {
-                
-    std::vector<Ref<ResultPoint> > cornerPoints = WhiteRectangleDetector(image_, 15, cx, cy).detect();
-    pointA = cornerPoints[0];
-    pointB = cornerPoints[1];
-    pointC = cornerPoints[2];
-    pointD = cornerPoints[3];
-                
-  } catch (NotFoundException const& e) {
-    (void)e;
-                
-    pointA = getFirstDifferent(Ref<Point>(new Point(cx+7, cy-7)), false,  1, -1)->toResultPoint();
-    pointB = getFirstDifferent(Ref<Point>(new Point(cx+7, cy+7)), false,  1,  1)->toResultPoint();
-    pointC = getFirstDifferent(Ref<Point>(new Point(cx-7, cy+7)), false, -1, 1)->toResultPoint();
-    pointD = getFirstDifferent(Ref<Point>(new Point(cx-7, cy-7)), false, -1, -1)->toResultPoint();
-                
-  }
-            
-  cx = MathUtils::round((pointA->getX() + pointD->getX() + pointB->getX() + pointC->getX()) / 4.0f);
-  cy = MathUtils::round((pointA->getY() + pointD->getY() + pointB->getY() + pointC->getY()) / 4.0f);
-            
-  return Ref<Point>(new Point(cx, cy));
-            
-}
-        
 Ref<BitMatrix> Detector::sampleGrid(Ref<zxing::BitMatrix> image,
                                     Ref<zxing::ResultPoint> topLeft,
                                     Ref<zxing::ResultPoint> bottomLeft,
@@ -390,7 +356,7 @@ Ref<BitMatrix> Detector::sampleGrid(Ref<zxing::BitMatrix> image,
                             bottomLeft->getY());
 }
         
-void Detector::getParameters(Ref<zxing::BitArray> parameterData) {
+void Detector::getParameters(Ref<zxing::BitArray> const& parameterData) {
   nbLayers_ = 0;
   nbDataBlocks_ = 0;
             
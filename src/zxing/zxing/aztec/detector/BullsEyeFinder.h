@@ -0,0 +1,78 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2012 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __ZXING_AZTEC_DETECTOR_BULLS_EYE_FINDER_H__
+#define __ZXING_AZTEC_DETECTOR_BULLS_EYE_FINDER_H__
+
+#include <vector>
+
+#include <zxing/common/BitMatrix.h>
+#include <zxing/aztec/detector/Detector.h>
+
+namespace zxing {
+namespace aztec {
+
+/**
+ * Looks for the centre of an Aztec bull's-eye. Any line through the centre
+ * crosses the three innermost rings on either side of the central module,
+ * which gives seven runs of about one module each: white, black, white,
+ * black (the centre), white, black, white. Rows are scanned as run lengths
+ * for that pattern and each hit is cross-checked along its column.
+ */
+class BullsEyeFinder {
+ private:
+  static int ROW_SKIP;
+  static int MAX_CANDIDATES;
+  static int RING_RUNS;
+  static int MIN_MEAN_RUN;
+
+  struct Candidate {
+    float x;
+    float y;
+    float moduleSize;
+    int count;
+  };
+
+  Ref<BitMatrix> image_;
+
+  // Run lengths of the row being scanned, starting with a (possibly empty)
+  // white run; a row has at most one run per pixel
+  std::vector<int> runs_;
+  std::vector<Candidate> candidates_;
+
+  void scanRow(int y);
+  int countChanges(int y) const;
+  void checkPattern(int const* runs, int end, int y);
+  static bool foundPattern(int const* runs, float* moduleSize);
+  bool probeRings(int x, int y, float moduleSize) const;
+  float crossCheck(int x, int y, bool vertical, float* moduleSize);
+  void addCandidate(float x, float y, float moduleSize);
+
+ public:
+  BullsEyeFinder(Ref<BitMatrix> image);
+
+  /**
+   * @return the likely bull's-eye centres, most often confirmed first.
+   *         Empty if the image has none.
+   */
+  std::vector<Ref<Point> > find();
+};
+
+}
+}
+
+#endif
@@ -62,15 +62,14 @@ class Detector : public Counted {
             
   void extractParameters(std::vector<Ref<Point> > bullEyeCornerPoints);
   ArrayRef< Ref<ResultPoint> > getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints);
-  static void correctParameterData(Ref<BitArray> parameterData, bool compact);
+  static void correctParameterData(Ref<BitArray> const& parameterData, bool compact);
   std::vector<Ref<Point> > getBullEyeCornerPoints(Ref<Point> pCenter);
-  Ref<Point> getMatrixCenter();
   Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image,
                             Ref<ResultPoint> topLeft,
                             Ref<ResultPoint> bottomLeft,
                             Ref<ResultPoint> bottomRight,
                             Ref<ResultPoint> topRight);
-  void getParameters(Ref<BitArray> parameterData);
+  void getParameters(Ref<BitArray> const& parameterData);
   Ref<BitArray> sampleLine(Ref<Point> p1, Ref<Point> p2, int size);
   bool isWhiteOrBlackRectangle(Ref<Point> p1,
                                Ref<Point> p2,
@@ -80,6 +79,7 @@ class Detector : public Counted {
   Ref<Point> getFirstDifferent(Ref<Point> init, bool color, int dx, int dy);
   bool isValid(int x, int y);
   static float distance(Ref<Point> a, Ref<Point> b);
+  Ref<AztecDetectorResult> detect(Ref<Point> pCenter);
             
  public:
   Detector(Ref<BitMatrix> image);
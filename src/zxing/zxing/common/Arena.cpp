@@ -0,0 +1,130 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Arena.h>
+#include <cstdlib>
+#include <new>
+
+using zxing::Arena;
+
+namespace {
+
+enum {
+  // Small block sizes are rounded up to a multiple of this, so that any
+  // block of a size class can be reused for any object of that class
+  GRANULE = 16,
+  // Blocks of up to GRANULE * SIZE_CLASSES bytes are recycled
+  SIZE_CLASSES = 16,
+  // More than this many free blocks of one size go back to the heap
+  MAX_FREE_BLOCKS = 256
+};
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct ThreadCache {
+  int depth;
+  FreeBlock* blocks[SIZE_CLASSES];
+  int count[SIZE_CLASSES];
+  unsigned long heapAllocations;
+};
+
+#if defined(__clang__) || defined(__GNUC__)
+__thread ThreadCache threadCache;
+
+inline ThreadCache* cache() {
+  return &threadCache;
+}
+#else
+// No portable thread local storage before C++11, don't recycle anything
+inline ThreadCache* cache() {
+  return 0;
+}
+#endif
+
+inline size_t sizeClass(size_t size) {
+  return size ? (size - 1) / GRANULE : 0;
+}
+
+}
+
+void* Arena::allocate(size_t size) {
+  size_t index = sizeClass(size);
+  if (index < SIZE_CLASSES) {
+    ThreadCache* c = cache();
+    // The lists are only ever filled inside a scope
+    if (c && c->blocks[index]) {
+      FreeBlock* block = c->blocks[index];
+      c->blocks[index] = block->next;
+      c->count[index]--;
+      return block;
+    }
+    size = (index + 1) * GRANULE;
+  }
+  void* block = std::malloc(size);
+  if (!block) {
+    throw std::bad_alloc();
+  }
+  ThreadCache* c = cache();
+  if (c) {
+    c->heapAllocations++;
+  }
+  return block;
+}
+
+void Arena::release(void* block, size_t size) {
+  if (!block) {
+    return;
+  }
+  size_t index = sizeClass(size);
+  ThreadCache* c = cache();
+  if (index < SIZE_CLASSES && c && c->depth > 0 && c->count[index] < MAX_FREE_BLOCKS) {
+    FreeBlock* free = static_cast<FreeBlock*>(block);
+    free->next = c->blocks[index];
+    c->blocks[index] = free;
+    c->count[index]++;
+  } else {
+    std::free(block);
+  }
+}
+
+unsigned long Arena::heapAllocations() {
+  ThreadCache* c = cache();
+  return c ? c->heapAllocations : 0;
+}
+
+Arena::Scope::Scope() {
+  ThreadCache* c = cache();
+  if (c) {
+    c->depth++;
+  }
+}
+
+Arena::Scope::~Scope() {
+  ThreadCache* c = cache();
+  if (c && --c->depth == 0) {
+    for (int i = 0; i < SIZE_CLASSES; i++) {
+      while (c->blocks[i]) {
+        FreeBlock* block = c->blocks[i];
+        c->blocks[i] = block->next;
+        std::free(block);
+      }
+      c->count[i] = 0;
+    }
+  }
+}
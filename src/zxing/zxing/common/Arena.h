@@ -0,0 +1,59 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+/*
+ * Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+
+namespace zxing {
+
+/**
+ * Memory for Counted objects. While an Arena::Scope is alive on a thread,
+ * small blocks released on that thread are kept on per-size free lists and
+ * handed out again by the next allocations of that size; the lists go back
+ * to the heap when the outermost scope ends. Without a scope this is plain
+ * malloc() and free().
+ *
+ * Every block is an ordinary heap block, so objects may outlive the scope
+ * they were created in, or be released on another thread.
+ */
+class Arena {
+public:
+  /* Keeps released blocks for reuse on this thread until it goes away */
+  class Scope {
+  public:
+    Scope();
+    ~Scope();
+  private:
+    Scope(Scope const&);
+    Scope& operator=(Scope const&);
+  };
+
+  static void* allocate(size_t size);
+  static void release(void* block, size_t size);
+
+  /* Number of blocks this thread has had to take from the heap */
+  static unsigned long heapAllocations();
+
+private:
+  Arena();
+};
+
+}
+
+#endif // __ARENA_H__
@@ -116,6 +116,13 @@ public:
     reset(static_cast<const Array<T> *>(other.array_));
   }
 
+#ifdef ZXING_HAVE_RVALUE_REFS
+  ArrayRef(ArrayRef &&other) :
+      Counted(), array_(other.array_) {
+    other.array_ = 0;
+  }
+#endif
+
   ~ArrayRef() {
     if (array_) {
       array_->release();
@@ -147,6 +154,19 @@ public:
     reset(other);
     return *this;
   }
+#ifdef ZXING_HAVE_RVALUE_REFS
+  ArrayRef<T>& operator=(ArrayRef<T> &&other) {
+    if (this != &other) {
+      Array<T>* old = array_;
+      array_ = other.array_;
+      other.array_ = 0;
+      if (old) {
+        old->release();
+      }
+    }
+    return *this;
+  }
+#endif
   ArrayRef<T>& operator=(Array<T> *a) {
     reset(a);
     return *this;
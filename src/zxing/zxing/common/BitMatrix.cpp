@@ -60,6 +60,31 @@ void BitMatrix::flip(int x, int y) {
     bits[offset] ^= 1 << (x & 0x1f);
 }
 
+void BitMatrix::clear() {
+    memset(bits, 0, sizeof(int) * rowSize * height);
+}
+
+/**
+ * Flips every bit; the unused bits at the end of each row stay clear.
+ */
+void BitMatrix::flip() {
+    int tailBits = width & 0x1f;
+    int tailMask = tailBits ? (1 << tailBits) - 1 : -1;
+    for (int y = 0; y < height; y++) {
+        int* row = bits + y * rowSize;
+        for (int x = 0; x < rowSize - 1; x++) {
+            row[x] = ~row[x];
+        }
+        row[rowSize - 1] = ~row[rowSize - 1] & tailMask;
+    }
+}
+
+Ref<BitMatrix> BitMatrix::clone() const {
+    Ref<BitMatrix> copy(new BitMatrix(width, height));
+    memcpy(copy->bits, bits, sizeof(int) * rowSize * height);
+    return copy;
+}
+
 void BitMatrix::rotate180()
 {
     int width = getWidth();
@@ -107,7 +132,7 @@ Ref<BitArray> BitMatrix::getRow(int y, Ref<BitArray> row) {
     return row;
 }
 
-void BitMatrix::setRow(int y, Ref<zxing::BitArray> row)
+void BitMatrix::setRow(int y, Ref<zxing::BitArray> const& row)
 {
     if (y < 0 || y >= height ||
             row->getSize() != width)
@@ -46,18 +46,30 @@ public:
     return ((((unsigned)bits[offset]) >> (x & 0x1f)) & 1) != 0;
   }
 
+  /** The 32 pixels of row y sharing a word with x; bit i is column (x & ~31) + i. */
+  int getBulk(int x, int y) const {
+    return bits[y * rowSize + (x >> 5)];
+  }
+
+  /** Replaces the 32 pixels of row y sharing a word with x, see getBulk(). */
+  void setBulk(int x, int y, int newBits) {
+    bits[y * rowSize + (x >> 5)] = newBits;
+  }
+
   void set(int x, int y) {
     int offset = y * rowSize + (x >> 5);
     bits[offset] |= 1 << (x & 0x1f);
   }
 
   void flip(int x, int y);
+  void flip();
   void rotate180();
 
   void clear();
+  Ref<BitMatrix> clone() const;
   void setRegion(int left, int top, int width, int height);
   Ref<BitArray> getRow(int y, Ref<BitArray> row);
-  void setRow(int y, Ref<BitArray> row);
+  void setRow(int y, Ref<BitArray> const& row);
 
   int getWidth() const;
   int getHeight() const;
@@ -0,0 +1,111 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/BufferPool.h>
+
+using zxing::BufferPool;
+using zxing::BitMatrix;
+using zxing::BitArray;
+using zxing::ArrayRef;
+using zxing::Counted;
+using zxing::Ref;
+using zxing::byte;
+
+BufferPool::BufferPool(size_t maxSize)
+  : maxSize_(maxSize), size_(0), hits_(0), misses_(0) {
+}
+
+/**
+ * @return an idle buffer of this kind and size, or null
+ */
+Counted* BufferPool::find(Kind kind, int width, int height) {
+  for (size_t i = 0; i < entries_.size(); i++) {
+    Entry& entry = entries_[i];
+    // The pool's own reference is the only one left
+    if (entry.kind == kind && entry.width == width && entry.height == height &&
+        entry.buffer->count() == 1) {
+      hits_++;
+      return entry.buffer;
+    }
+  }
+  misses_++;
+  return 0;
+}
+
+void BufferPool::add(Counted* buffer, Kind kind, int width, int height, size_t size) {
+  for (size_t i = 0; i < entries_.size() && size_ + size > maxSize_; ) {
+    if (entries_[i].buffer->count() == 1) {
+      size_ -= entries_[i].size;
+      entries_.erase(entries_.begin() + i);
+    } else {
+      i++;
+    }
+  }
+  if (size_ + size <= maxSize_) {
+    Entry entry;
+    entry.buffer = buffer;
+    entry.kind = kind;
+    entry.width = width;
+    entry.height = height;
+    entry.size = size;
+    entries_.push_back(entry);
+    size_ += size;
+  }
+}
+
+Ref<BitMatrix> BufferPool::getBitMatrix(int width, int height) {
+  BitMatrix* matrix = static_cast<BitMatrix*>(find(MATRIX, width, height));
+  if (matrix) {
+    matrix->clear();
+  } else {
+    matrix = new BitMatrix(width, height);
+    add(matrix, MATRIX, width, height, sizeof(int) * ((width + 31) >> 5) * height);
+  }
+  return Ref<BitMatrix>(matrix);
+}
+
+Ref<BitArray> BufferPool::getBitArray(int size) {
+  BitArray* array = static_cast<BitArray*>(find(ARRAY, size, 1));
+  if (array) {
+    array->clear();
+  } else {
+    array = new BitArray(size);
+    add(array, ARRAY, size, 1, sizeof(int) * ((size + 31) >> 5));
+  }
+  return Ref<BitArray>(array);
+}
+
+ArrayRef<byte> BufferPool::getBytes(int size) {
+  Array<byte>* bytes = static_cast<Array<byte>*>(find(BYTES, size, 1));
+  if (!bytes) {
+    bytes = new Array<byte>(size);
+    add(bytes, BYTES, size, 1, size);
+  }
+  return ArrayRef<byte>(bytes);
+}
+
+int BufferPool::getHits() const {
+  return hits_;
+}
+
+int BufferPool::getMisses() const {
+  return misses_;
+}
+
+size_t BufferPool::getSize() const {
+  return size_;
+}
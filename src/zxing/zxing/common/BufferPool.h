@@ -0,0 +1,85 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __BUFFER_POOL_H__
+#define __BUFFER_POOL_H__
+
+/*
+ * Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/common/Counted.h>
+#include <zxing/common/Array.h>
+#include <zxing/common/BitArray.h>
+#include <zxing/common/BitMatrix.h>
+#include <zxing/common/Types.h>
+
+namespace zxing {
+
+/**
+ * Frame sized buffers, kept for the next frame of the same size. A buffer
+ * is handed out again once the pool holds the last reference to it, so
+ * callers just drop their references as usual.
+ *
+ * Buffers are kept until they add up to the size limit; past that, idle
+ * buffers are dropped oldest first, and if that is not enough the new
+ * buffer is not kept at all.
+ *
+ * Not thread safe: use one pool per decoding thread, like the readers.
+ */
+class BufferPool : public Counted {
+private:
+  enum Kind {
+    MATRIX,
+    ARRAY,
+    BYTES
+  };
+
+  struct Entry {
+    Ref<Counted> buffer;
+    Kind kind;
+    int width;
+    int height;
+    size_t size;
+  };
+
+  std::vector<Entry> entries_;
+  size_t maxSize_;
+  size_t size_;
+  int hits_;
+  int misses_;
+
+  Counted* find(Kind kind, int width, int height);
+  void add(Counted* buffer, Kind kind, int width, int height, size_t size);
+
+public:
+  BufferPool(size_t maxSize);
+
+  /* A matrix with all bits clear */
+  Ref<BitMatrix> getBitMatrix(int width, int height);
+  /* An array with all bits clear */
+  Ref<BitArray> getBitArray(int size);
+  /* An array of size bytes; the contents are left over from its last use */
+  ArrayRef<byte> getBytes(int size);
+
+  /* Requests served from the pool, and requests that had to allocate */
+  int getHits() const;
+  int getMisses() const;
+  /* Bytes held by the pool, in use or not */
+  size_t getSize() const;
+};
+
+}
+
+#endif // __BUFFER_POOL_H__
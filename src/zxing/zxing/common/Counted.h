@@ -19,6 +19,12 @@
  */
 
 #include <iostream>
+#include <zxing/common/Arena.h>
+
+// Move construction and assignment need rvalue references
+#if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__)
+#define ZXING_HAVE_RVALUE_REFS 1
+#endif
 
 namespace zxing {
 
@@ -32,6 +38,15 @@ public:
   }
   virtual ~Counted() {
   }
+
+  // Counted objects come from the Arena, and are recycled within an Arena::Scope
+  static void* operator new(size_t size) {
+    return Arena::allocate(size);
+  }
+  static void operator delete(void* block, size_t size) {
+    Arena::release(block, size);
+  }
+
   Counted *retain() {
 #ifdef __GNUC__
     __sync_add_and_fetch(&count_, 1);
@@ -41,11 +56,12 @@ public:
     return this;
   }
   void release() {
-#if FBREADER_USE_GNUC_SYNC_BUILTINS
+    // Must be atomic whenever retain() is, or objects shared between
+    // decoding threads can be freed twice or never
+#ifdef __GNUC__
     if (!__sync_sub_and_fetch(&count_, 1)) {
 #else
-    count_--;
-    if (count_ == 0) {
+    if (--count_ == 0) {
 #endif
       count_ = 0xDEADF001;
       delete this;
@@ -78,6 +94,20 @@ public:
     reset(other.object_);
   }
 
+#ifdef ZXING_HAVE_RVALUE_REFS
+  // Takes over the reference without touching the count
+  Ref(Ref &&other) :
+      object_(other.object_) {
+    other.object_ = 0;
+  }
+
+  template<class Y>
+  Ref(Ref<Y> &&other) :
+      object_(other.object_) {
+    other.object_ = 0;
+  }
+#endif
+
   ~Ref() {
     if (object_) {
       object_->release();
@@ -102,6 +132,29 @@ public:
     reset(other.object_);
     return *this;
   }
+#ifdef ZXING_HAVE_RVALUE_REFS
+  Ref& operator=(Ref &&other) {
+    if (this != &other) {
+      T* old = object_;
+      object_ = other.object_;
+      other.object_ = 0;
+      if (old) {
+        old->release();
+      }
+    }
+    return *this;
+  }
+  template<class Y>
+  Ref& operator=(Ref<Y> &&other) {
+    T* old = object_;
+    object_ = other.object_;
+    other.object_ = 0;
+    if (old) {
+      old->release();
+    }
+    return *this;
+  }
+#endif
   Ref& operator=(T* o) {
     reset(o);
     return *this;
@@ -112,7 +165,7 @@ public:
     return *this;
   }
 
-  T& operator*() {
+  T& operator*() const {
     return *object_;
   }
   T* operator->() const {
@@ -122,7 +175,7 @@ public:
     return object_;
   }
 
-  bool operator==(const T* that) {
+  bool operator==(const T* that) const {
     return object_ == that;
   }
   bool operator==(const Ref &other) const {
@@ -133,7 +186,7 @@ public:
     return object_ == other.object_ || *object_ == *(other.object_);
   }
 
-  bool operator!=(const T* that) {
+  bool operator!=(const T* that) const {
     return !(*this == that);
   }
 
@@ -21,6 +21,8 @@
 #include <zxing/common/GridSampler.h>
 #include <zxing/common/PerspectiveTransform.h>
 #include <zxing/ReaderException.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -32,48 +34,72 @@ GridSampler GridSampler::gridSampler;
 GridSampler::GridSampler() {
 }
 
-Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform) {
-  Ref<BitMatrix> bits(new BitMatrix(dimension));
-  vector<float> points(dimension << 1, (const float)0.0f);
-  for (int y = 0; y < dimension; y++) {
-    int max = points.size();
-    float yValue = (float)y + 0.5f;
-    for (int x = 0; x < max; x += 2) {
-      points[x] = (float)(x >> 1) + 0.5f;
-      points[x + 1] = yValue;
-    }
-    transform->transformPoints(points);
-    checkAndNudgePoints(image, points);
-    for (int x = 0; x < max; x += 2) {
-      if (image->get((int)points[x], (int)points[x + 1])) {
-        bits->set(x >> 1, y);
-      }
-    }
-  }
-  return bits;
+Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform,
+                                       Sampling sampling) {
+  return sampleGrid(image, dimension, dimension, transform, sampling);
 }
 
-Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimensionX, int dimensionY, Ref<PerspectiveTransform> transform) {
+/**
+ * Samples a row of modules at a time: the module centres of the row are
+ * transformed in one go, and their bits are collected into whole words.
+ */
+Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimensionX, int dimensionY, Ref<PerspectiveTransform> transform,
+                                       Sampling sampling) {
   Ref<BitMatrix> bits(new BitMatrix(dimensionX, dimensionY));
-  vector<float> points(dimensionX << 1, (const float)0.0f);
+  BitMatrix const& source = *image;
+  int width = source.getWidth();
+  int height = source.getHeight();
+  vector<float> xs(dimensionX);
+  vector<float> ys(dimensionX);
   for (int y = 0; y < dimensionY; y++) {
-    int max = points.size();
-    float yValue = (float)y + 0.5f;
-    for (int x = 0; x < max; x += 2) {
-      points[x] = (float)(x >> 1) + 0.5f;
-      points[x + 1] = yValue;
+    transform->transformRow((float)y + 0.5f, dimensionX, &xs[0], &ys[0]);
+
+    int radius = 0;
+    if (sampling == MAJORITY && dimensionX > 1) {
+      // Spread the samples over the middle two thirds of a module
+      float dx = xs[dimensionX - 1] - xs[0];
+      float dy = ys[dimensionX - 1] - ys[0];
+      radius = (int)(sqrt(dx * dx + dy * dy) / (dimensionX - 1) / 3.0f);
     }
-    transform->transformPoints(points);
-    checkAndNudgePoints(image, points);
-    for (int x = 0; x < max; x += 2) {
-      if (image->get((int)points[x], (int)points[x + 1])) {
-        bits->set(x >> 1, y);
+
+    unsigned int word = 0;
+    for (int x = 0; x < dimensionX; x++) {
+      int px = (int)xs[x];
+      int py = (int)ys[x];
+      // The Java code assumes that if the start and end points are in bounds, the rest will also be.
+      // However, in some unusual cases points in the middle may also be out of bounds.
+      if (px < -1 || px > width || py < -1 || py > height) {
+        ostringstream s;
+        s << "Transformed point out of bounds at " << px << "," << py;
+        throw ReaderException(s.str().c_str());
+      }
+      px = (px == -1) ? 0 : (px == width) ? width - 1 : px;
+      py = (py == -1) ? 0 : (py == height) ? height - 1 : py;
+      bool black = radius > 0 ? sampleMajority(source, px, py, radius) : source.get(px, py);
+      word |= (unsigned int)black << (x & 0x1f);
+      if ((x & 0x1f) == 0x1f || x == dimensionX - 1) {
+        bits->setBulk(x, y, (int)word);
+        word = 0;
       }
     }
   }
   return bits;
 }
 
+bool GridSampler::sampleMajority(BitMatrix const& image, int x, int y, int radius) {
+  int width = image.getWidth();
+  int height = image.getHeight();
+  int black = 0;
+  for (int dy = -radius; dy <= radius; dy += radius) {
+    int sy = std::min(std::max(y + dy, 0), height - 1);
+    for (int dx = -radius; dx <= radius; dx += radius) {
+      int sx = std::min(std::max(x + dx, 0), width - 1);
+      black += image.get(sx, sy);
+    }
+  }
+  return black >= 5;
+}
+
 Ref<BitMatrix> GridSampler::sampleGrid(Ref<BitMatrix> image, int dimension, float p1ToX, float p1ToY, float p2ToX,
                                        float p2ToY, float p3ToX, float p3ToY, float p4ToX, float p4ToY, float p1FromX, float p1FromY, float p2FromX,
                                        float p2FromY, float p3FromX, float p3FromY, float p4FromX, float p4FromY) {
@@ -26,13 +26,26 @@
 
 namespace zxing {
 class GridSampler {
+public:
+  enum Sampling {
+    // The pixel under the centre of each module
+    NEAREST,
+    // The majority of a 3x3 grid of pixels around the centre, spread over
+    // the middle of the module; slower, but copes better with blur
+    MAJORITY
+  };
+
 private:
   static GridSampler gridSampler;
   GridSampler();
 
+  static bool sampleMajority(BitMatrix const& image, int x, int y, int radius);
+
 public:
-  Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform);
-  Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimensionX, int dimensionY, Ref<PerspectiveTransform> transform);
+  Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform,
+                            Sampling sampling = NEAREST);
+  Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimensionX, int dimensionY, Ref<PerspectiveTransform> transform,
+                            Sampling sampling = NEAREST);
 
   Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimension, float p1ToX, float p1ToY, float p2ToX, float p2ToY,
                             float p3ToX, float p3ToY, float p4ToX, float p4ToY, float p1FromX, float p1FromY, float p2FromX,
@@ -71,7 +71,7 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
     ArrayRef<int> blackPoints =
       calculateBlackPoints(luminances, subWidth, subHeight, width, height);
 
-    Ref<BitMatrix> newMatrix (new BitMatrix(width, height));
+    Ref<BitMatrix> newMatrix (newBitMatrix(width, height));
     calculateThresholdForBlock(luminances,
                                subWidth,
                                subHeight,
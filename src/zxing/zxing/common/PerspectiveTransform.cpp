@@ -97,6 +97,24 @@ void PerspectiveTransform::transformPoints(vector<float> &points) {
   }
 }
 
+/**
+ * Transforms the centres of count cells of row y, (0.5, y) to (count - 0.5, y).
+ * Only x changes along the row, so the y terms are computed once and each
+ * point costs one division; the loop has no dependencies between points,
+ * which leaves it to the compiler to vectorise.
+ */
+void PerspectiveTransform::transformRow(float y, int count, float* xs, float* ys) const {
+  float rowX = a21 * y + a31;
+  float rowY = a22 * y + a32;
+  float rowDenominator = a23 * y + a33;
+  for (int i = 0; i < count; i++) {
+    float x = float(i) + 0.5f;
+    float scale = 1.0f / (a13 * x + rowDenominator);
+    xs[i] = (a11 * x + rowX) * scale;
+    ys[i] = (a12 * x + rowY) * scale;
+  }
+}
+
 ostream& operator<<(ostream& out, const PerspectiveTransform &pt) {
   out << pt.a11 << ", " << pt.a12 << ", " << pt.a13 << ", \n";
   out << pt.a21 << ", " << pt.a22 << ", " << pt.a23 << ", \n";
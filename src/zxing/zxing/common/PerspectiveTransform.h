@@ -41,6 +41,7 @@ public:
   Ref<PerspectiveTransform> buildAdjoint();
   Ref<PerspectiveTransform> times(Ref<PerspectiveTransform> other);
   void transformPoints(std::vector<float> &points);
+  void transformRow(float y, int count, float* xs, float* ys) const;
 
   friend std::ostream& operator<<(std::ostream& out, const PerspectiveTransform &pt);
 };
@@ -0,0 +1,419 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010-2011 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/TextDecoder.h>
+#include <zxing/common/StringUtils.h>
+#include <zxing/ReaderException.h>
+#include <cstring>
+#ifndef NO_ICONV
+#include <iconv.h>
+#endif
+
+// Required for compatibility. TODO : test on Symbian
+#ifdef ZXING_ICONV_CONST
+#undef ICONV_CONST
+#define ICONV_CONST const
+#endif
+
+#ifndef ICONV_CONST
+#define ICONV_CONST /**/
+#endif
+#include <qglobal.h>
+
+using std::string;
+using zxing::byte;
+using zxing::ReaderException;
+using zxing::common::TextDecoder;
+using zxing::common::StringUtils;
+
+namespace {
+
+struct CharsetName {
+  // Upper case, without '-' and '_'
+  char const* name;
+  TextDecoder::Charset charset;
+};
+
+CharsetName const CHARSET_NAMES[] = {
+  { "ASCII", TextDecoder::ASCII },
+  { "USASCII", TextDecoder::ASCII },
+  { "ISO88591", TextDecoder::ISO8859_1 },
+  { "LATIN1", TextDecoder::ISO8859_1 },
+  { "ISO88592", TextDecoder::ISO8859_2 },
+  { "ISO88593", TextDecoder::ISO8859_3 },
+  { "ISO88594", TextDecoder::ISO8859_4 },
+  { "ISO88595", TextDecoder::ISO8859_5 },
+  { "ISO88596", TextDecoder::ISO8859_6 },
+  { "ISO88597", TextDecoder::ISO8859_7 },
+  { "ISO88598", TextDecoder::ISO8859_8 },
+  { "ISO88599", TextDecoder::ISO8859_9 },
+  { "ISO885910", TextDecoder::ISO8859_10 },
+  { "ISO885911", TextDecoder::ISO8859_11 },
+  { "ISO885913", TextDecoder::ISO8859_13 },
+  { "ISO885914", TextDecoder::ISO8859_14 },
+  { "ISO885915", TextDecoder::ISO8859_15 },
+  { "ISO885916", TextDecoder::ISO8859_16 },
+  { "CP437", TextDecoder::CP437 },
+  { "IBM437", TextDecoder::CP437 },
+  { "CP1250", TextDecoder::CP1250 },
+  { "WINDOWS1250", TextDecoder::CP1250 },
+  { "CP1251", TextDecoder::CP1251 },
+  { "WINDOWS1251", TextDecoder::CP1251 },
+  { "CP1252", TextDecoder::CP1252 },
+  { "WINDOWS1252", TextDecoder::CP1252 },
+  { "CP1256", TextDecoder::CP1256 },
+  { "WINDOWS1256", TextDecoder::CP1256 },
+  { "SHIFTJIS", TextDecoder::SHIFT_JIS },
+  { "SJIS", TextDecoder::SHIFT_JIS },
+  { "GBK", TextDecoder::GBK },
+  { "GB2312", TextDecoder::GBK },
+  { "EUCCN", TextDecoder::GBK },
+  { "CP936", TextDecoder::GBK },
+  { "GB18030", TextDecoder::GB18030 },
+  { "UTF8", TextDecoder::UTF8 },
+  { "UTF16BE", TextDecoder::UTF16BE },
+  { "UNICODEBIGUNMARKED", TextDecoder::UTF16BE },
+  { "UNICODEBIG", TextDecoder::UTF16BE }
+};
+
+// Outcome of a built-in conversion
+enum Status {
+  CONVERTED,
+  INVALID,
+  UNSUPPORTED
+};
+
+int const SHIFT_JIS_TRAILS = 0xFD - 0x40;
+int const GBK_TRAILS = 0xFF - 0x40;
+
+void appendUtf8(string& result, unsigned int c) {
+  if (c < 0x80) {
+    result.push_back(char(c));
+  } else if (c < 0x800) {
+    result.push_back(char(0xC0 | (c >> 6)));
+    result.push_back(char(0x80 | (c & 0x3F)));
+  } else if (c < 0x10000) {
+    result.push_back(char(0xE0 | (c >> 12)));
+    result.push_back(char(0x80 | ((c >> 6) & 0x3F)));
+    result.push_back(char(0x80 | (c & 0x3F)));
+  } else {
+    result.push_back(char(0xF0 | (c >> 18)));
+    result.push_back(char(0x80 | ((c >> 12) & 0x3F)));
+    result.push_back(char(0x80 | ((c >> 6) & 0x3F)));
+    result.push_back(char(0x80 | (c & 0x3F)));
+  }
+}
+
+bool isUtf8(byte const* bytes, size_t length) {
+  for (size_t i = 0; i < length;) {
+    int lead = bytes[i++];
+    if (lead < 0x80) {
+      continue;
+    }
+    int trails;
+    int min = 0x80;
+    int max = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+      trails = 1;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      trails = 2;
+      // No overlong forms, no surrogates
+      if (lead == 0xE0) {
+        min = 0xA0;
+      } else if (lead == 0xED) {
+        max = 0x9F;
+      }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+      trails = 3;
+      if (lead == 0xF0) {
+        min = 0x90;
+      } else if (lead == 0xF4) {
+        max = 0x8F;
+      }
+    } else {
+      return false;
+    }
+    if (length - i < size_t(trails) || bytes[i] < min || bytes[i] > max) {
+      return false;
+    }
+    for (i++, trails--; trails > 0; i++, trails--) {
+      if ((bytes[i] & 0xC0) != 0x80) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Status appendSingleByte(string& result, byte const* bytes, size_t length,
+                        unsigned short const* upperHalf) {
+  for (size_t i = 0; i < length; i++) {
+    int b = bytes[i];
+    if (b < 0x80) {
+      result.push_back(char(b));
+    } else if (upperHalf == 0) {
+      appendUtf8(result, b);
+    } else if (upperHalf[b - 0x80] != 0) {
+      appendUtf8(result, upperHalf[b - 0x80]);
+    } else {
+      return INVALID;
+    }
+  }
+  return CONVERTED;
+}
+
+Status appendShiftJis(string& result, byte const* bytes, size_t length,
+                      unsigned short const* table) {
+  for (size_t i = 0; i < length; i++) {
+    int lead = bytes[i];
+    if (lead < 0x80) {
+      result.push_back(char(lead));
+      continue;
+    }
+    if (lead >= 0xA1 && lead <= 0xDF) {
+      // Half width katakana
+      appendUtf8(result, 0xFF61 + lead - 0xA1);
+      continue;
+    }
+    int row;
+    if (lead >= 0x81 && lead <= 0x9F) {
+      row = lead - 0x81;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+      row = lead - 0xE0 + 0x9F - 0x81 + 1;
+    } else {
+      return INVALID;
+    }
+    if (++i == length || bytes[i] < 0x40 || bytes[i] > 0xFC) {
+      return INVALID;
+    }
+    unsigned int c = table[row * SHIFT_JIS_TRAILS + bytes[i] - 0x40];
+    if (c == 0) {
+      return INVALID;
+    }
+    appendUtf8(result, c);
+  }
+  return CONVERTED;
+}
+
+/**
+ * GB18030 is GBK plus four byte sequences, which are left to iconv;
+ * so are the GBK holes that GB18030 fills. GBK (CP936) also has the euro
+ * sign as the single byte 0x80, GB18030 doesn't.
+ *
+ * GB2312 is decoded as GBK, its superset. Unlike iconv, that accepts the
+ * GBK-only characters (and 0x80) in GB2312 text instead of rejecting it,
+ * and gives the GBK mappings of A1A4 and A1AA (U+00B7 and U+2014 rather
+ * than U+30FB and U+2015).
+ */
+Status appendGbk(string& result, byte const* bytes, size_t length,
+                 unsigned short const* table, bool gb18030) {
+  Status missing = gb18030 ? UNSUPPORTED : INVALID;
+  for (size_t i = 0; i < length; i++) {
+    int lead = bytes[i];
+    if (lead < 0x80) {
+      result.push_back(char(lead));
+      continue;
+    }
+    if (lead == 0x80 && !gb18030) {
+      appendUtf8(result, 0x20AC);
+      continue;
+    }
+    if (lead == 0x80 || lead == 0xFF || ++i == length) {
+      return missing;
+    }
+    int trail = bytes[i];
+    if (trail < 0x40 || trail == 0xFF) {
+      return missing;
+    }
+    unsigned int c = table[(lead - 0x81) * GBK_TRAILS + trail - 0x40];
+    if (c == 0) {
+      return missing;
+    }
+    appendUtf8(result, c);
+  }
+  return CONVERTED;
+}
+
+Status appendUtf16be(string& result, byte const* bytes, size_t length) {
+  if (length % 2 != 0) {
+    return INVALID;
+  }
+  for (size_t i = 0; i < length; i += 2) {
+    unsigned int c = (bytes[i] << 8) | bytes[i + 1];
+    if (c >= 0xD800 && c < 0xDC00) {
+      if (i + 3 >= length) {
+        return INVALID;
+      }
+      unsigned int low = (bytes[i + 2] << 8) | bytes[i + 3];
+      if (low < 0xDC00 || low >= 0xE000) {
+        return INVALID;
+      }
+      c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+      i += 2;
+    } else if (c >= 0xDC00 && c < 0xE000) {
+      return INVALID;
+    }
+    appendUtf8(result, c);
+  }
+  return CONVERTED;
+}
+
+}
+
+TextDecoder::Charset TextDecoder::charsetForName(char const* name) {
+  if (name == 0) {
+    return UNKNOWN;
+  }
+  char normalized[32];
+  size_t length = 0;
+  for (; *name; name++) {
+    char c = *name;
+    if (c == '-' || c == '_') {
+      continue;
+    }
+    if (length + 1 == sizeof(normalized)) {
+      return UNKNOWN;
+    }
+    normalized[length++] = (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c;
+  }
+  normalized[length] = 0;
+  for (size_t i = 0; i < sizeof(CHARSET_NAMES) / sizeof(CHARSET_NAMES[0]); i++) {
+    if (strcmp(normalized, CHARSET_NAMES[i].name) == 0) {
+      return CHARSET_NAMES[i].charset;
+    }
+  }
+  return UNKNOWN;
+}
+
+bool TextDecoder::append(string& result, byte const* bytes, size_t length, Charset charset) {
+  size_t start = result.size();
+  Status status;
+  switch (charset) {
+  case UNKNOWN:
+    return false;
+  case ASCII:
+    status = CONVERTED;
+    for (size_t i = 0; i < length && status == CONVERTED; i++) {
+      if (bytes[i] >= 0x80) {
+        status = INVALID;
+      }
+    }
+    if (status == CONVERTED) {
+      result.append((char const*) bytes, length);
+    }
+    break;
+  case ISO8859_1:
+    status = appendSingleByte(result, bytes, length, 0);
+    break;
+  case SHIFT_JIS:
+    status = appendShiftJis(result, bytes, length, SHIFT_JIS_TABLE);
+    break;
+  case GBK:
+  case GB18030:
+    status = appendGbk(result, bytes, length, GBK_TABLE, charset == GB18030);
+    break;
+  case UTF8:
+    status = isUtf8(bytes, length) ? CONVERTED : INVALID;
+    if (status == CONVERTED) {
+      result.append((char const*) bytes, length);
+    }
+    break;
+  case UTF16BE:
+    status = appendUtf16be(result, bytes, length);
+    break;
+  default:
+    status = appendSingleByte(result, bytes, length,
+                              SINGLE_BYTE_TABLES + (charset - ISO8859_2) * 0x80);
+    break;
+  }
+  if (status != CONVERTED) {
+    result.resize(start);
+    if (status == INVALID) {
+      throw ReaderException("error converting characters");
+    }
+    return false;
+  }
+  return true;
+}
+
+void TextDecoder::append(string& result, byte const* bytes, size_t length, char const* charset) {
+  if (length == 0 || append(result, bytes, length, charsetForName(charset))) {
+    return;
+  }
+  appendIconv(result, bytes, length, charset);
+}
+
+string TextDecoder::appendGuessed(string& result, byte const* bytes, size_t length,
+                                  Hashtable const& hints) {
+  if (length > 0 && hints.find(DecodeHints::CHARACTER_SET) == hints.end()) {
+    size_t ascii = 0;
+    while (ascii < length && bytes[ascii] < 0x80) {
+      ascii++;
+    }
+    // guessEncoding() calls plain ASCII ISO-8859-1, and prefers UTF-8
+    // to anything else as soon as there is a multi-byte character
+    if (ascii == length) {
+      result.append((char const*) bytes, length);
+      return StringUtils::ISO88591;
+    }
+    if (isUtf8(bytes + ascii, length - ascii)) {
+      result.append((char const*) bytes, length);
+      return StringUtils::UTF8;
+    }
+  }
+  string encoding = StringUtils::guessEncoding((byte*) bytes, int(length), hints);
+  append(result, bytes, length, encoding.c_str());
+  return encoding;
+}
+
+void TextDecoder::appendIconv(string& result, byte const* bytes, size_t length, char const* charset) {
+#ifndef NO_ICONV
+  iconv_t cd = iconv_open(StringUtils::UTF8, charset);
+  if (cd == (iconv_t)-1) {
+    result.append((char const*) bytes, length);
+    return;
+  }
+
+  const int maxOut = 4 * length + 1;
+  char* bufOut = new char[maxOut];
+
+  ICONV_CONST char *fromPtr = (ICONV_CONST char *)bytes;
+  size_t nFrom = length;
+  char *toPtr = (char *)bufOut;
+  size_t nTo = maxOut;
+
+  while (nFrom > 0) {
+#if defined(Q_OS_SYMBIAN)
+    size_t oneway = iconv(cd, (const char**) &fromPtr, &nFrom, &toPtr, &nTo);
+#else
+    size_t oneway = iconv(cd, (char**) &fromPtr, &nFrom, &toPtr, &nTo);
+#endif
+    if (oneway == (size_t)(-1)) {
+      iconv_close(cd);
+      delete[] bufOut;
+      throw ReaderException("error converting characters");
+    }
+  }
+  iconv_close(cd);
+
+  result.append(bufOut, maxOut - nTo);
+  delete[] bufOut;
+#else
+  Q_UNUSED(charset);
+  result.append((char const*) bytes, length);
+#endif
+}
@@ -0,0 +1,110 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+
+#ifndef __TEXT_DECODER__
+#define __TEXT_DECODER__
+
+/*
+ * Copyright (C) 2010-2011 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <map>
+#include <zxing/DecodeHints.h>
+#include <zxing/common/Types.h>
+
+namespace zxing {
+namespace common {
+
+/**
+ * Converts decoded bytes to UTF-8. The character sets barcodes actually
+ * use are converted from built-in tables; anything else goes through
+ * iconv, unless the build has NO_ICONV.
+ */
+class TextDecoder {
+public:
+  enum Charset {
+    UNKNOWN,
+    ASCII,
+    ISO8859_1,
+    // Single byte code pages with a table in SINGLE_BYTE_TABLES
+    ISO8859_2,
+    ISO8859_3,
+    ISO8859_4,
+    ISO8859_5,
+    ISO8859_6,
+    ISO8859_7,
+    ISO8859_8,
+    ISO8859_9,
+    ISO8859_10,
+    ISO8859_11,
+    ISO8859_13,
+    ISO8859_14,
+    ISO8859_15,
+    ISO8859_16,
+    CP437,
+    CP1250,
+    CP1251,
+    CP1252,
+    CP1256,
+    SHIFT_JIS,
+    GBK,
+    GB18030,
+    UTF8,
+    UTF16BE
+  };
+
+  typedef std::map<DecodeHintType, std::string> Hashtable;
+
+  static Charset charsetForName(char const* name);
+
+  /**
+   * Appends length bytes in the given character set to result as UTF-8.
+   *
+   * @throws ReaderException if the bytes are not valid in that character set
+   */
+  static void append(std::string& result, byte const* bytes, size_t length, char const* charset);
+
+  /**
+   * Same as above, built-in converters only.
+   *
+   * @return false, leaving result as it was, if they do not cover charset
+   *         (or, for GB18030, these particular bytes)
+   */
+  static bool append(std::string& result, byte const* bytes, size_t length, Charset charset);
+
+  /**
+   * Appends bytes of unknown encoding to result as UTF-8. The encoding is
+   * guessed the way StringUtils::guessEncoding() does, but ASCII and UTF-8
+   * text, by far the most common, is recognised while it is copied.
+   *
+   * @return the name of the encoding used
+   */
+  static std::string appendGuessed(std::string& result, byte const* bytes, size_t length,
+                                   Hashtable const& hints);
+
+private:
+  static unsigned short const SINGLE_BYTE_TABLES[];
+  static unsigned short const SHIFT_JIS_TABLE[];
+  static unsigned short const GBK_TABLE[];
+
+  TextDecoder() {}
+
+  static void appendIconv(std::string& result, byte const* bytes, size_t length, char const* charset);
+};
+
+}
+}
+
+#endif
@@ -37,20 +37,14 @@ Ref<GenericGF> GenericGF::DATA_MATRIX_FIELD_256(new GenericGF(0x012D, 256, 1));
 Ref<GenericGF> GenericGF::AZTEC_DATA_8 = DATA_MATRIX_FIELD_256;
 Ref<GenericGF> GenericGF::MAXICODE_FIELD_64 = AZTEC_DATA_6;
   
-namespace {
-  int INITIALIZATION_THRESHOLD = 0;
-}
-  
 GenericGF::GenericGF(int primitive_, int size_, int b)
-  : size(size_), primitive(primitive_), generatorBase(b), initialized(false) {
-  if (size <= INITIALIZATION_THRESHOLD) {
-    initialize();
-  }
+  : size(size_), primitive(primitive_), generatorBase(b) {
+  initialize();
 }
   
 void GenericGF::initialize() {
-  expTable = std::vector<int>(size);
-  logTable = std::vector<int>(size);
+  expTable = std::vector<unsigned short>(2 * size);
+  logTable = std::vector<unsigned short>(size);
     
   int x = 1;
     
@@ -65,6 +59,10 @@ void GenericGF::initialize() {
   for (int i = 0; i < size-1; i++) {
     logTable[expTable[i]] = i;
   }
+  // alpha^(size-1) == 1, the rest of the table just repeats itself
+  for (int i = size - 1; i < 2 * size; i++) {
+    expTable[i] = expTable[i - (size - 1)];
+  }
   //logTable[0] == 0 but this should never be used
   ArrayRef<int> coefficients_zero(1);
   ArrayRef<int> coefficients_one(1);
@@ -74,28 +72,17 @@ void GenericGF::initialize() {
 
   zero = Ref<GenericGFPoly>(new GenericGFPoly(this, coefficients_zero));
   one = Ref<GenericGFPoly>(new GenericGFPoly(this, coefficients_one));
-  initialized = true;
-}
-  
-void GenericGF::checkInit() {
-  if (!initialized) {
-    initialize();
-  }
 }
   
 Ref<GenericGFPoly> GenericGF::getZero() {
-  checkInit();
   return zero;
 }
   
 Ref<GenericGFPoly> GenericGF::getOne() {
-  checkInit();
   return one;
 }
   
 Ref<GenericGFPoly> GenericGF::buildMonomial(int degree, int coefficient) {
-  checkInit();
-    
   if (degree < 0) {
     throw IllegalArgumentException("Degree must be non-negative");
   }
@@ -112,13 +99,7 @@ int GenericGF::addOrSubtract(int a, int b) {
   return a ^ b;
 }
   
-int GenericGF::exp(int a) {
-  checkInit();
-  return expTable[a];
-}
-  
 int GenericGF::log(int a) {
-  checkInit();
   if (a == 0) {
     throw IllegalArgumentException("cannot give log(0)");
   }
@@ -126,23 +107,12 @@ int GenericGF::log(int a) {
 }
   
 int GenericGF::inverse(int a) {
-  checkInit();
   if (a == 0) {
     throw IllegalArgumentException("Cannot calculate the inverse of 0");
   }
   return expTable[size - logTable[a] - 1];
 }
   
-int GenericGF::multiply(int a, int b) {
-  checkInit();
-    
-  if (a == 0 || b == 0) {
-    return 0;
-  }
-    
-  return expTable[(logTable[a] + logTable[b]) % (size - 1)];
-  }
-    
 int GenericGF::getSize() {
   return size;
 }
@@ -31,17 +31,18 @@ namespace zxing {
   class GenericGF : public Counted {
     
   private:
-    std::vector<int> expTable;
-    std::vector<int> logTable;
+    // Fields don't get bigger than 4096, so 16 bits are enough for either
+    // table. expTable is twice the size of the field so that the sum of
+    // two logarithms can be used as an index without reducing it first.
+    std::vector<unsigned short> expTable;
+    std::vector<unsigned short> logTable;
     Ref<GenericGFPoly> zero;
     Ref<GenericGFPoly> one;
     int size;
     int primitive;
     int generatorBase;
-    bool initialized;
     
     void initialize();
-    void checkInit();
     
   public:
     static Ref<GenericGF> AZTEC_DATA_12;
@@ -62,10 +63,17 @@ namespace zxing {
     Ref<GenericGFPoly> buildMonomial(int degree, int coefficient);
     
     static int addOrSubtract(int a, int b);
-    int exp(int a);
+    int exp(int a) {
+      return expTable[a];
+    }
     int log(int a);
     int inverse(int a);
-    int multiply(int a, int b);
+    int multiply(int a, int b) {
+      if (a == 0 || b == 0) {
+        return 0;
+      }
+      return expTable[logTable[a] + logTable[b]];
+    }
   };
 }
 
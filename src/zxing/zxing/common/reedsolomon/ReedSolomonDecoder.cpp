@@ -19,6 +19,7 @@
 #include <iostream>
 
 #include <memory>
+#include <algorithm>
 #include <zxing/common/reedsolomon/ReedSolomonDecoder.h>
 #include <zxing/common/reedsolomon/ReedSolomonException.h>
 #include <zxing/common/IllegalArgumentException.h>
@@ -28,7 +29,6 @@ using std::vector;
 using zxing::Ref;
 using zxing::ArrayRef;
 using zxing::ReedSolomonDecoder;
-using zxing::GenericGFPoly;
 using zxing::IllegalStateException;
 
 // VC++
@@ -39,13 +39,41 @@ ReedSolomonDecoder::ReedSolomonDecoder(Ref<GenericGF> field_) : field(field_) {}
 ReedSolomonDecoder::~ReedSolomonDecoder() {
 }
 
+void ReedSolomonDecoder::ensureCapacity(int twoS) {
+  if ((int)syndromes_.size() < twoS) {
+    syndromes_.resize(twoS);
+    sigma_.resize(twoS + 1);
+    omega_.resize(twoS + 1);
+    previous_.resize(twoS + 1);
+    temp_.resize(twoS + 1);
+    errorLocations_.resize(twoS);
+    errorMagnitudes_.resize(twoS);
+  }
+}
+
+int ReedSolomonDecoder::evaluateAt(int const* coefficients, int degree, int a) {
+  int result = coefficients[degree];
+  for (int i = degree - 1; i >= 0; i--) {
+    result = field->multiply(a, result) ^ coefficients[i];
+  }
+  return result;
+}
+
 void ReedSolomonDecoder::decode(ArrayRef<int> received, int twoS) {
-  Ref<GenericGFPoly> poly(new GenericGFPoly(field, received));
-  ArrayRef<int> syndromeCoefficients(twoS);
+  ensureCapacity(twoS);
+  int size = received->size();
+  vector<int> const& codewords = received->values();
+
+  // Syndrome i is the received polynomial evaluated at alpha^(i + generatorBase)
+  int* syndromes = &syndromes_[0];
   bool noError = true;
   for (int i = 0; i < twoS; i++) {
-    int eval = poly->evaluateAt(field->exp(i + field->getGeneratorBase()));
-    syndromeCoefficients[syndromeCoefficients->size() - 1 - i] = eval;
+    int alpha = field->exp(i + field->getGeneratorBase());
+    int eval = 0;
+    for (int j = 0; j < size; j++) {
+      eval = field->multiply(alpha, eval) ^ codewords[j];
+    }
+    syndromes[i] = eval;
     if (eval != 0) {
       noError = false;
     }
@@ -53,122 +81,142 @@ void ReedSolomonDecoder::decode(ArrayRef<int> received, int twoS) {
   if (noError) {
     return;
   }
-  Ref<GenericGFPoly> syndrome(new GenericGFPoly(field, syndromeCoefficients));
-  vector<Ref<GenericGFPoly> > sigmaOmega =
-    runEuclideanAlgorithm(field->buildMonomial(twoS, 1), syndrome, twoS);
-  Ref<GenericGFPoly> sigma = sigmaOmega[0];
-  Ref<GenericGFPoly> omega = sigmaOmega[1];
-  ArrayRef<int> errorLocations = findErrorLocations(sigma);
-  ArrayRef<int> errorMagitudes = findErrorMagnitudes(omega, errorLocations);
-  for (int i = 0; i < errorLocations->size(); i++) {
-    int position = received->size() - 1 - field->log(errorLocations[i]);
+
+  int numErrors = runBerlekampMassey(twoS);
+  findErrorLocations(numErrors, size);
+  findErrorMagnitudes(numErrors);
+  for (int i = 0; i < numErrors; i++) {
+    int position = size - 1 - field->log(errorLocations_[i]);
     if (position < 0) {
       throw ReedSolomonException("Bad error location");
     }
-    received[position] = GenericGF::addOrSubtract(received[position], errorMagitudes[i]);
+    received[position] = GenericGF::addOrSubtract(received[position], errorMagnitudes_[i]);
   }
 }
 
-vector<Ref<GenericGFPoly> > ReedSolomonDecoder::runEuclideanAlgorithm(Ref<GenericGFPoly> a,
-                                                                      Ref<GenericGFPoly> b,
-                                                                      int R) {
-  // Assume a's degree is >= b's
-  if (a->getDegree() < b->getDegree()) {
-    Ref<GenericGFPoly> tmp = a;
-    a = b;
-    b = tmp;
+int ReedSolomonDecoder::runBerlekampMassey(int twoS) {
+  // Finds the shortest error locator sigma, with sigma(0) == 1, that
+  // generates the syndrome sequence
+  int const* syndromes = &syndromes_[0];
+  int* sigma = &sigma_[0];
+  int* previous = &previous_[0];
+  int* temp = &temp_[0];
+  for (int i = 0; i <= twoS; i++) {
+    sigma[i] = 0;
+    previous[i] = 0;
   }
-
-  Ref<GenericGFPoly> rLast(a);
-  Ref<GenericGFPoly> r(b);
-  Ref<GenericGFPoly> tLast(field->getZero());
-  Ref<GenericGFPoly> t(field->getOne());
-
-  // Run Euclidean algorithm until r's degree is less than R/2
-  while (r->getDegree() >= R / 2) {
-    Ref<GenericGFPoly> rLastLast(rLast);
-    Ref<GenericGFPoly> tLastLast(tLast);
-    rLast = r;
-    tLast = t;
-
-    // Divide rLastLast by rLast, with quotient q and remainder r
-    if (rLast->isZero()) {
-      // Oops, Euclidean algorithm already terminated?
-      throw ReedSolomonException("r_{i-1} was zero");
+  sigma[0] = 1;
+  previous[0] = 1;
+  int numErrors = 0;
+  int previousDiscrepancy = 1;
+  int shift = 1;
+
+  for (int n = 0; n < twoS; n++) {
+    int discrepancy = syndromes[n];
+    for (int i = 1; i <= numErrors; i++) {
+      discrepancy ^= field->multiply(sigma[i], syndromes[n - i]);
     }
-    r = rLastLast;
-    Ref<GenericGFPoly> q = field->getZero();
-    int denominatorLeadingTerm = rLast->getCoefficient(rLast->getDegree());
-    int dltInverse = field->inverse(denominatorLeadingTerm);
-    while (r->getDegree() >= rLast->getDegree() && !r->isZero()) {
-      int degreeDiff = r->getDegree() - rLast->getDegree();
-      int scale = field->multiply(r->getCoefficient(r->getDegree()), dltInverse);
-      q = q->addOrSubtract(field->buildMonomial(degreeDiff, scale));
-      r = r->addOrSubtract(rLast->multiplyByMonomial(degreeDiff, scale));
+    if (discrepancy == 0) {
+      shift++;
+      continue;
     }
-
-    t = q->multiply(tLast)->addOrSubtract(tLastLast);
-
-    if (r->getDegree() >= rLast->getDegree()) {
-      throw IllegalStateException("Division algorithm failed to reduce polynomial?");
+    // sigma -= discrepancy / previousDiscrepancy * x^shift * previous
+    int scale = field->multiply(discrepancy, field->inverse(previousDiscrepancy));
+    if (2 * numErrors <= n) {
+      for (int i = 0; i <= numErrors; i++) {
+        temp[i] = sigma[i];
+      }
+      for (int i = 0; i + shift <= twoS; i++) {
+        sigma[i + shift] ^= field->multiply(scale, previous[i]);
+      }
+      std::swap(previous, temp);
+      for (int i = numErrors + 1; i <= twoS; i++) {
+        previous[i] = 0;
+      }
+      numErrors = n + 1 - numErrors;
+      previousDiscrepancy = discrepancy;
+      shift = 1;
+    } else {
+      for (int i = 0; i + shift <= twoS; i++) {
+        sigma[i + shift] ^= field->multiply(scale, previous[i]);
+      }
+      shift++;
     }
   }
 
-  int sigmaTildeAtZero = t->getCoefficient(0);
-  if (sigmaTildeAtZero == 0) {
-    throw ReedSolomonException("sigmaTilde(0) was zero");
+  if (2 * numErrors > twoS) {
+    throw ReedSolomonException("Too many errors");
+  }
+  for (int i = numErrors + 1; i <= twoS; i++) {
+    if (sigma[i] != 0) {
+      throw ReedSolomonException("Error locator degree does not match number of errors");
+    }
   }
 
-  int inverse = field->inverse(sigmaTildeAtZero);
-  Ref<GenericGFPoly> sigma(t->multiply(inverse));
-  Ref<GenericGFPoly> omega(r->multiply(inverse));
-  vector<Ref<GenericGFPoly> > result(2);
-  result[0] = sigma;
-  result[1] = omega;
-  return result;
+  // The error evaluator is syndromes * sigma mod x^twoS, of which only
+  // the terms below numErrors can be non-zero
+  int* omega = &omega_[0];
+  for (int i = 0; i < numErrors; i++) {
+    int term = 0;
+    for (int j = 0; j <= i; j++) {
+      term ^= field->multiply(syndromes[i - j], sigma[j]);
+    }
+    omega[i] = term;
+  }
+  return numErrors;
 }
 
-ArrayRef<int> ReedSolomonDecoder::findErrorLocations(Ref<GenericGFPoly> errorLocator) {
-  // This is a direct application of Chien's search
-  int numErrors = errorLocator->getDegree();
+void ReedSolomonDecoder::findErrorLocations(int numErrors, int size) {
+  int const* errorLocator = &sigma_[0];
   if (numErrors == 1) { // shortcut
-    ArrayRef<int> result(new Array<int>(1));
-    result[0] = errorLocator->getCoefficient(1);
-    return result;
+    errorLocations_[0] = errorLocator[1];
+    return;
+  }
+  // Chien's search, only over the positions that exist in a codeword of
+  // this size. Term i of the locator is kept multiplied by alpha^(-i*j),
+  // so moving on to the next position costs one multiplication per term.
+  int* terms = &temp_[0];
+  int* steps = &previous_[0];
+  int order = field->getSize() - 1;
+  for (int i = 1; i <= numErrors; i++) {
+    terms[i] = errorLocator[i];
+    steps[i] = field->exp(order - i % order);
   }
-  ArrayRef<int> result(new Array<int>(numErrors));
   int e = 0;
-  for (int i = 1; i < field->getSize() && e < numErrors; i++) {
-    if (errorLocator->evaluateAt(i) == 0) {
-      result[e] = field->inverse(i);
+  for (int j = 0; j < size && e < numErrors; j++) {
+    // Evaluate at alpha^(-j), the inverse of the locator of codeword size-1-j
+    int eval = 1;
+    for (int i = 1; i <= numErrors; i++) {
+      eval ^= terms[i];
+      terms[i] = field->multiply(terms[i], steps[i]);
+    }
+    if (eval == 0) {
+      errorLocations_[e] = field->exp(j % order);
       e++;
     }
   }
   if (e != numErrors) {
     throw ReedSolomonException("Error locator degree does not match number of roots");
   }
-  return result;
 }
 
-ArrayRef<int> ReedSolomonDecoder::findErrorMagnitudes(Ref<GenericGFPoly> errorEvaluator, ArrayRef<int> errorLocations) {
+void ReedSolomonDecoder::findErrorMagnitudes(int numErrors) {
   // This is directly applying Forney's Formula
-  int s = errorLocations->size();
-  ArrayRef<int> result(new Array<int>(s));
-  for (int i = 0; i < s; i++) {
-    int xiInverse = field->inverse(errorLocations[i]);
+  int const* errorEvaluator = &omega_[0];
+  for (int i = 0; i < numErrors; i++) {
+    int xiInverse = field->inverse(errorLocations_[i]);
     int denominator = 1;
-    for (int j = 0; j < s; j++) {
+    for (int j = 0; j < numErrors; j++) {
       if (i != j) {
-        int term = field->multiply(errorLocations[j], xiInverse);
+        int term = field->multiply(errorLocations_[j], xiInverse);
         int termPlus1 = (term & 0x1) == 0 ? term | 1 : term & ~1;
         denominator = field->multiply(denominator, termPlus1);
       }
     }
-    result[i] = field->multiply(errorEvaluator->evaluateAt(xiInverse),
-                                field->inverse(denominator));
+    errorMagnitudes_[i] = field->multiply(evaluateAt(errorEvaluator, numErrors - 1, xiInverse),
+                                          field->inverse(denominator));
     if (field->getGeneratorBase() != 0) {
-      result[i] = field->multiply(result[i], xiInverse);
+      errorMagnitudes_[i] = field->multiply(errorMagnitudes_[i], xiInverse);
     }
   }
-  return result;
 }
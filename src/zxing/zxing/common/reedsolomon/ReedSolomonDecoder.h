@@ -24,25 +24,37 @@
 #include <vector>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
-#include <zxing/common/reedsolomon/GenericGFPoly.h>
 #include <zxing/common/reedsolomon/GenericGF.h>
 
 namespace zxing {
-class GenericGFPoly;
 class GenericGF;
 
 class ReedSolomonDecoder {
 private:
   Ref<GenericGF> field;
+
+  // Scratch space, grown on demand and reused by subsequent decode() calls.
+  // Polynomials are stored lowest degree coefficient first, with all
+  // coefficients above the degree being zero.
+  std::vector<int> syndromes_;
+  std::vector<int> sigma_;
+  std::vector<int> omega_;
+  std::vector<int> previous_;
+  std::vector<int> temp_;
+  std::vector<int> errorLocations_;
+  std::vector<int> errorMagnitudes_;
+
 public:
   ReedSolomonDecoder(Ref<GenericGF> fld);
   ~ReedSolomonDecoder();
   void decode(ArrayRef<int> received, int twoS);
-  std::vector<Ref<GenericGFPoly> > runEuclideanAlgorithm(Ref<GenericGFPoly> a, Ref<GenericGFPoly> b, int R);
 
 private:
-  ArrayRef<int> findErrorLocations(Ref<GenericGFPoly> errorLocator);
-  ArrayRef<int> findErrorMagnitudes(Ref<GenericGFPoly> errorEvaluator, ArrayRef<int> errorLocations);
+  void ensureCapacity(int twoS);
+  int evaluateAt(int const* coefficients, int degree, int a);
+  int runBerlekampMassey(int twoS);
+  void findErrorLocations(int numErrors, int size);
+  void findErrorMagnitudes(int numErrors);
 };
 }
 
@@ -29,18 +29,42 @@ namespace datamatrix {
 using namespace std;
 
 DataMatrixReader::DataMatrixReader() :
-    decoder_() {
+    decoder_(), tracked_(false) {
 }
 
-Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
   (void)hints;
   Detector detector(image->getBlackMatrix());
-  Ref<DetectorResult> detectorResult(detector.detect());
+  Ref<DetectorResult> detectorResult;
+  Ref<DecoderResult> decoderResult;
+  tracked_ = false;
+  if (lastDetection_ != 0) {
+    try {
+      detectorResult = detector.track(lastDetection_);
+    } catch (Exception const& e) {
+      (void)e;
+      // The symbol has moved, changed or gone
+      lastDetection_.reset(0);
+    }
+    if (detectorResult != 0) {
+      try {
+        decoderResult = decoder_.decode(detectorResult->getBits());
+        tracked_ = true;
+      } catch (Exception const& e) {
+        (void)e;
+        // fall back to the full search
+      }
+    }
+  }
+  if (decoderResult == 0) {
+    detectorResult = detector.detect();
+    // Even if decoding fails, the next frame is likely to show the
+    // symbol at about the same place
+    lastDetection_ = detectorResult;
+    decoderResult = decoder_.decode(detectorResult->getBits());
+  }
   ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
 
-
-  Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
-
   Ref<Result> result(
     new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat::DATA_MATRIX));
 
@@ -50,5 +74,9 @@ Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints hints)
 DataMatrixReader::~DataMatrixReader() {
 }
 
+bool DataMatrixReader::wasTracked() const {
+  return tracked_;
+}
+
 }
 }
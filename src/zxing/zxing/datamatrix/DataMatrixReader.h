@@ -23,6 +23,7 @@
 
 #include <zxing/Reader.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/common/DetectorResult.h>
 #include <zxing/datamatrix/decoder/Decoder.h>
 
 namespace zxing {
@@ -32,9 +33,17 @@ class DataMatrixReader : public Reader {
 private:
   Decoder decoder_;
 
+  // The symbol detected in the previous frame, whether it decoded or not.
+  // When decoding a sequence of frames, it is checked before searching
+  // the whole image again, until it fails the checks.
+  Ref<DetectorResult> lastDetection_;
+  // Whether the last decode() decoded the symbol found by track()
+  bool tracked_;
+
 public:
   DataMatrixReader();
-  virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
+  virtual bool wasTracked() const;
   virtual ~DataMatrixReader();
 
 };
@@ -64,6 +64,84 @@ ECBlocks::~ECBlocks() {
 vector<Ref<Version> > Version::VERSIONS;
 static int N_VERSIONS = Version::buildVersions();
 
+namespace {
+
+// Bits of a codeword, most significant first, as offsets from the module at
+// the bottom right of the regular "utah" shape
+const int UTAH_SHAPE[8][2] = {
+  {-2, -2}, {-2, -1}, {-1, -2}, {-1, -1}, {-1, 0}, {0, -2}, {0, -1}, {0, 0}
+};
+
+// Bits of the four special corner codewords, most significant first. Negative
+// rows and columns count back from the bottom and right of the mapping matrix.
+const int CORNER_SHAPES[4][8][2] = {
+  {{-1, 0}, {-1, 1}, {-1, 2}, {0, -2}, {0, -1}, {1, -1}, {2, -1}, {3, -1}},
+  {{-3, 0}, {-2, 0}, {-1, 0}, {0, -4}, {0, -3}, {0, -2}, {0, -1}, {1, -1}},
+  {{-1, 0}, {-1, -1}, {0, -3}, {0, -2}, {0, -1}, {1, -3}, {1, -2}, {1, -1}},
+  {{-3, 0}, {-2, 0}, {-1, 0}, {0, -2}, {0, -1}, {1, -1}, {2, -1}, {3, -1}}
+};
+
+/**
+ * Replays the ECC200 module placement (ISO 16022:2006 Annex F) over the
+ * mapping matrix, recording where each bit lives in the full symbol.
+ */
+class PlacementBuilder {
+private:
+  int numRows_;
+  int numColumns_;
+  int dataRegionSizeRows_;
+  int dataRegionSizeColumns_;
+  vector<bool> placed_;
+  vector<unsigned short>& placement_;
+
+public:
+  PlacementBuilder(int numRows, int numColumns, int dataRegionSizeRows,
+                   int dataRegionSizeColumns, vector<unsigned short>& placement) :
+      numRows_(numRows), numColumns_(numColumns), dataRegionSizeRows_(dataRegionSizeRows),
+      dataRegionSizeColumns_(dataRegionSizeColumns), placed_(numRows * numColumns, false),
+      placement_(placement) {
+  }
+
+  bool isPlaced(int row, int column) {
+    return placed_[row * numColumns_ + column];
+  }
+
+  void placeModule(int row, int column) {
+    // Adjust the row and column indices based on boundary wrapping
+    if (row < 0) {
+      row += numRows_;
+      column += 4 - ((numRows_ + 4) & 0x07);
+    }
+    if (column < 0) {
+      column += numColumns_;
+      row += 4 - ((numColumns_ + 4) & 0x07);
+    }
+    placed_[row * numColumns_ + column] = true;
+    // Skip the alignment patterns between data regions
+    int symbolRow = row / dataRegionSizeRows_ * (dataRegionSizeRows_ + 2) + 1 +
+        row % dataRegionSizeRows_;
+    int symbolColumn = column / dataRegionSizeColumns_ * (dataRegionSizeColumns_ + 2) + 1 +
+        column % dataRegionSizeColumns_;
+    placement_.push_back((unsigned short)((symbolRow << 8) | symbolColumn));
+  }
+
+  void placeUtah(int row, int column) {
+    for (int i = 0; i < 8; i++) {
+      placeModule(row + UTAH_SHAPE[i][0], column + UTAH_SHAPE[i][1]);
+    }
+  }
+
+  void placeCorner(int corner) {
+    for (int i = 0; i < 8; i++) {
+      int row = CORNER_SHAPES[corner][i][0];
+      int column = CORNER_SHAPES[corner][i][1];
+      placeModule(row < 0 ? numRows_ + row : row, column < 0 ? numColumns_ + column : column);
+    }
+  }
+};
+
+}
+
 Version::Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
 		int dataRegionSizeColumns, ECBlocks* ecBlocks) : versionNumber_(versionNumber), 
 		symbolSizeRows_(symbolSizeRows), symbolSizeColumns_(symbolSizeColumns), 
@@ -78,6 +156,7 @@ Version::Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, i
       total += ecBlock->getCount() * (ecBlock->getDataCodewords() + ecCodewords);
     }
     totalCodewords_ = total;
+    buildCodewordPlacement();
 }
 
 Version::~Version() {
@@ -111,6 +190,72 @@ int Version::getTotalCodewords() {
 ECBlocks* Version::getECBlocks() {
   return ecBlocks_;
 }
+
+std::vector<unsigned short> const& Version::getCodewordPlacement() {
+  return codewordPlacement_;
+}
+
+void Version::buildCodewordPlacement() {
+  int numRows = symbolSizeRows_ / dataRegionSizeRows_ * dataRegionSizeRows_;
+  int numColumns = symbolSizeColumns_ / dataRegionSizeColumns_ * dataRegionSizeColumns_;
+  codewordPlacement_.reserve(totalCodewords_ * 8);
+  PlacementBuilder builder(numRows, numColumns, dataRegionSizeRows_, dataRegionSizeColumns_,
+                           codewordPlacement_);
+
+  int row = 4;
+  int column = 0;
+  bool corner1Placed = false;
+  bool corner2Placed = false;
+  bool corner3Placed = false;
+  bool corner4Placed = false;
+
+  do {
+    // Check the four corner cases
+    if ((row == numRows) && (column == 0) && !corner1Placed) {
+      builder.placeCorner(0);
+      row -= 2;
+      column += 2;
+      corner1Placed = true;
+    } else if ((row == numRows-2) && (column == 0) && ((numColumns & 0x03) != 0) && !corner2Placed) {
+      builder.placeCorner(1);
+      row -= 2;
+      column += 2;
+      corner2Placed = true;
+    } else if ((row == numRows+4) && (column == 2) && ((numColumns & 0x07) == 0) && !corner3Placed) {
+      builder.placeCorner(2);
+      row -= 2;
+      column += 2;
+      corner3Placed = true;
+    } else if ((row == numRows-2) && (column == 0) && ((numColumns & 0x07) == 4) && !corner4Placed) {
+      builder.placeCorner(3);
+      row -= 2;
+      column += 2;
+      corner4Placed = true;
+    } else {
+      // Sweep upward diagonally to the right
+      do {
+        if ((row < numRows) && (column >= 0) && !builder.isPlaced(row, column)) {
+          builder.placeUtah(row, column);
+        }
+        row -= 2;
+        column += 2;
+      } while ((row >= 0) && (column < numColumns));
+      row += 1;
+      column += 3;
+
+      // Sweep downward diagonally to the left
+      do {
+        if ((row >= 0) && (column < numColumns) && !builder.isPlaced(row, column)) {
+          builder.placeUtah(row, column);
+        }
+        row += 2;
+        column -= 2;
+      } while ((row < numRows) && (column >= 0));
+      row += 3;
+      column += 1;
+    }
+  } while ((row < numRows) || (column < numColumns));
+}
   
 Ref<Version> Version::getVersionForDimensions(int numRows, int numColumns) {
     if ((numRows & 0x01) != 0 || (numColumns & 0x01) != 0) {
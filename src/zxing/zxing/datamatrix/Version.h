@@ -60,6 +60,7 @@ private:
   int dataRegionSizeColumns_;
   ECBlocks* ecBlocks_;
   int totalCodewords_;
+  std::vector<unsigned short> codewordPlacement_;
   Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
 		  int dataRegionSizeColumns, ECBlocks *ecBlocks);
 
@@ -74,10 +75,17 @@ public:
   int getDataRegionSizeColumns();
   int getTotalCodewords();
   ECBlocks* getECBlocks();
+  /**
+   * The symbol module holding each codeword bit, most significant bit of
+   * codeword 0 first. Each entry is (row << 8) | column in the full symbol,
+   * alignment patterns included.
+   */
+  std::vector<unsigned short> const& getCodewordPlacement();
   static int  buildVersions();  
   Ref<Version> getVersionForDimensions(int numRows, int numColumns);
   
 private:
+  void buildCodewordPlacement();
   Version(const Version&);
   Version & operator=(const Version&);
 };
@@ -34,7 +34,6 @@ class BitMatrixParser : public Counted {
 private:
   Ref<BitMatrix> bitMatrix_;
   Ref<Version> parsedVersion_;
-  Ref<BitMatrix> readBitMatrix_;
 
   int copyBit(size_t x, size_t y, int versionBits);
 
@@ -42,15 +41,6 @@ public:
   BitMatrixParser(Ref<BitMatrix> bitMatrix);
   Ref<Version> readVersion(Ref<BitMatrix> bitMatrix);
   ArrayRef<byte> readCodewords();
-  bool readModule(int row, int column, int numRows, int numColumns);
-
-private:
-  int readUtah(int row, int column, int numRows, int numColumns);
-  int readCorner1(int numRows, int numColumns);
-  int readCorner2(int numRows, int numColumns);
-  int readCorner3(int numRows, int numColumns);
-  int readCorner4(int numRows, int numColumns);
-  Ref<BitMatrix> extractDataRegion(Ref<BitMatrix> bitMatrix);
 };
 
 }
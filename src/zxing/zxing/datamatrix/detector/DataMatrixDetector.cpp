@@ -46,8 +46,28 @@ namespace {
     int& value = table[key];
     value += 1;
   }
+
+  int bitCount(unsigned int i) {
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_popcount(i);
+#else
+    int n = 0;
+    for (; i != 0; i &= i - 1) {
+      n++;
+    }
+    return n;
+#endif
+  }
 }
 
+// Transitions a solid side of the L may show when the symbol is tracked
+// from the previous frame; module edges are rarely exactly on the line
+int Detector::MAX_TRACKING_TRANSITIONS = 2;
+
+// Shortest run along one image row for which transitionsBetween() counts
+// whole words rather than single pixels
+int Detector::MIN_RUN_LENGTH = 8;
+
 ResultPointsAndTransitions::ResultPointsAndTransitions() {
   Ref<ResultPoint> ref(new ResultPoint(0, 0));
   from_ = ref;
@@ -255,6 +275,45 @@ Ref<DetectorResult> Detector::detect() {
   return detectorResult;
 }
 
+Ref<DetectorResult> Detector::track(Ref<DetectorResult> previous) {
+  ArrayRef< Ref<ResultPoint> > points(previous->getPoints());
+  Ref<ResultPoint> topLeft(points[0]);
+  Ref<ResultPoint> bottomLeft(points[1]);
+  Ref<ResultPoint> topRight(points[2]);
+  Ref<ResultPoint> bottomRight(points[3]);
+  if (!isValid(topLeft) || !isValid(bottomLeft) || !isValid(topRight) || !isValid(bottomRight)) {
+    throw NotFoundException("Tracked symbol is outside of the image");
+  }
+
+  // The two sides of the L must still be solid...
+  if (transitionsBetween(topLeft, bottomLeft)->getTransitions() > MAX_TRACKING_TRANSITIONS ||
+      transitionsBetween(bottomLeft, bottomRight)->getTransitions() > MAX_TRACKING_TRANSITIONS) {
+    throw NotFoundException("Tracked symbol has moved");
+  }
+
+  // ...and the other two must still count the same number of modules,
+  // worked out the same way as detect() does
+  int dimensionX = previous->getBits()->getWidth();
+  int dimensionY = previous->getBits()->getHeight();
+  int dimensionTop = transitionsBetween(topLeft, topRight)->getTransitions();
+  int dimensionRight = transitionsBetween(bottomRight, topRight)->getTransitions();
+  if (dimensionX == dimensionY) {
+    dimensionTop = std::max(dimensionTop, dimensionRight) + 1;
+    dimensionRight = dimensionTop;
+  }
+  dimensionTop += dimensionTop & 0x01;
+  dimensionRight += dimensionRight & 0x01;
+  if (dimensionTop != dimensionX || dimensionRight != dimensionY) {
+    throw NotFoundException("Tracked symbol has changed");
+  }
+
+  Ref<PerspectiveTransform> transform = createTransform(topLeft, topRight, bottomLeft, bottomRight,
+                                                        dimensionX, dimensionY);
+  Ref<BitMatrix> bits = sampleGrid(image_, dimensionX, dimensionY, transform);
+  Ref<DetectorResult> detectorResult(new DetectorResult(bits, points));
+  return detectorResult;
+}
+
 /**
  * Calculates the position of the white top right module using the output of the rectangle detector
  * for a rectangular matrix
@@ -374,25 +433,74 @@ Ref<ResultPointsAndTransitions> Detector::transitionsBetween(Ref<ResultPoint> fr
   int xstep = fromX < toX ? 1 : -1;
   int transitions = 0;
   bool inBlack = image_->get(steep ? fromY : fromX, steep ? fromX : fromY);
-  for (int x = fromX, y = fromY; x != toX; x += xstep) {
-    bool isBlack = image_->get(steep ? y : x, steep ? x : y);
-    if (isBlack != inBlack) {
-      transitions++;
-      inBlack = isBlack;
+  if (!steep && dy * MIN_RUN_LENGTH <= dx) {
+    // A nearly horizontal line stays on one image row for at least
+    // MIN_RUN_LENGTH pixels at a time; count each such run a word at a time
+    int x = fromX;
+    int y = fromY;
+    while (x != toX) {
+      int length = abs(toX - x);
+      bool stepY = false;
+      if (dy > 0 && (-error) / dy + 1 <= length) {
+        length = (-error) / dy + 1;
+        stepY = true;
+      }
+      int last = x + (length - 1) * xstep;
+      if (image_->get(x, y) != inBlack) {
+        transitions++;
+      }
+      transitions += xstep > 0 ? rowTransitions(y, x, last) : rowTransitions(y, last, x);
+      inBlack = image_->get(last, y);
+      x = last + xstep;
+      error += length * dy;
+      if (stepY) {
+        if (y == toY) {
+          break;
+        }
+        y += ystep;
+        error -= dx;
+      }
     }
-    error += dy;
-    if (error > 0) {
-      if (y == toY) {
-        break;
+  } else {
+    for (int x = fromX, y = fromY; x != toX; x += xstep) {
+      bool isBlack = image_->get(steep ? y : x, steep ? x : y);
+      if (isBlack != inBlack) {
+        transitions++;
+        inBlack = isBlack;
+      }
+      error += dy;
+      if (error > 0) {
+        if (y == toY) {
+          break;
+        }
+        y += ystep;
+        error -= dx;
       }
-      y += ystep;
-      error -= dx;
     }
   }
   Ref<ResultPointsAndTransitions> result(new ResultPointsAndTransitions(from, to, transitions));
   return result;
 }
 
+/**
+ * Counts the pixels in [from, to) of row y that differ from their right
+ * hand neighbour, 31 pixels at a time.
+ */
+int Detector::rowTransitions(int y, int from, int to) {
+  int lastWord = (image_->getWidth() - 1) >> 5;
+  int transitions = 0;
+  for (int x = from; x < to; x += 31) {
+    int count = min(31, to - x);
+    int shift = x & 0x1f;
+    unsigned int bits = ((unsigned int) image_->getBulk(x, y)) >> shift;
+    if (shift != 0 && (x >> 5) < lastWord) {
+      bits |= ((unsigned int) image_->getBulk(x + 32, y)) << (32 - shift);
+    }
+    transitions += bitCount((bits ^ (bits >> 1)) & ((1u << count) - 1));
+  }
+  return transitions;
+}
+
 Ref<PerspectiveTransform> Detector::createTransform(Ref<ResultPoint> topLeft,
                                                     Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft, Ref<ResultPoint> bottomRight,
                                                     int dimensionX, int dimensionY) {
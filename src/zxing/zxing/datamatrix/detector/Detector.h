@@ -47,6 +47,9 @@ class ResultPointsAndTransitions: public Counted {
 
 class Detector: public Counted {
   private:
+    static int MAX_TRACKING_TRANSITIONS;
+    static int MIN_RUN_LENGTH;
+
     Ref<BitMatrix> image_;
 
   protected:
@@ -63,6 +66,7 @@ class Detector: public Counted {
     bool isValid(Ref<ResultPoint> p);
     int distance(Ref<ResultPoint> a, Ref<ResultPoint> b);
     Ref<ResultPointsAndTransitions> transitionsBetween(Ref<ResultPoint> from, Ref<ResultPoint> to);
+    int rowTransitions(int y, int from, int to);
     int min(int a, int b) {
       return a > b ? b : a;
     }
@@ -84,6 +88,15 @@ class Detector: public Counted {
 
     Ref<DetectorResult> detect();
 
+    /**
+     * Checks that the symbol found in a previous frame is still where it
+     * was, with the same dimensions, and samples it again without running
+     * the rectangle search.
+     *
+     * @throws NotFoundException if the previous location no longer fits
+     */
+    Ref<DetectorResult> track(Ref<DetectorResult> previous);
+
   private:
     int compare(Ref<ResultPointsAndTransitions> a, Ref<ResultPointsAndTransitions> b);
 };
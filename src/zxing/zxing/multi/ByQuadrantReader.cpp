@@ -28,7 +28,7 @@ Ref<Result> ByQuadrantReader::decode(Ref<BinaryBitmap> image){
   return decode(image, DecodeHints::DEFAULT_HINT);
 }
 
-Ref<Result> ByQuadrantReader::decode(Ref<BinaryBitmap> image, DecodeHints hints){
+Ref<Result> ByQuadrantReader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints){
   int width = image->getWidth();
   int height = image->getHeight();
   int halfWidth = width / 2;
@@ -33,7 +33,7 @@ class ByQuadrantReader : public Reader {
     ByQuadrantReader(Reader& delegate);
     virtual ~ByQuadrantReader();
     virtual Ref<Result> decode(Ref<BinaryBitmap> image);
-    virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+    virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
 };
 
 }
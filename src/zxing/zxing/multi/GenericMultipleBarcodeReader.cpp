@@ -35,7 +35,7 @@ GenericMultipleBarcodeReader::GenericMultipleBarcodeReader(Reader& delegate)
 GenericMultipleBarcodeReader::~GenericMultipleBarcodeReader(){}
 
 vector<Ref<Result> > GenericMultipleBarcodeReader::decodeMultiple(Ref<BinaryBitmap> image,
-                                                                  DecodeHints hints) {
+                                                                  DecodeHints const& hints) {
   vector<Ref<Result> > results;
   doDecodeMultiple(image, hints, results, 0, 0, 0);
   if (results.empty()){
@@ -45,7 +45,7 @@ vector<Ref<Result> > GenericMultipleBarcodeReader::decodeMultiple(Ref<BinaryBitm
 }
 
 void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image, 
-                                                    DecodeHints hints,
+                                                    DecodeHints const& hints,
                                                     vector<Ref<Result> >& results,
                                                     int xOffset,
                                                     int yOffset,
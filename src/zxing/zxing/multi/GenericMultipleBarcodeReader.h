@@ -30,7 +30,7 @@ class GenericMultipleBarcodeReader : public MultipleBarcodeReader {
                                            int xOffset, 
                                            int yOffset);
   void doDecodeMultiple(Ref<BinaryBitmap> image, 
-                        DecodeHints hints, 
+                        DecodeHints const& hints, 
                         std::vector<Ref<Result> >& results, 
                         int xOffset, 
                         int yOffset,
@@ -42,7 +42,7 @@ class GenericMultipleBarcodeReader : public MultipleBarcodeReader {
  public:
   GenericMultipleBarcodeReader(Reader& delegate);
   virtual ~GenericMultipleBarcodeReader();
-  virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints const& hints);
 };
 
 }
@@ -31,7 +31,7 @@ class MultipleBarcodeReader : public Counted {
     MultipleBarcodeReader() {}
   public:
     virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image);
-    virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints hints) = 0;
+    virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints const& hints) = 0;
     virtual ~MultipleBarcodeReader();
 };
 
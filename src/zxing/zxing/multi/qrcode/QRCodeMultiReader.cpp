@@ -27,7 +27,7 @@ QRCodeMultiReader::QRCodeMultiReader(){}
 QRCodeMultiReader::~QRCodeMultiReader(){}
 
 std::vector<Ref<Result> > QRCodeMultiReader::decodeMultiple(Ref<BinaryBitmap> image, 
-  DecodeHints hints)
+  DecodeHints const& hints)
 {
   std::vector<Ref<Result> > results;
   MultiDetector detector(image->getBlackMatrix());
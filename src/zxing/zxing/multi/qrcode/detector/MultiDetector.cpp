@@ -26,7 +26,7 @@ MultiDetector::MultiDetector(Ref<BitMatrix> image) : Detector(image) {}
 
 MultiDetector::~MultiDetector(){}
 
-std::vector<Ref<DetectorResult> > MultiDetector::detectMulti(DecodeHints hints){
+std::vector<Ref<DetectorResult> > MultiDetector::detectMulti(DecodeHints const& hints){
   Ref<BitMatrix> image = getImage();
   MultiFinderPatternFinder finder = MultiFinderPatternFinder(image, hints.getResultPointCallback());
   std::vector<Ref<FinderPatternInfo> > info = finder.findMulti(hints);
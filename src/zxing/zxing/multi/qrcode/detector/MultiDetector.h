@@ -28,7 +28,7 @@ class MultiDetector : public zxing::qrcode::Detector {
   public:
     MultiDetector(Ref<BitMatrix> image);
     virtual ~MultiDetector();
-    virtual std::vector<Ref<DetectorResult> > detectMulti(DecodeHints hints);
+    virtual std::vector<Ref<DetectorResult> > detectMulti(DecodeHints const& hints);
 };
 
 }
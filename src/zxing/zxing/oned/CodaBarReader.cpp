@@ -76,7 +76,7 @@ const int CodaBarReader::PADDING =
 CodaBarReader::CodaBarReader() 
   : counters(80, 0), counterLength(0) {}
 
-Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints /*hints*/) {
+Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& /*hints*/) {
 
   { // Arrays.fill(counters, 0);
     int size = counters.size();
@@ -233,7 +233,7 @@ void CodaBarReader::validatePattern(int start)  {
  * uses our builtin "counters" member for storage.
  * @param row row to count from
  */
-void CodaBarReader::setCounters(Ref<BitArray> row)  {
+void CodaBarReader::setCounters(Ref<BitArray> const& row)  {
   counterLength = 0;
   // Start from the first white bit.
   int i = row->getNextUnset(0);
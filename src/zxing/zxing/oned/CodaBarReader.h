@@ -37,12 +37,12 @@ private:
 public:
   CodaBarReader();
 
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
   
   void validatePattern(int start);
 
 private:
-  void setCounters(Ref<BitArray> row);
+  void setCounters(Ref<BitArray> const& row);
   void counterAppend(int e);
   int findStartPattern();
   
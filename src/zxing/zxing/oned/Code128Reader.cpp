@@ -179,7 +179,7 @@ const int CODE_PATTERNS[CODE_PATTERNS_LENGTH][6] = {
 
 Code128Reader::Code128Reader(){}
 
-vector<int> Code128Reader::findStartPattern(Ref<BitArray> row){
+vector<int> Code128Reader::findStartPattern(Ref<BitArray> const& row){
   int width = row->getSize();
   int rowOffset = row->getNextSet(0);
 
@@ -229,7 +229,7 @@ vector<int> Code128Reader::findStartPattern(Ref<BitArray> row){
   throw NotFoundException();
 }
 
-int Code128Reader::decodeCode(Ref<BitArray> row, vector<int>& counters, int rowOffset) {
+int Code128Reader::decodeCode(Ref<BitArray> const& row, vector<int>& counters, int rowOffset) {
   recordPattern(row, rowOffset, counters);
   int bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
   int bestMatch = -1;
@@ -249,7 +249,7 @@ int Code128Reader::decodeCode(Ref<BitArray> row, vector<int>& counters, int rowO
   }
 }
 
-Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints hints) {
+Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& hints) {
   bool convertFNC1 = hints.containsFormat(zxing::BarcodeFormat(zxing::BarcodeFormat::ASSUME_GS1));
 
   vector<int> startPatternInfo (findStartPattern(row));
@@ -92,7 +92,7 @@ Code39Reader::Code39Reader(bool usingCheckDigit_, bool extendedMode_) {
   init(usingCheckDigit_, extendedMode_);
 }
 
-Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints /*hints*/) {
+Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& /*hints*/) {
   std::vector<int>& theCounters (counters);
   { // Arrays.fill(counters, 0);
     int size = theCounters.size();
@@ -175,7 +175,7 @@ Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::Dec
     );
 }
 
-vector<int> Code39Reader::findAsteriskPattern(Ref<BitArray> row, vector<int>& counters){
+vector<int> Code39Reader::findAsteriskPattern(Ref<BitArray> const& row, vector<int>& counters){
   int width = row->getSize();
   int rowOffset = row->getNextSet(0);
 
@@ -41,7 +41,7 @@ private:
 			
   void init(bool usingCheckDigit = false, bool extendedMode = false);
 
-  static std::vector<int> findAsteriskPattern(Ref<BitArray> row,
+  static std::vector<int> findAsteriskPattern(Ref<BitArray> const& row,
                                               std::vector<int>& counters);
   static int toNarrowWidePattern(std::vector<int>& counters);
   static char patternToChar(int pattern);
@@ -54,7 +54,7 @@ public:
   Code39Reader(bool usingCheckDigit_);
   Code39Reader(bool usingCheckDigit_, bool extendedMode_);
 			
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
 };
 
 }
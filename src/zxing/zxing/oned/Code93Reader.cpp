@@ -64,7 +64,7 @@ Code93Reader::Code93Reader() {
   counters.resize(6);
 }
 
-Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints /*hints*/) {
+Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& /*hints*/) {
   Range start (findAsteriskPattern(row));
   // Read off white space    
   int nextStart = row->getNextSet(start[1]);
@@ -135,7 +135,7 @@ Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::Dec
                        BarcodeFormat::CODE_93));
 }
 
-Code93Reader::Range Code93Reader::findAsteriskPattern(Ref<BitArray> row)  {
+Code93Reader::Range Code93Reader::findAsteriskPattern(Ref<BitArray> const& row)  {
   int width = row->getSize();
   int rowOffset = row->getNextSet(0);
 
@@ -35,13 +35,13 @@ namespace oned {
 class Code93Reader : public OneDReader {
 public:
   Code93Reader();
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
 
 private:
   std::string decodeRowResult;
   std::vector<int> counters;
 
-  Range findAsteriskPattern(Ref<BitArray> row);
+  Range findAsteriskPattern(Ref<BitArray> const& row);
 
   static int toPattern(std::vector<int>& counters);
   static char patternToChar(int pattern);
@@ -31,7 +31,7 @@ namespace {
 
 EAN13Reader::EAN13Reader() : decodeMiddleCounters(4, 0) { }
 
-int EAN13Reader::decodeMiddle(Ref<BitArray> row,
+int EAN13Reader::decodeMiddle(Ref<BitArray> const& row,
                               Range const& startRange,
                               std::string& resultString) {
   vector<int>& counters (decodeMiddleCounters);
@@ -81,7 +81,7 @@ ITFReader::ITFReader() : narrowLineWidth(-1) {
 }
 
 
-Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints /*hints*/) {
+Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& /*hints*/) {
   // Find out where the Middle section (payload) starts & ends
 
   Range startRange = decodeStart(row);
@@ -126,7 +126,7 @@ Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::Decode
  * @param resultString {@link StringBuffer} to append decoded chars to
  * @throws ReaderException if decoding could not complete successfully
  */
-void ITFReader::decodeMiddle(Ref<BitArray> row,
+void ITFReader::decodeMiddle(Ref<BitArray> const& row,
                              int payloadStart,
                              int payloadEnd,
                              std::string& resultString) {
@@ -169,7 +169,7 @@ void ITFReader::decodeMiddle(Ref<BitArray> row,
  *         'start block'
  * @throws ReaderException
  */
-ITFReader::Range ITFReader::decodeStart(Ref<BitArray> row) {
+ITFReader::Range ITFReader::decodeStart(Ref<BitArray> const& row) {
   int endStart = skipWhiteSpace(row);
   Range startPattern = findGuardPattern(row, endStart, START_PATTERN);
 
@@ -191,7 +191,7 @@ ITFReader::Range ITFReader::decodeStart(Ref<BitArray> row) {
  * @throws ReaderException
  */
 
-ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> row) {
+ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> const& row) {
   // For convenience, reverse the row and then
   // search from 'the start' for the end block
   BitArray::Reverse r (row);
@@ -229,7 +229,7 @@ ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> row) {
  * @param startPattern index into row of the start or end pattern.
  * @throws ReaderException if the quiet zone cannot be found, a ReaderException is thrown.
  */
-void ITFReader::validateQuietZone(Ref<BitArray> row, int startPattern) {
+void ITFReader::validateQuietZone(Ref<BitArray> const& row, int startPattern) {
   int quietCount = this->narrowLineWidth * 10;  // expect to find this many pixels of quiet zone
 
   for (int i = startPattern - 1; quietCount > 0 && i >= 0; i--) {
@@ -251,7 +251,7 @@ void ITFReader::validateQuietZone(Ref<BitArray> row, int startPattern) {
  * @return index of the first black line.
  * @throws ReaderException Throws exception if no black lines are found in the row
  */
-int ITFReader::skipWhiteSpace(Ref<BitArray> row) {
+int ITFReader::skipWhiteSpace(Ref<BitArray> const& row) {
   int width = row->getSize();
   int endStart = row->getNextSet(0);
   if (endStart == width) {
@@ -269,7 +269,7 @@ int ITFReader::skipWhiteSpace(Ref<BitArray> row) {
  *         ints
  * @throws ReaderException if pattern is not found
  */
-ITFReader::Range ITFReader::findGuardPattern(Ref<BitArray> row,
+ITFReader::Range ITFReader::findGuardPattern(Ref<BitArray> const& row,
                                              int rowOffset,
                                              vector<int> const& pattern) {
   // TODO: This is very similar to implementation in UPCEANReader. Consider if they can be
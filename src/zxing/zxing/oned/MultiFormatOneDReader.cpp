@@ -23,6 +23,8 @@
 #include <zxing/oned/Code93Reader.h>
 #include <zxing/oned/CodaBarReader.h>
 #include <zxing/oned/ITFReader.h>
+#include <zxing/oned/rss/RSS14Reader.h>
+#include <zxing/oned/rss/expanded/RSSExpandedReader.h>
 #include <zxing/ReaderException.h>
 #include <zxing/NotFoundException.h>
 
@@ -34,7 +36,7 @@ using zxing::oned::MultiFormatOneDReader;
 using zxing::DecodeHints;
 using zxing::BitArray;
 
-MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
+MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints const& hints) : readers() {
   if (hints.containsFormat(BarcodeFormat::EAN_13) ||
       hints.containsFormat(BarcodeFormat::EAN_8) ||
       hints.containsFormat(BarcodeFormat::UPC_A) ||
@@ -56,16 +58,12 @@ MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
   if (hints.containsFormat(BarcodeFormat::CODABAR)) {
     readers.push_back(Ref<OneDReader>(new CodaBarReader()));
   }
-/*
   if (hints.containsFormat(BarcodeFormat::RSS_14)) {
-    readers.push_back(Ref<OneDReader>(new RSS14Reader()));
+    readers.push_back(Ref<OneDReader>(new rss::RSS14Reader()));
   }
-*/
-/*
   if (hints.containsFormat(BarcodeFormat::RSS_EXPANDED)) {
-    readers.push_back(Ref<OneDReader>(new RSS14ExpandedReader()));
+    readers.push_back(Ref<OneDReader>(new rss::RSSExpandedReader()));
   }
-*/
   if (readers.size() == 0) {
     readers.push_back(Ref<OneDReader>(new MultiFormatUPCEANReader(hints)));
     readers.push_back(Ref<OneDReader>(new Code39Reader()));
@@ -73,14 +71,14 @@ MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
     readers.push_back(Ref<OneDReader>(new Code93Reader()));
     readers.push_back(Ref<OneDReader>(new Code128Reader()));
     readers.push_back(Ref<OneDReader>(new ITFReader()));
-    // readers.push_back(Ref<OneDReader>(new RSS14Reader()));
-    // readers.push_back(Ref<OneDReader>(new RSS14ExpandedReader()));
+    readers.push_back(Ref<OneDReader>(new rss::RSS14Reader()));
+    readers.push_back(Ref<OneDReader>(new rss::RSSExpandedReader()));
   }
 }
 
 #include <typeinfo>
 
-Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints hints) {
+Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& hints) {
   int size = readers.size();
   for (int i = 0; i < size; i++) {
     OneDReader* reader = readers[i];
@@ -94,3 +92,10 @@ Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> row, z
   }
   throw NotFoundException();
 }
+
+void MultiFormatOneDReader::reset() {
+  int size = readers.size();
+  for (int i = 0; i < size; i++) {
+    readers[i]->reset();
+  }
+}
@@ -28,9 +28,10 @@ namespace zxing {
     private:
       std::vector<Ref<OneDReader> > readers;
     public:
-      MultiFormatOneDReader(DecodeHints hints);
+      MultiFormatOneDReader(DecodeHints const& hints);
 
-      Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
+      Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
+      void reset();
     };
   }
 }
@@ -39,7 +39,7 @@ using zxing::oned::MultiFormatUPCEANReader;
 using zxing::DecodeHints;
 using zxing::BitArray;
 
-MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints) : readers() {
+MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints const& hints) : readers() {
   if (hints.containsFormat(BarcodeFormat::EAN_13)) {
     readers.push_back(Ref<UPCEANReader>(new EAN13Reader()));
   } else if (hints.containsFormat(BarcodeFormat::UPC_A)) {
@@ -61,7 +61,7 @@ MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints) : readers()
 
 #include <typeinfo>
 
-Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints /*hints*/) {
+Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& /*hints*/) {
   // Compute this location once and reuse it on multiple implementations
   UPCEANReader::Range startGuardPattern = UPCEANReader::findStartGuardPattern(row);
   for (int i = 0, e = readers.size(); i < e; i++) {
@@ -31,8 +31,8 @@ class MultiFormatUPCEANReader : public OneDReader {
 private:
     std::vector< Ref<UPCEANReader> > readers;
 public:
-    MultiFormatUPCEANReader(DecodeHints hints);
-    Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
+    MultiFormatUPCEANReader(DecodeHints const& hints);
+    Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
 };
 
 }
@@ -35,8 +35,9 @@ using zxing::BinaryBitmap;
 using zxing::BitArray;
 using zxing::DecodeHints;
 
-Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
   try {
+    reset();
     return doDecode(image, hints);
   } catch (NotFoundException const& nfe) {
     // std::cerr << "trying harder" << std::endl;
@@ -45,6 +46,7 @@ Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
       // std::cerr << "v rotate" << std::endl;
       Ref<BinaryBitmap> rotatedImage(image->rotateCounterClockwise());
       // std::cerr << "^ rotate" << std::endl;
+      reset();
       Ref<Result> result = doDecode(rotatedImage, hints);
       // Doesn't have java metadata stuff
       ArrayRef< Ref<ResultPoint> >& points (result->getResultPoints());
@@ -65,7 +67,7 @@ Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
 
 #include <typeinfo>
 
-Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
+Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
   int width = image->getWidth();
   int height = image->getHeight();
   Ref<BitArray> row(new BitArray(width));
@@ -129,11 +131,11 @@ Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
           // And remember to flip the result points horizontally.
           ArrayRef< Ref<ResultPoint> > points(result->getResultPoints());
           if (points) {
-            points[0] = Ref<ResultPoint>(new OneDResultPoint(width - points[0]->getX() - 1,
-                                                             points[0]->getY()));
-            points[1] = Ref<ResultPoint>(new OneDResultPoint(width - points[1]->getX() - 1,
-                                                             points[1]->getY()));
-            
+            // RSS readers report four points, the rest two
+            for (int i = 0; i < points->size(); i++) {
+              points[i] = Ref<ResultPoint>(new OneDResultPoint(width - points[i]->getX() - 1,
+                                                               points[i]->getY()));
+            }
           }
         }
         return result;
@@ -186,7 +188,7 @@ int OneDReader::patternMatchVariance(vector<int>& counters,
   return totalVariance / total;
 }
 
-void OneDReader::recordPattern(Ref<BitArray> row,
+void OneDReader::recordPattern(Ref<BitArray> const& row,
                                int start,
                                vector<int>& counters) {
   int numCounters = counters.size();
@@ -221,4 +223,24 @@ void OneDReader::recordPattern(Ref<BitArray> row,
   }
 }
 
+void OneDReader::recordPatternInReverse(Ref<BitArray> const& row,
+                                        int start,
+                                        vector<int>& counters) {
+  // This could be more efficient I guess
+  int numTransitionsLeft = counters.size();
+  bool last = row->get(start);
+  while (start > 0 && numTransitionsLeft >= 0) {
+    if (row->get(--start) != last) {
+      numTransitionsLeft--;
+      last = !last;
+    }
+  }
+  if (numTransitionsLeft >= 0) {
+    throw NotFoundException();
+  }
+  recordPattern(row, start + 1, counters);
+}
+
+void OneDReader::reset() {}
+
 OneDReader::~OneDReader() {}
@@ -29,7 +29,7 @@ namespace oned {
 
 class OneDReader : public Reader {
 private:
-  Ref<Result> doDecode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Result> doDecode(Ref<BinaryBitmap> image, DecodeHints const& hints);
 
 protected:
   static const int INTEGER_MATH_SHIFT = 8;
@@ -63,15 +63,22 @@ protected:
 
 public:
 
-  virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
 
   // Implementations must not throw any exceptions. If a barcode is not found on this row,
   // a empty ref should be returned e.g. return Ref<Result>();
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints) = 0;
+  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints) = 0;
 
-  static void recordPattern(Ref<BitArray> row,
+  // Readers that collect data over several rows (RSS) drop it here.
+  // Called before each image is scanned.
+  virtual void reset();
+
+  static void recordPattern(Ref<BitArray> const& row,
                             int start,
                             std::vector<int>& counters);
+  static void recordPatternInReverse(Ref<BitArray> const& row,
+                                     int start,
+                                     std::vector<int>& counters);
   virtual ~OneDReader();
 };
 
@@ -32,21 +32,21 @@ using zxing::DecodeHints;
 
 UPCAReader::UPCAReader() : ean13Reader() {}
 
-Ref<Result> UPCAReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints hints) {
+Ref<Result> UPCAReader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& hints) {
   return maybeReturnResult(ean13Reader.decodeRow(rowNumber, row, hints));
 }
 
 Ref<Result> UPCAReader::decodeRow(int rowNumber,
-                                  Ref<BitArray> row,
+                                  Ref<BitArray> const& row,
                                   Range const& startGuardRange) {
   return maybeReturnResult(ean13Reader.decodeRow(rowNumber, row, startGuardRange));
 }
 
-Ref<Result> UPCAReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+Ref<Result> UPCAReader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
   return maybeReturnResult(ean13Reader.decode(image, hints));
 }
 
-int UPCAReader::decodeMiddle(Ref<BitArray> row,
+int UPCAReader::decodeMiddle(Ref<BitArray> const& row,
                              Range const& startRange,
                              std::string& resultString) {
   return ean13Reader.decodeMiddle(row, startRange, resultString);
@@ -35,11 +35,11 @@ private:
 public:
   UPCAReader();
 
-  int decodeMiddle(Ref<BitArray> row, Range const& startRange, std::string& resultString);
+  int decodeMiddle(Ref<BitArray> const& row, Range const& startRange, std::string& resultString);
 
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, Range const& startGuardRange);
-  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, Range const& startGuardRange);
+  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
 
   BarcodeFormat getBarcodeFormat();
 };
@@ -118,12 +118,12 @@ UPCEANReader::L_AND_G_PATTERNS (VECTOR_INIT(L_AND_G_PATTERNS_));
 
 UPCEANReader::UPCEANReader() {}
 
-Ref<Result> UPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row, zxing::DecodeHints /*hints*/) {
+Ref<Result> UPCEANReader::decodeRow(int rowNumber, Ref<BitArray> const& row, zxing::DecodeHints const& /*hints*/) {
   return decodeRow(rowNumber, row, findStartGuardPattern(row));
 }
 
 Ref<Result> UPCEANReader::decodeRow(int rowNumber,
-                                    Ref<BitArray> row,
+                                    Ref<BitArray> const& row,
                                     Range const& startGuardRange) {
   string& result = decodeRowStringBuffer;
   result.clear();
@@ -161,7 +161,7 @@ Ref<Result> UPCEANReader::decodeRow(int rowNumber,
   return decodeResult;
 }
 
-UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> row) {
+UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> const& row) {
   bool foundStart = false;
   Range startRange;
   int nextStart = 0;
@@ -186,7 +186,7 @@ UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> row) {
   return startRange;
 }
 
-UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
+UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> const& row,
                                                    int rowOffset,
                                                    bool whiteFirst,
                                                    vector<int> const& pattern) {
@@ -194,7 +194,7 @@ UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
   return findGuardPattern(row, rowOffset, whiteFirst, pattern, counters);
 }
 
-UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
+UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> const& row,
                                                    int rowOffset,
                                                    bool whiteFirst,
                                                    vector<int> const& pattern,
@@ -238,11 +238,11 @@ UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
   throw NotFoundException();
 }
 
-UPCEANReader::Range UPCEANReader::decodeEnd(Ref<BitArray> row, int endStart) {
+UPCEANReader::Range UPCEANReader::decodeEnd(Ref<BitArray> const& row, int endStart) {
   return findGuardPattern(row, endStart, false, START_END_PATTERN);
 }
 
-int UPCEANReader::decodeDigit(Ref<BitArray> row,
+int UPCEANReader::decodeDigit(Ref<BitArray> const& row,
                               vector<int> & counters,
                               int rowOffset,
                               vector<int const*> const& patterns) {
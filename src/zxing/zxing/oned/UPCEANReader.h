@@ -34,13 +34,13 @@ class UPCEANReader : public OneDReader {
   static const int MAX_AVG_VARIANCE;
   static const int MAX_INDIVIDUAL_VARIANCE;
 
-  static Range findStartGuardPattern(Ref<BitArray> row);
+  static Range findStartGuardPattern(Ref<BitArray> const& row);
 
-  virtual Range decodeEnd(Ref<BitArray> row, int endStart);
+  virtual Range decodeEnd(Ref<BitArray> const& row, int endStart);
 
   static bool checkStandardUPCEANChecksum(Ref<String> const& s);
 
-  static Range findGuardPattern(Ref<BitArray> row,
+  static Range findGuardPattern(Ref<BitArray> const& row,
                                 int rowOffset,
                                 bool whiteFirst,
                                 std::vector<int> const& pattern,
@@ -54,7 +54,7 @@ protected:
   static const std::vector<int const*> L_PATTERNS;
   static const std::vector<int const*> L_AND_G_PATTERNS;
 
-  static Range findGuardPattern(Ref<BitArray> row,
+  static Range findGuardPattern(Ref<BitArray> const& row,
                                 int rowOffset,
                                 bool whiteFirst,
                                 std::vector<int> const& pattern);
@@ -62,14 +62,14 @@ protected:
 public:
   UPCEANReader();
 
-  virtual int decodeMiddle(Ref<BitArray> row,
+  virtual int decodeMiddle(Ref<BitArray> const& row,
                            Range const& startRange,
                            std::string& resultString) = 0;
 
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, DecodeHints hints);
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, Range const& range);
+  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
+  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, Range const& range);
 
-  static int decodeDigit(Ref<BitArray> row,
+  static int decodeDigit(Ref<BitArray> const& row,
                          std::vector<int>& counters,
                          int rowOffset,
                          std::vector<int const*> const& patterns);
@@ -53,7 +53,7 @@ namespace {
 UPCEReader::UPCEReader() {
 }
 
-int UPCEReader::decodeMiddle(Ref<BitArray> row, Range const& startRange, string& result) {
+int UPCEReader::decodeMiddle(Ref<BitArray> const& row, Range const& startRange, string& result) {
   vector<int>& counters (decodeMiddleCounters);
   counters.clear();
   counters.resize(4);
@@ -78,7 +78,7 @@ int UPCEReader::decodeMiddle(Ref<BitArray> row, Range const& startRange, string&
   return rowOffset;
 }
 
-UPCEReader::Range UPCEReader::decodeEnd(Ref<BitArray> row, int endStart) {
+UPCEReader::Range UPCEReader::decodeEnd(Ref<BitArray> const& row, int endStart) {
   return findGuardPattern(row, endStart, true, MIDDLE_END_PATTERN);
 }
 
@@ -30,12 +30,12 @@ private:
   static bool determineNumSysAndCheckDigit(std::string& resultString, int lgPatternFound);
 
 protected:
-  Range decodeEnd(Ref<BitArray> row, int endStart);
+  Range decodeEnd(Ref<BitArray> const& row, int endStart);
   bool checkChecksum(Ref<String> const& s);
 public:
   UPCEReader();
 
-  int decodeMiddle(Ref<BitArray> row, Range const& startRange, std::string& resultString);
+  int decodeMiddle(Ref<BitArray> const& row, Range const& startRange, std::string& resultString);
   static Ref<String> convertUPCEtoUPCA(Ref<String> const& upce);
 
   BarcodeFormat getBarcodeFormat();
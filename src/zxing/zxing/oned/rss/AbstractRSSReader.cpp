@@ -0,0 +1,103 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/AbstractRSSReader.h>
+#include <zxing/NotFoundException.h>
+
+using std::vector;
+using zxing::NotFoundException;
+using zxing::oned::rss::AbstractRSSReader;
+
+const int AbstractRSSReader::MAX_AVG_VARIANCE = int(PATTERN_MATCH_RESULT_SCALE_FACTOR * 200/1000);
+const int AbstractRSSReader::MAX_INDIVIDUAL_VARIANCE = int(PATTERN_MATCH_RESULT_SCALE_FACTOR * 450/1000);
+
+const float AbstractRSSReader::MIN_FINDER_PATTERN_RATIO = 9.5f / 12.0f;
+const float AbstractRSSReader::MAX_FINDER_PATTERN_RATIO = 12.5f / 14.0f;
+
+AbstractRSSReader::AbstractRSSReader() :
+  decodeFinderCounters_(4),
+  dataCharacterCounters_(8),
+  oddRoundingErrors_(4),
+  evenRoundingErrors_(4),
+  oddCounts_(4),
+  evenCounts_(4) {
+}
+
+int AbstractRSSReader::parseFinderValue(vector<int>& counters,
+                                        int const finderPatterns[][4],
+                                        int numPatterns) {
+  for (int value = 0; value < numPatterns; value++) {
+    if (patternMatchVariance(counters, finderPatterns[value], MAX_INDIVIDUAL_VARIANCE) <
+        MAX_AVG_VARIANCE) {
+      return value;
+    }
+  }
+  throw NotFoundException();
+}
+
+int AbstractRSSReader::count(vector<int> const& array) {
+  int count = 0;
+  for (size_t i = 0; i < array.size(); i++) {
+    count += array[i];
+  }
+  return count;
+}
+
+void AbstractRSSReader::increment(vector<int>& array, vector<float> const& errors) {
+  int index = 0;
+  float biggestError = errors[0];
+  for (size_t i = 1; i < array.size(); i++) {
+    if (errors[i] > biggestError) {
+      biggestError = errors[i];
+      index = i;
+    }
+  }
+  array[index]++;
+}
+
+void AbstractRSSReader::decrement(vector<int>& array, vector<float> const& errors) {
+  int index = 0;
+  float biggestError = errors[0];
+  for (size_t i = 1; i < array.size(); i++) {
+    if (errors[i] < biggestError) {
+      biggestError = errors[i];
+      index = i;
+    }
+  }
+  array[index]--;
+}
+
+bool AbstractRSSReader::isFinderPattern(vector<int> const& counters) {
+  int firstTwoSum = counters[0] + counters[1];
+  int sum = firstTwoSum + counters[2] + counters[3];
+  float ratio = (float) firstTwoSum / (float) sum;
+  if (ratio >= MIN_FINDER_PATTERN_RATIO && ratio <= MAX_FINDER_PATTERN_RATIO) {
+    // passes ratio test in spec, but see if the counts are unreasonable
+    int minCounter = counters[0];
+    int maxCounter = counters[0];
+    for (int i = 1; i < 4; i++) {
+      if (counters[i] > maxCounter) {
+        maxCounter = counters[i];
+      }
+      if (counters[i] < minCounter) {
+        minCounter = counters[i];
+      }
+    }
+    return maxCounter < 10 * minCounter;
+  }
+  return false;
+}
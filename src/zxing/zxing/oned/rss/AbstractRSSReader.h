@@ -0,0 +1,59 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ABSTRACT_RSS_READER_H__
+#define __ABSTRACT_RSS_READER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/OneDReader.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class AbstractRSSReader : public OneDReader {
+private:
+  static const int MAX_AVG_VARIANCE;
+  static const int MAX_INDIVIDUAL_VARIANCE;
+
+  static const float MIN_FINDER_PATTERN_RATIO;
+  static const float MAX_FINDER_PATTERN_RATIO;
+
+protected:
+  // Scratch buffers, allocated once per reader and reused for every row
+  std::vector<int> decodeFinderCounters_;
+  std::vector<int> dataCharacterCounters_;
+  std::vector<float> oddRoundingErrors_;
+  std::vector<float> evenRoundingErrors_;
+  std::vector<int> oddCounts_;
+  std::vector<int> evenCounts_;
+
+  AbstractRSSReader();
+
+  static int parseFinderValue(std::vector<int>& counters,
+                              int const finderPatterns[][4],
+                              int numPatterns);
+  static int count(std::vector<int> const& array);
+  static void increment(std::vector<int>& array, std::vector<float> const& errors);
+  static void decrement(std::vector<int>& array, std::vector<float> const& errors);
+  static bool isFinderPattern(std::vector<int> const& counters);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,53 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RSS_DATA_CHARACTER_H__
+#define __RSS_DATA_CHARACTER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Counted.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class DataCharacter : public Counted {
+private:
+  int value_;
+  int checksumPortion_;
+
+public:
+  DataCharacter(int value, int checksumPortion) :
+    value_(value), checksumPortion_(checksumPortion) {}
+
+  int getValue() const {
+    return value_;
+  }
+
+  int getChecksumPortion() const {
+    return checksumPortion_;
+  }
+
+  bool equals(DataCharacter const& other) const {
+    return value_ == other.value_ && checksumPortion_ == other.checksumPortion_;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,58 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RSS_FINDER_PATTERN_H__
+#define __RSS_FINDER_PATTERN_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/ResultPoint.h>
+#include <zxing/common/Array.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class FinderPattern : public Counted {
+private:
+  int value_;
+  int startEnd_[2];
+  ArrayRef< Ref<ResultPoint> > resultPoints_;
+
+public:
+  FinderPattern(int value, int startPos, int endPos, int start, int end, int rowNumber);
+
+  int getValue() const {
+    return value_;
+  }
+
+  int const* getStartEnd() const {
+    return startEnd_;
+  }
+
+  ArrayRef< Ref<ResultPoint> > getResultPoints() const {
+    return resultPoints_;
+  }
+
+  bool equals(FinderPattern const& other) const {
+    return value_ == other.value_;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,54 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RSS_PAIR_H__
+#define __RSS_PAIR_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/DataCharacter.h>
+#include <zxing/oned/rss/FinderPattern.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class Pair : public DataCharacter {
+private:
+  Ref<FinderPattern> finderPattern_;
+  int count_;
+
+public:
+  Pair(int value, int checksumPortion, Ref<FinderPattern> finderPattern) :
+    DataCharacter(value, checksumPortion), finderPattern_(finderPattern), count_(1) {}
+
+  Ref<FinderPattern> getFinderPattern() const {
+    return finderPattern_;
+  }
+
+  int getCount() const {
+    return count_;
+  }
+
+  void incrementCount() {
+    count_++;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,429 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/ZXing.h>
+#include <zxing/oned/rss/RSS14Reader.h>
+#include <zxing/oned/rss/RSSUtils.h>
+#include <zxing/NotFoundException.h>
+#include <zxing/BarcodeFormat.h>
+#include <sstream>
+
+using std::vector;
+using std::string;
+using zxing::NotFoundException;
+using zxing::Ref;
+using zxing::Result;
+using zxing::oned::rss::RSS14Reader;
+using zxing::oned::rss::Pair;
+using zxing::oned::rss::DataCharacter;
+using zxing::oned::rss::FinderPattern;
+using zxing::oned::rss::RSSUtils;
+
+// VC++
+using zxing::ArrayRef;
+using zxing::BitArray;
+using zxing::DecodeHints;
+using zxing::ResultPoint;
+
+namespace {
+
+const int OUTSIDE_EVEN_TOTAL_SUBSET[] = {1,10,34,70,126};
+const int INSIDE_ODD_TOTAL_SUBSET[] = {4,20,48,81};
+const int OUTSIDE_GSUM[] = {0,161,961,2015,2715};
+const int INSIDE_GSUM[] = {0,336,1036,1516};
+const int OUTSIDE_ODD_WIDEST[] = {8,6,4,3,1};
+const int INSIDE_ODD_WIDEST[] = {2,4,6,8};
+
+const int FINDER_PATTERNS[][4] = {
+  {3,8,2,1},
+  {3,5,5,1},
+  {3,3,7,1},
+  {3,1,9,1},
+  {2,7,4,1},
+  {2,5,6,1},
+  {2,3,8,1},
+  {1,5,7,1},
+  {1,3,9,1},
+};
+
+}
+
+RSS14Reader::RSS14Reader() {}
+
+Ref<Result> RSS14Reader::decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& /* hints */) {
+  Ref<Pair> leftPair = decodePair(row, false, rowNumber);
+  addOrTally(possibleLeftPairs_, leftPair);
+  row->reverse();
+  Ref<Pair> rightPair = decodePair(row, true, rowNumber);
+  addOrTally(possibleRightPairs_, rightPair);
+  row->reverse();
+  for (size_t i = 0; i < possibleLeftPairs_.size(); i++) {
+    Ref<Pair> left = possibleLeftPairs_[i];
+    if (left->getCount() > 1) {
+      for (size_t j = 0; j < possibleRightPairs_.size(); j++) {
+        Ref<Pair> right = possibleRightPairs_[j];
+        if (right->getCount() > 1 && checkChecksum(left, right)) {
+          return constructResult(left, right);
+        }
+      }
+    }
+  }
+  throw NotFoundException();
+}
+
+void RSS14Reader::addOrTally(vector< Ref<Pair> >& possiblePairs, Ref<Pair> pair) {
+  if (!pair) {
+    return;
+  }
+  for (size_t i = 0; i < possiblePairs.size(); i++) {
+    if (possiblePairs[i]->getValue() == pair->getValue()) {
+      possiblePairs[i]->incrementCount();
+      return;
+    }
+  }
+  possiblePairs.push_back(pair);
+}
+
+void RSS14Reader::reset() {
+  possibleLeftPairs_.clear();
+  possibleRightPairs_.clear();
+}
+
+Ref<Result> RSS14Reader::constructResult(Ref<Pair> leftPair, Ref<Pair> rightPair) {
+  long long symbolValue = 4537077LL * leftPair->getValue() + rightPair->getValue();
+  std::ostringstream text;
+  text << symbolValue;
+
+  string buffer;
+  for (int i = 13 - (int) text.str().length(); i > 0; i--) {
+    buffer.append(1, '0');
+  }
+  buffer.append(text.str());
+
+  int checkDigit = 0;
+  for (int i = 0; i < 13; i++) {
+    int digit = buffer[i] - '0';
+    checkDigit += (i & 0x01) == 0 ? 3 * digit : digit;
+  }
+  checkDigit = 10 - (checkDigit % 10);
+  if (checkDigit == 10) {
+    checkDigit = 0;
+  }
+  buffer.append(1, (char) ('0' + checkDigit));
+
+  ArrayRef< Ref<ResultPoint> > leftPoints = leftPair->getFinderPattern()->getResultPoints();
+  ArrayRef< Ref<ResultPoint> > rightPoints = rightPair->getFinderPattern()->getResultPoints();
+  ArrayRef< Ref<ResultPoint> > resultPoints(4);
+  resultPoints[0] = leftPoints[0];
+  resultPoints[1] = leftPoints[1];
+  resultPoints[2] = rightPoints[0];
+  resultPoints[3] = rightPoints[1];
+  return Ref<Result>(new Result(Ref<String>(new String(buffer)), ArrayRef<byte>(),
+                                resultPoints, BarcodeFormat::RSS_14));
+}
+
+bool RSS14Reader::checkChecksum(Ref<Pair> leftPair, Ref<Pair> rightPair) {
+  int checkValue = (leftPair->getChecksumPortion() + 16 * rightPair->getChecksumPortion()) % 79;
+  int targetCheckValue =
+      9 * leftPair->getFinderPattern()->getValue() + rightPair->getFinderPattern()->getValue();
+  if (targetCheckValue > 72) {
+    targetCheckValue--;
+  }
+  if (targetCheckValue > 8) {
+    targetCheckValue--;
+  }
+  return checkValue == targetCheckValue;
+}
+
+Ref<Pair> RSS14Reader::decodePair(Ref<BitArray> const& row, bool right, int rowNumber) {
+  try {
+    int startEnd[2];
+    if (!findFinderPattern(row, right, startEnd)) {
+      return Ref<Pair>();
+    }
+    Ref<FinderPattern> pattern = parseFoundFinderPattern(row, rowNumber, right, startEnd);
+    Ref<DataCharacter> outside = decodeDataCharacter(row, pattern, true);
+    Ref<DataCharacter> inside = decodeDataCharacter(row, pattern, false);
+    return Ref<Pair>(new Pair(1597 * outside->getValue() + inside->getValue(),
+                              outside->getChecksumPortion() + 4 * inside->getChecksumPortion(),
+                              pattern));
+  } catch (NotFoundException const& ignored) {
+    (void)ignored;
+    return Ref<Pair>();
+  }
+}
+
+Ref<DataCharacter> RSS14Reader::decodeDataCharacter(Ref<BitArray> const& row,
+                                                    Ref<FinderPattern> pattern,
+                                                    bool outsideChar) {
+  vector<int>& counters = dataCharacterCounters_;
+  if (outsideChar) {
+    recordPatternInReverse(row, pattern->getStartEnd()[0], counters);
+  } else {
+    recordPattern(row, pattern->getStartEnd()[1], counters);
+    // reverse it
+    for (int i = 0, j = counters.size() - 1; i < j; i++, j--) {
+      int temp = counters[i];
+      counters[i] = counters[j];
+      counters[j] = temp;
+    }
+  }
+
+  int numModules = outsideChar ? 16 : 15;
+  float elementWidth = (float) count(counters) / (float) numModules;
+
+  for (size_t i = 0; i < counters.size(); i++) {
+    float value = (float) counters[i] / elementWidth;
+    int count = (int) (value + 0.5f); // Round
+    if (count < 1) {
+      count = 1;
+    } else if (count > 8) {
+      count = 8;
+    }
+    int offset = i >> 1;
+    if ((i & 0x01) == 0) {
+      oddCounts_[offset] = count;
+      oddRoundingErrors_[offset] = value - count;
+    } else {
+      evenCounts_[offset] = count;
+      evenRoundingErrors_[offset] = value - count;
+    }
+  }
+
+  adjustOddEvenCounts(outsideChar, numModules);
+
+  int oddSum = 0;
+  int oddChecksumPortion = 0;
+  for (int i = oddCounts_.size() - 1; i >= 0; i--) {
+    oddChecksumPortion *= 9;
+    oddChecksumPortion += oddCounts_[i];
+    oddSum += oddCounts_[i];
+  }
+  int evenChecksumPortion = 0;
+  int evenSum = 0;
+  for (int i = evenCounts_.size() - 1; i >= 0; i--) {
+    evenChecksumPortion *= 9;
+    evenChecksumPortion += evenCounts_[i];
+    evenSum += evenCounts_[i];
+  }
+  int checksumPortion = oddChecksumPortion + 3 * evenChecksumPortion;
+
+  if (outsideChar) {
+    if ((oddSum & 0x01) != 0 || oddSum > 12 || oddSum < 4) {
+      throw NotFoundException();
+    }
+    int group = (12 - oddSum) / 2;
+    int oddWidest = OUTSIDE_ODD_WIDEST[group];
+    int evenWidest = 9 - oddWidest;
+    int vOdd = RSSUtils::getRSSvalue(oddCounts_, oddWidest, false);
+    int vEven = RSSUtils::getRSSvalue(evenCounts_, evenWidest, true);
+    int tEven = OUTSIDE_EVEN_TOTAL_SUBSET[group];
+    int gSum = OUTSIDE_GSUM[group];
+    return Ref<DataCharacter>(new DataCharacter(vOdd * tEven + vEven + gSum, checksumPortion));
+  } else {
+    if ((evenSum & 0x01) != 0 || evenSum > 10 || evenSum < 4) {
+      throw NotFoundException();
+    }
+    int group = (10 - evenSum) / 2;
+    int oddWidest = INSIDE_ODD_WIDEST[group];
+    int evenWidest = 9 - oddWidest;
+    int vOdd = RSSUtils::getRSSvalue(oddCounts_, oddWidest, true);
+    int vEven = RSSUtils::getRSSvalue(evenCounts_, evenWidest, false);
+    int tOdd = INSIDE_ODD_TOTAL_SUBSET[group];
+    int gSum = INSIDE_GSUM[group];
+    return Ref<DataCharacter>(new DataCharacter(vEven * tOdd + vOdd + gSum, checksumPortion));
+  }
+}
+
+bool RSS14Reader::findFinderPattern(Ref<BitArray> const& row, bool rightFinderPattern, int startEnd[2]) {
+  vector<int>& counters = decodeFinderCounters_;
+  counters[0] = 0;
+  counters[1] = 0;
+  counters[2] = 0;
+  counters[3] = 0;
+
+  int width = row->getSize();
+  bool isWhite = false;
+  int rowOffset = 0;
+  while (rowOffset < width) {
+    isWhite = !row->get(rowOffset);
+    if (rightFinderPattern == isWhite) {
+      // Will encounter white first when searching for right finder pattern
+      break;
+    }
+    rowOffset++;
+  }
+
+  int counterPosition = 0;
+  int patternStart = rowOffset;
+  for (int x = rowOffset; x < width; x++) {
+    if (row->get(x) ^ isWhite) {
+      counters[counterPosition]++;
+    } else {
+      if (counterPosition == 3) {
+        if (isFinderPattern(counters)) {
+          startEnd[0] = patternStart;
+          startEnd[1] = x;
+          return true;
+        }
+        patternStart += counters[0] + counters[1];
+        counters[0] = counters[2];
+        counters[1] = counters[3];
+        counters[2] = 0;
+        counters[3] = 0;
+        counterPosition--;
+      } else {
+        counterPosition++;
+      }
+      counters[counterPosition] = 1;
+      isWhite = !isWhite;
+    }
+  }
+  return false;
+}
+
+Ref<FinderPattern> RSS14Reader::parseFoundFinderPattern(Ref<BitArray> const& row, int rowNumber,
+                                                        bool right, int const startEnd[2]) {
+  // Actually we found elements 2-5
+  bool firstIsBlack = row->get(startEnd[0]);
+  int firstElementStart = startEnd[0] - 1;
+  // Locate element 1
+  while (firstElementStart >= 0 && firstIsBlack ^ row->get(firstElementStart)) {
+    firstElementStart--;
+  }
+  firstElementStart++;
+  int firstCounter = startEnd[0] - firstElementStart;
+  // Make 'counters' hold 1-4
+  vector<int>& counters = decodeFinderCounters_;
+  for (int i = counters.size() - 1; i > 0; i--) {
+    counters[i] = counters[i - 1];
+  }
+  counters[0] = firstCounter;
+  int value = parseFinderValue(counters, FINDER_PATTERNS, ZXING_ARRAY_LEN(FINDER_PATTERNS));
+  int start = firstElementStart;
+  int end = startEnd[1];
+  if (right) {
+    // row is actually reversed
+    start = row->getSize() - 1 - start;
+    end = row->getSize() - 1 - end;
+  }
+  return Ref<FinderPattern>(new FinderPattern(value, firstElementStart, startEnd[1],
+                                              start, end, rowNumber));
+}
+
+void RSS14Reader::adjustOddEvenCounts(bool outsideChar, int numModules) {
+  int oddSum = count(oddCounts_);
+  int evenSum = count(evenCounts_);
+  int mismatch = oddSum + evenSum - numModules;
+  bool oddParityBad = (oddSum & 0x01) == (outsideChar ? 1 : 0);
+  bool evenParityBad = (evenSum & 0x01) == 1;
+
+  bool incrementOdd = false;
+  bool decrementOdd = false;
+  bool incrementEven = false;
+  bool decrementEven = false;
+
+  if (outsideChar) {
+    if (oddSum > 12) {
+      decrementOdd = true;
+    } else if (oddSum < 4) {
+      incrementOdd = true;
+    }
+    if (evenSum > 12) {
+      decrementEven = true;
+    } else if (evenSum < 4) {
+      incrementEven = true;
+    }
+  } else {
+    if (oddSum > 11) {
+      decrementOdd = true;
+    } else if (oddSum < 5) {
+      incrementOdd = true;
+    }
+    if (evenSum > 10) {
+      decrementEven = true;
+    } else if (evenSum < 4) {
+      incrementEven = true;
+    }
+  }
+
+  if (mismatch == 1) {
+    if (oddParityBad) {
+      if (evenParityBad) {
+        throw NotFoundException();
+      }
+      decrementOdd = true;
+    } else {
+      if (!evenParityBad) {
+        throw NotFoundException();
+      }
+      decrementEven = true;
+    }
+  } else if (mismatch == -1) {
+    if (oddParityBad) {
+      if (evenParityBad) {
+        throw NotFoundException();
+      }
+      incrementOdd = true;
+    } else {
+      if (!evenParityBad) {
+        throw NotFoundException();
+      }
+      incrementEven = true;
+    }
+  } else if (mismatch == 0) {
+    if (oddParityBad) {
+      if (!evenParityBad) {
+        throw NotFoundException();
+      }
+      // Both bad
+      if (oddSum < evenSum) {
+        incrementOdd = true;
+        decrementEven = true;
+      } else {
+        decrementOdd = true;
+        incrementEven = true;
+      }
+    } else {
+      if (evenParityBad) {
+        throw NotFoundException();
+      }
+      // Nothing to do!
+    }
+  } else {
+    throw NotFoundException();
+  }
+
+  if (incrementOdd) {
+    if (decrementOdd) {
+      throw NotFoundException();
+    }
+    increment(oddCounts_, oddRoundingErrors_);
+  }
+  if (decrementOdd) {
+    decrement(oddCounts_, oddRoundingErrors_);
+  }
+  if (incrementEven) {
+    if (decrementEven) {
+      throw NotFoundException();
+    }
+    increment(evenCounts_, oddRoundingErrors_);
+  }
+  if (decrementEven) {
+    decrement(evenCounts_, evenRoundingErrors_);
+  }
+}
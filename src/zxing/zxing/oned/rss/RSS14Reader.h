@@ -0,0 +1,66 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RSS14_READER_H__
+#define __RSS14_READER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/AbstractRSSReader.h>
+#include <zxing/oned/rss/Pair.h>
+#include <zxing/common/BitArray.h>
+#include <zxing/Result.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/**
+ * Decodes RSS-14, including truncated and stacked variants. See ISO/IEC 24724:2006.
+ *
+ * Each row yields at most one left and one right half. They are kept
+ * until the end of the image, so that halves seen on different rows
+ * (stacked symbols, or just a noisy image) can be matched by checksum.
+ */
+class RSS14Reader : public AbstractRSSReader {
+private:
+  std::vector< Ref<Pair> > possibleLeftPairs_;
+  std::vector< Ref<Pair> > possibleRightPairs_;
+
+  static void addOrTally(std::vector< Ref<Pair> >& possiblePairs, Ref<Pair> pair);
+  static Ref<Result> constructResult(Ref<Pair> leftPair, Ref<Pair> rightPair);
+  static bool checkChecksum(Ref<Pair> leftPair, Ref<Pair> rightPair);
+
+  Ref<Pair> decodePair(Ref<BitArray> const& row, bool right, int rowNumber);
+  Ref<DataCharacter> decodeDataCharacter(Ref<BitArray> const& row,
+                                         Ref<FinderPattern> pattern,
+                                         bool outsideChar);
+  bool findFinderPattern(Ref<BitArray> const& row, bool rightFinderPattern, int startEnd[2]);
+  Ref<FinderPattern> parseFoundFinderPattern(Ref<BitArray> const& row, int rowNumber,
+                                             bool right, int const startEnd[2]);
+  void adjustOddEvenCounts(bool outsideChar, int numModules);
+
+public:
+  RSS14Reader();
+
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
+  void reset();
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,35 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/FinderPattern.h>
+#include <zxing/oned/OneDResultPoint.h>
+
+using zxing::oned::OneDResultPoint;
+using zxing::oned::rss::FinderPattern;
+
+// VC++
+using zxing::Ref;
+using zxing::ResultPoint;
+
+FinderPattern::FinderPattern(int value, int startPos, int endPos,
+                             int start, int end, int rowNumber) :
+  value_(value), resultPoints_(2) {
+  startEnd_[0] = startPos;
+  startEnd_[1] = endPos;
+  resultPoints_[0] = Ref<ResultPoint>(new OneDResultPoint((float) start, (float) rowNumber));
+  resultPoints_[1] = Ref<ResultPoint>(new OneDResultPoint((float) end, (float) rowNumber));
+}
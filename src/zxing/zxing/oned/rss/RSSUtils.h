@@ -0,0 +1,43 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RSS_UTILS_H__
+#define __RSS_UTILS_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/** Adapted from listings in ISO/IEC 24724 Appendix B and Appendix G. */
+class RSSUtils {
+private:
+  RSSUtils();
+
+public:
+  static int getRSSvalue(std::vector<int> const& widths, int maxWidth, bool noNarrow);
+
+private:
+  static int combins(int n, int r);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,59 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/BitArrayBuilder.h>
+
+using std::vector;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::oned::rss::BitArrayBuilder;
+using zxing::oned::rss::ExpandedPair;
+
+namespace {
+
+void appendValue(Ref<BitArray> const& binary, int& accPos, int value) {
+  for (int i = 11; i >= 0; --i) {
+    if ((value & (1 << i)) != 0) {
+      binary->set(accPos);
+    }
+    accPos++;
+  }
+}
+
+}
+
+Ref<BitArray> BitArrayBuilder::buildBitArray(vector< Ref<ExpandedPair> > const& pairs) {
+  int charNumber = (pairs.size() * 2) - 1;
+  if (!pairs.back()->getRightChar()) {
+    charNumber -= 1;
+  }
+
+  int size = 12 * charNumber;
+  Ref<BitArray> binary(new BitArray(size));
+  int accPos = 0;
+
+  appendValue(binary, accPos, pairs[0]->getRightChar()->getValue());
+
+  for (size_t i = 1; i < pairs.size(); ++i) {
+    Ref<ExpandedPair> currentPair = pairs[i];
+    appendValue(binary, accPos, currentPair->getLeftChar()->getValue());
+    if (currentPair->getRightChar()) {
+      appendValue(binary, accPos, currentPair->getRightChar()->getValue());
+    }
+  }
+  return binary;
+}
@@ -0,0 +1,45 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __BIT_ARRAY_BUILDER_H__
+#define __BIT_ARRAY_BUILDER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/common/BitArray.h>
+#include <zxing/oned/rss/expanded/ExpandedPair.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/**
+ * Concatenates the 12-bit values of the data characters, skipping the
+ * check character, into the bit stream the expanded decoders read.
+ */
+class BitArrayBuilder {
+private:
+  BitArrayBuilder();
+
+public:
+  static Ref<BitArray> buildBitArray(std::vector< Ref<ExpandedPair> > const& pairs);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,82 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __EXPANDED_PAIR_H__
+#define __EXPANDED_PAIR_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/DataCharacter.h>
+#include <zxing/oned/rss/FinderPattern.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class ExpandedPair : public Counted {
+private:
+  Ref<DataCharacter> leftChar_;
+  Ref<DataCharacter> rightChar_;
+  Ref<FinderPattern> finderPattern_;
+  bool mayBeLast_;
+
+  template <typename T>
+  static bool sameRef(Ref<T> const& a, Ref<T> const& b) {
+    if (!a || !b) {
+      return !a && !b;
+    }
+    return a->equals(*b);
+  }
+
+public:
+  ExpandedPair(Ref<DataCharacter> leftChar,
+               Ref<DataCharacter> rightChar,
+               Ref<FinderPattern> finderPattern,
+               bool mayBeLast) :
+    leftChar_(leftChar), rightChar_(rightChar),
+    finderPattern_(finderPattern), mayBeLast_(mayBeLast) {}
+
+  bool mayBeLast() const {
+    return mayBeLast_;
+  }
+
+  Ref<DataCharacter> getLeftChar() const {
+    return leftChar_;
+  }
+
+  Ref<DataCharacter> getRightChar() const {
+    return rightChar_;
+  }
+
+  Ref<FinderPattern> getFinderPattern() const {
+    return finderPattern_;
+  }
+
+  bool mustBeLast() const {
+    return !rightChar_;
+  }
+
+  bool equals(ExpandedPair const& other) const {
+    return sameRef(leftChar_, other.leftChar_) &&
+      sameRef(rightChar_, other.rightChar_) &&
+      sameRef(finderPattern_, other.finderPattern_);
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,70 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __EXPANDED_ROW_H__
+#define __EXPANDED_ROW_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/oned/rss/expanded/ExpandedPair.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/**
+ * One row of a stacked RSS Expanded symbol.
+ */
+class ExpandedRow : public Counted {
+private:
+  std::vector< Ref<ExpandedPair> > pairs_;
+  int rowNumber_;
+  bool wasReversed_;
+
+public:
+  ExpandedRow(std::vector< Ref<ExpandedPair> > const& pairs, int rowNumber, bool wasReversed) :
+    pairs_(pairs), rowNumber_(rowNumber), wasReversed_(wasReversed) {}
+
+  std::vector< Ref<ExpandedPair> > const& getPairs() const {
+    return pairs_;
+  }
+
+  int getRowNumber() const {
+    return rowNumber_;
+  }
+
+  bool isReversed() const {
+    return wasReversed_;
+  }
+
+  bool isEquivalent(std::vector< Ref<ExpandedPair> > const& otherPairs) const {
+    if (pairs_.size() != otherPairs.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < pairs_.size(); i++) {
+      if (!pairs_[i]->equals(*otherPairs[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+}
+}
+}
+
+#endif
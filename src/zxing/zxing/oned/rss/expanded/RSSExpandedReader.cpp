@@ -0,0 +1,712 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/ZXing.h>
+#include <zxing/oned/rss/expanded/RSSExpandedReader.h>
+#include <zxing/oned/rss/expanded/BitArrayBuilder.h>
+#include <zxing/oned/rss/expanded/decoders/AbstractExpandedDecoder.h>
+#include <zxing/oned/rss/RSSUtils.h>
+#include <zxing/NotFoundException.h>
+#include <zxing/BarcodeFormat.h>
+#include <algorithm>
+#include <cmath>
+
+using std::vector;
+using std::string;
+using zxing::NotFoundException;
+using zxing::Ref;
+using zxing::Result;
+using zxing::oned::rss::RSSExpandedReader;
+using zxing::oned::rss::AbstractExpandedDecoder;
+using zxing::oned::rss::BitArrayBuilder;
+using zxing::oned::rss::DataCharacter;
+using zxing::oned::rss::ExpandedPair;
+using zxing::oned::rss::ExpandedRow;
+using zxing::oned::rss::FinderPattern;
+using zxing::oned::rss::RSSUtils;
+
+// VC++
+using zxing::ArrayRef;
+using zxing::BitArray;
+using zxing::DecodeHints;
+using zxing::ResultPoint;
+
+namespace {
+
+const int SYMBOL_WIDEST[] = {7, 5, 4, 3, 1};
+const int EVEN_TOTAL_SUBSET[] = {4, 20, 52, 104, 204};
+const int GSUM[] = {0, 348, 1388, 2948, 3988};
+
+const int FINDER_PATTERNS[][4] = {
+  {1,8,4,1}, // A
+  {3,6,4,1}, // B
+  {3,4,6,1}, // C
+  {3,2,8,1}, // D
+  {2,6,5,1}, // E
+  {2,2,9,1}  // F
+};
+
+const int WEIGHTS[][8] = {
+  {  1,   3,   9,  27,  81,  32,  96,  77},
+  { 20,  60, 180, 118, 143,   7,  21,  63},
+  {189, 145,  13,  39, 117, 140, 209, 205},
+  {193, 157,  49, 147,  19,  57, 171,  91},
+  { 62, 186, 136, 197, 169,  85,  44, 132},
+  {185, 133, 188, 142,   4,  12,  36, 108},
+  {113, 128, 173,  97,  80,  29,  87,  50},
+  {150,  28,  84,  41, 123, 158,  52, 156},
+  { 46, 138, 203, 187, 139, 206, 196, 166},
+  { 76,  17,  51, 153,  37, 111, 122, 155},
+  { 43, 129, 176, 106, 107, 110, 119, 146},
+  { 16,  48, 144,  10,  30,  90,  59, 177},
+  {109, 116, 137, 200, 178, 112, 125, 164},
+  { 70, 210, 208, 202, 184, 130, 179, 115},
+  {134, 191, 151,  31,  93,  68, 204, 190},
+  {148,  22,  66, 198, 172,  94,  71,   2},
+  {  6,  18,  54, 162,  64, 192, 154,  40},
+  {120, 149,  25,  75,  14,  42, 126, 167},
+  { 79,  26,  78,  23,  69, 207, 199, 175},
+  {103,  98,  83,  38, 114, 131, 182, 124},
+  {161,  61, 183, 127, 170,  88,  53, 159},
+  { 55, 165,  73,   8,  24,  72,   5,  15},
+  { 45, 135, 194, 160,  58, 174, 100,  89},
+};
+
+const int FINDER_PAT_A = 0;
+const int FINDER_PAT_B = 1;
+const int FINDER_PAT_C = 2;
+const int FINDER_PAT_D = 3;
+const int FINDER_PAT_E = 4;
+const int FINDER_PAT_F = 5;
+
+// Terminated by -1, the longest sequence has MAX_PAIRS entries
+const int FINDER_PATTERN_SEQUENCES[][12] = {
+  { FINDER_PAT_A, FINDER_PAT_A, -1 },
+  { FINDER_PAT_A, FINDER_PAT_B, FINDER_PAT_B, -1 },
+  { FINDER_PAT_A, FINDER_PAT_C, FINDER_PAT_B, FINDER_PAT_D, -1 },
+  { FINDER_PAT_A, FINDER_PAT_E, FINDER_PAT_B, FINDER_PAT_D, FINDER_PAT_C, -1 },
+  { FINDER_PAT_A, FINDER_PAT_E, FINDER_PAT_B, FINDER_PAT_D, FINDER_PAT_D, FINDER_PAT_F, -1 },
+  { FINDER_PAT_A, FINDER_PAT_E, FINDER_PAT_B, FINDER_PAT_D, FINDER_PAT_E, FINDER_PAT_F, FINDER_PAT_F, -1 },
+  { FINDER_PAT_A, FINDER_PAT_A, FINDER_PAT_B, FINDER_PAT_B, FINDER_PAT_C, FINDER_PAT_C, FINDER_PAT_D, FINDER_PAT_D, -1 },
+  { FINDER_PAT_A, FINDER_PAT_A, FINDER_PAT_B, FINDER_PAT_B, FINDER_PAT_C, FINDER_PAT_C, FINDER_PAT_D, FINDER_PAT_E, FINDER_PAT_E, -1 },
+  { FINDER_PAT_A, FINDER_PAT_A, FINDER_PAT_B, FINDER_PAT_B, FINDER_PAT_C, FINDER_PAT_C, FINDER_PAT_D, FINDER_PAT_E, FINDER_PAT_F, FINDER_PAT_F, -1 },
+  { FINDER_PAT_A, FINDER_PAT_A, FINDER_PAT_B, FINDER_PAT_B, FINDER_PAT_C, FINDER_PAT_D, FINDER_PAT_D, FINDER_PAT_E, FINDER_PAT_E, FINDER_PAT_F, FINDER_PAT_F, -1 },
+};
+
+bool containsPair(vector< Ref<ExpandedPair> > const& pairs, Ref<ExpandedPair> const& pair) {
+  for (size_t i = 0; i < pairs.size(); i++) {
+    if (pairs[i]->equals(*pair)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}
+
+RSSExpandedReader::RSSExpandedReader() : startFromEven_(false) {
+  pairs_.reserve(MAX_PAIRS);
+  startEnd_[0] = 0;
+  startEnd_[1] = 0;
+}
+
+Ref<Result> RSSExpandedReader::decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& /* hints */) {
+  // Rows can start with even pattern in case in prev rows there where odd number of patters.
+  // So lets try twice
+  pairs_.clear();
+  startFromEven_ = false;
+  try {
+    return constructResult(decodeRow2pairs(rowNumber, row));
+  } catch (NotFoundException const& e) {
+    (void)e;
+    // OK
+  }
+
+  pairs_.clear();
+  startFromEven_ = true;
+  return constructResult(decodeRow2pairs(rowNumber, row));
+}
+
+void RSSExpandedReader::reset() {
+  pairs_.clear();
+  rows_.clear();
+}
+
+vector< Ref<ExpandedPair> > const& RSSExpandedReader::decodeRow2pairs(int rowNumber, Ref<BitArray> const& row) {
+  while (true) {
+    try {
+      Ref<ExpandedPair> nextPair = retrieveNextPair(row, pairs_, rowNumber);
+      pairs_.push_back(nextPair);
+    } catch (NotFoundException const& nfe) {
+      if (pairs_.empty()) {
+        throw;
+      }
+      (void)nfe;
+      // exit this loop when retrieveNextPair() fails and throws
+      break;
+    }
+  }
+
+  if (checkChecksum()) {
+    return pairs_;
+  }
+
+  bool tryStackedDecode = !rows_.empty();
+  storeRow(rowNumber, false);
+  if (tryStackedDecode) {
+    // When the image is 180-rotated, then rows are sorted in wrong direction.
+    // Try twice with both the directions.
+    if (checkRows(false) || checkRows(true)) {
+      return pairs_;
+    }
+  }
+
+  throw NotFoundException();
+}
+
+bool RSSExpandedReader::checkRows(bool reverse) {
+  // Limit number of rows we are checking
+  // We use recursive algorithm with pure complexity and don't want it to take forever
+  // Stacked barcode can have up to 11 rows, so 25 seems reasonable enough
+  if (rows_.size() > 25) {
+    rows_.clear(); // We will never have a chance to get result, so clear it
+    return false;
+  }
+
+  pairs_.clear();
+  if (reverse) {
+    std::reverse(rows_.begin(), rows_.end());
+  }
+
+  bool found = checkRows(vector< Ref<ExpandedRow> >(), 0);
+
+  if (reverse) {
+    std::reverse(rows_.begin(), rows_.end());
+  }
+
+  return found;
+}
+
+// Try to construct a valid rows sequence
+// Recursion is used to implement backtracking
+bool RSSExpandedReader::checkRows(vector< Ref<ExpandedRow> > const& collectedRows, int currentRow) {
+  for (size_t i = currentRow; i < rows_.size(); i++) {
+    Ref<ExpandedRow> row = rows_[i];
+    pairs_.clear();
+    for (size_t j = 0; j < collectedRows.size(); j++) {
+      vector< Ref<ExpandedPair> > const& collectedPairs = collectedRows[j]->getPairs();
+      pairs_.insert(pairs_.end(), collectedPairs.begin(), collectedPairs.end());
+    }
+    pairs_.insert(pairs_.end(), row->getPairs().begin(), row->getPairs().end());
+
+    if (!isValidSequence(pairs_)) {
+      continue;
+    }
+
+    if (checkChecksum()) {
+      return true;
+    }
+
+    vector< Ref<ExpandedRow> > rs(collectedRows);
+    rs.push_back(row);
+    // Recursion: try to add more rows
+    if (checkRows(rs, i + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether the pairs form a valid find pattern sequence,
+// either complete or a prefix
+bool RSSExpandedReader::isValidSequence(vector< Ref<ExpandedPair> > const& pairs) {
+  for (int i = 0; i < ZXING_ARRAY_LEN(FINDER_PATTERN_SEQUENCES); i++) {
+    int const* sequence = FINDER_PATTERN_SEQUENCES[i];
+    bool stop = true;
+    for (size_t j = 0; j < pairs.size(); j++) {
+      if (sequence[j] < 0 || pairs[j]->getFinderPattern()->getValue() != sequence[j]) {
+        stop = false;
+        break;
+      }
+    }
+    if (stop) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RSSExpandedReader::storeRow(int rowNumber, bool wasReversed) {
+  // Discard if duplicate above or below; otherwise insert in order by row number.
+  size_t insertPos = 0;
+  bool prevIsSame = false;
+  bool nextIsSame = false;
+  while (insertPos < rows_.size()) {
+    Ref<ExpandedRow> erow = rows_[insertPos];
+    if (erow->getRowNumber() > rowNumber) {
+      nextIsSame = erow->isEquivalent(pairs_);
+      break;
+    }
+    prevIsSame = erow->isEquivalent(pairs_);
+    insertPos++;
+  }
+  if (nextIsSame || prevIsSame) {
+    return;
+  }
+
+  // When the row was partially decoded (e.g. 2 pairs found instead of 3),
+  // it will prevent us from detecting the barcode.
+  // Try to merge partial rows
+
+  // Check whether the row is part of an already detected row
+  if (isPartialRow(pairs_, rows_)) {
+    return;
+  }
+
+  rows_.insert(rows_.begin() + insertPos, Ref<ExpandedRow>(new ExpandedRow(pairs_, rowNumber, wasReversed)));
+
+  removePartialRows(pairs_, rows_);
+}
+
+// Remove all the rows that contains only specified pairs
+void RSSExpandedReader::removePartialRows(vector< Ref<ExpandedPair> > const& pairs,
+                                          vector< Ref<ExpandedRow> >& rows) {
+  for (vector< Ref<ExpandedRow> >::iterator it = rows.begin(); it != rows.end();) {
+    vector< Ref<ExpandedPair> > const& rowPairs = (*it)->getPairs();
+    bool allFound = rowPairs.size() != pairs.size();
+    for (size_t i = 0; allFound && i < rowPairs.size(); i++) {
+      allFound = containsPair(pairs, rowPairs[i]);
+    }
+    if (allFound) {
+      it = rows.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+// Returns true when one of the rows already contains all the pairs
+bool RSSExpandedReader::isPartialRow(vector< Ref<ExpandedPair> > const& pairs,
+                                     vector< Ref<ExpandedRow> > const& rows) {
+  for (size_t r = 0; r < rows.size(); r++) {
+    bool allFound = true;
+    for (size_t i = 0; allFound && i < pairs.size(); i++) {
+      allFound = containsPair(rows[r]->getPairs(), pairs[i]);
+    }
+    if (allFound) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Ref<Result> RSSExpandedReader::constructResult(vector< Ref<ExpandedPair> > const& pairs) {
+  Ref<BitArray> binary = BitArrayBuilder::buildBitArray(pairs);
+
+  Ref<AbstractExpandedDecoder> decoder = AbstractExpandedDecoder::createDecoder(binary);
+  string resultingString = decoder->parseInformation();
+
+  ArrayRef< Ref<ResultPoint> > firstPoints = pairs.front()->getFinderPattern()->getResultPoints();
+  ArrayRef< Ref<ResultPoint> > lastPoints = pairs.back()->getFinderPattern()->getResultPoints();
+
+  ArrayRef< Ref<ResultPoint> > resultPoints(4);
+  resultPoints[0] = firstPoints[0];
+  resultPoints[1] = firstPoints[1];
+  resultPoints[2] = lastPoints[0];
+  resultPoints[3] = lastPoints[1];
+  return Ref<Result>(new Result(Ref<String>(new String(resultingString)), ArrayRef<byte>(),
+                                resultPoints, BarcodeFormat::RSS_EXPANDED));
+}
+
+bool RSSExpandedReader::checkChecksum() {
+  Ref<ExpandedPair> firstPair = pairs_[0];
+  Ref<DataCharacter> checkCharacter = firstPair->getLeftChar();
+  Ref<DataCharacter> firstCharacter = firstPair->getRightChar();
+
+  if (!firstCharacter) {
+    return false;
+  }
+
+  int checksum = firstCharacter->getChecksumPortion();
+  int s = 2;
+
+  for (size_t i = 1; i < pairs_.size(); ++i) {
+    Ref<ExpandedPair> currentPair = pairs_[i];
+    checksum += currentPair->getLeftChar()->getChecksumPortion();
+    s++;
+    Ref<DataCharacter> currentRightChar = currentPair->getRightChar();
+    if (currentRightChar) {
+      checksum += currentRightChar->getChecksumPortion();
+      s++;
+    }
+  }
+
+  checksum %= 211;
+
+  int checkCharacterValue = 211 * (s - 4) + checksum;
+
+  return checkCharacterValue == checkCharacter->getValue();
+}
+
+int RSSExpandedReader::getNextSecondBar(Ref<BitArray> const& row, int initialPos) {
+  int currentPos;
+  if (row->get(initialPos)) {
+    currentPos = row->getNextUnset(initialPos);
+    currentPos = row->getNextSet(currentPos);
+  } else {
+    currentPos = row->getNextSet(initialPos);
+    currentPos = row->getNextUnset(currentPos);
+  }
+  return currentPos;
+}
+
+Ref<ExpandedPair> RSSExpandedReader::retrieveNextPair(Ref<BitArray> const& row,
+                                                      vector< Ref<ExpandedPair> > const& previousPairs,
+                                                      int rowNumber) {
+  bool isOddPattern = previousPairs.size() % 2 == 0;
+  if (startFromEven_) {
+    isOddPattern = !isOddPattern;
+  }
+
+  Ref<FinderPattern> pattern;
+  int forcedOffset = -1;
+  do {
+    findNextPair(row, previousPairs, forcedOffset);
+    pattern = parseFoundFinderPattern(row, rowNumber, isOddPattern);
+    if (!pattern) {
+      forcedOffset = getNextSecondBar(row, startEnd_[0]);
+    }
+  } while (!pattern);
+
+  // When stacked symbol is split over multiple rows, there's no way to guess if this pair can be last or not.
+
+  Ref<DataCharacter> leftChar = decodeDataCharacter(row, pattern, isOddPattern, true);
+
+  if (!previousPairs.empty() && previousPairs.back()->mustBeLast()) {
+    throw NotFoundException();
+  }
+
+  Ref<DataCharacter> rightChar;
+  try {
+    rightChar = decodeDataCharacter(row, pattern, isOddPattern, false);
+  } catch (NotFoundException const& ignored) {
+    (void)ignored;
+  }
+  return Ref<ExpandedPair>(new ExpandedPair(leftChar, rightChar, pattern, true));
+}
+
+void RSSExpandedReader::findNextPair(Ref<BitArray> const& row,
+                                     vector< Ref<ExpandedPair> > const& previousPairs,
+                                     int forcedOffset) {
+  vector<int>& counters = decodeFinderCounters_;
+  counters[0] = 0;
+  counters[1] = 0;
+  counters[2] = 0;
+  counters[3] = 0;
+
+  int width = row->getSize();
+
+  int rowOffset;
+  if (forcedOffset >= 0) {
+    rowOffset = forcedOffset;
+  } else if (previousPairs.empty()) {
+    rowOffset = 0;
+  } else {
+    rowOffset = previousPairs.back()->getFinderPattern()->getStartEnd()[1];
+  }
+  bool searchingEvenPair = previousPairs.size() % 2 != 0;
+  if (startFromEven_) {
+    searchingEvenPair = !searchingEvenPair;
+  }
+
+  bool isWhite = false;
+  while (rowOffset < width) {
+    isWhite = !row->get(rowOffset);
+    if (!isWhite) {
+      break;
+    }
+    rowOffset++;
+  }
+
+  int counterPosition = 0;
+  int patternStart = rowOffset;
+  for (int x = rowOffset; x < width; x++) {
+    if (row->get(x) ^ isWhite) {
+      counters[counterPosition]++;
+    } else {
+      if (counterPosition == 3) {
+        if (searchingEvenPair) {
+          reverseCounters(counters);
+        }
+
+        if (isFinderPattern(counters)) {
+          startEnd_[0] = patternStart;
+          startEnd_[1] = x;
+          return;
+        }
+
+        if (searchingEvenPair) {
+          reverseCounters(counters);
+        }
+
+        patternStart += counters[0] + counters[1];
+        counters[0] = counters[2];
+        counters[1] = counters[3];
+        counters[2] = 0;
+        counters[3] = 0;
+        counterPosition--;
+      } else {
+        counterPosition++;
+      }
+      counters[counterPosition] = 1;
+      isWhite = !isWhite;
+    }
+  }
+  throw NotFoundException();
+}
+
+void RSSExpandedReader::reverseCounters(vector<int>& counters) {
+  std::reverse(counters.begin(), counters.end());
+}
+
+Ref<FinderPattern> RSSExpandedReader::parseFoundFinderPattern(Ref<BitArray> const& row, int rowNumber,
+                                                              bool oddPattern) {
+  // Actually we found elements 2-5.
+  int firstCounter;
+  int start;
+  int end;
+
+  if (oddPattern) {
+    // If pattern number is odd, we need to locate element 1 *before* the current block.
+
+    int firstElementStart = startEnd_[0] - 1;
+    // Locate element 1
+    while (firstElementStart >= 0 && !row->get(firstElementStart)) {
+      firstElementStart--;
+    }
+
+    firstElementStart++;
+    firstCounter = startEnd_[0] - firstElementStart;
+    start = firstElementStart;
+    end = startEnd_[1];
+  } else {
+    // If pattern number is even, the pattern is reversed, so we need to locate element 1 *after* the current block.
+
+    start = startEnd_[0];
+
+    end = row->getNextUnset(startEnd_[1] + 1);
+    firstCounter = end - startEnd_[1];
+  }
+
+  // Make 'counters' hold 1-4
+  vector<int>& counters = decodeFinderCounters_;
+  for (int i = counters.size() - 1; i > 0; i--) {
+    counters[i] = counters[i - 1];
+  }
+
+  counters[0] = firstCounter;
+  int value;
+  try {
+    value = parseFinderValue(counters, FINDER_PATTERNS, ZXING_ARRAY_LEN(FINDER_PATTERNS));
+  } catch (NotFoundException const& ignored) {
+    (void)ignored;
+    return Ref<FinderPattern>();
+  }
+  return Ref<FinderPattern>(new FinderPattern(value, start, end, start, end, rowNumber));
+}
+
+Ref<DataCharacter> RSSExpandedReader::decodeDataCharacter(Ref<BitArray> const& row,
+                                                          Ref<FinderPattern> pattern,
+                                                          bool isOddPattern,
+                                                          bool leftChar) {
+  vector<int>& counters = dataCharacterCounters_;
+  std::fill(counters.begin(), counters.end(), 0);
+
+  if (leftChar) {
+    recordPatternInReverse(row, pattern->getStartEnd()[0], counters);
+  } else {
+    recordPattern(row, pattern->getStartEnd()[1], counters);
+    // reverse it
+    std::reverse(counters.begin(), counters.end());
+  } // counters[] has the pixels of the module
+
+  int numModules = 17; // left and right data characters have all the same length
+  float elementWidth = (float) count(counters) / (float) numModules;
+
+  // Sanity check: element width for pattern and the character should match
+  float expectedElementWidth = (pattern->getStartEnd()[1] - pattern->getStartEnd()[0]) / 15.0f;
+  if (std::abs(elementWidth - expectedElementWidth) / expectedElementWidth > 0.3f) {
+    throw NotFoundException();
+  }
+
+  for (size_t i = 0; i < counters.size(); i++) {
+    float value = 1.0f * counters[i] / elementWidth;
+    int count = (int) (value + 0.5f); // Round
+    if (count < 1) {
+      if (value < 0.3f) {
+        throw NotFoundException();
+      }
+      count = 1;
+    } else if (count > 8) {
+      if (value > 8.7f) {
+        throw NotFoundException();
+      }
+      count = 8;
+    }
+    int offset = i / 2;
+    if ((i & 0x01) == 0) {
+      oddCounts_[offset] = count;
+      oddRoundingErrors_[offset] = value - count;
+    } else {
+      evenCounts_[offset] = count;
+      evenRoundingErrors_[offset] = value - count;
+    }
+  }
+
+  adjustOddEvenCounts(numModules);
+
+  int weightRowNumber = 4 * pattern->getValue() + (isOddPattern ? 0 : 2) + (leftChar ? 0 : 1) - 1;
+  bool weighted = isNotA1left(pattern, isOddPattern, leftChar);
+
+  int oddSum = 0;
+  int oddChecksumPortion = 0;
+  for (int i = oddCounts_.size() - 1; i >= 0; i--) {
+    if (weighted) {
+      int weight = WEIGHTS[weightRowNumber][2 * i];
+      oddChecksumPortion += oddCounts_[i] * weight;
+    }
+    oddSum += oddCounts_[i];
+  }
+  int evenChecksumPortion = 0;
+  for (int i = evenCounts_.size() - 1; i >= 0; i--) {
+    if (weighted) {
+      int weight = WEIGHTS[weightRowNumber][2 * i + 1];
+      evenChecksumPortion += evenCounts_[i] * weight;
+    }
+  }
+  int checksumPortion = oddChecksumPortion + evenChecksumPortion;
+
+  if ((oddSum & 0x01) != 0 || oddSum > 13 || oddSum < 4) {
+    throw NotFoundException();
+  }
+
+  int group = (13 - oddSum) / 2;
+  int oddWidest = SYMBOL_WIDEST[group];
+  int evenWidest = 9 - oddWidest;
+  int vOdd = RSSUtils::getRSSvalue(oddCounts_, oddWidest, true);
+  int vEven = RSSUtils::getRSSvalue(evenCounts_, evenWidest, false);
+  int tEven = EVEN_TOTAL_SUBSET[group];
+  int gSum = GSUM[group];
+  int value = vOdd * tEven + vEven + gSum;
+
+  return Ref<DataCharacter>(new DataCharacter(value, checksumPortion));
+}
+
+bool RSSExpandedReader::isNotA1left(Ref<FinderPattern> pattern, bool isOddPattern, bool leftChar) {
+  // A1: pattern.getValue is 0 (A), and it's an oddPattern, and it is a left char
+  return !(pattern->getValue() == 0 && isOddPattern && leftChar);
+}
+
+void RSSExpandedReader::adjustOddEvenCounts(int numModules) {
+  int oddSum = count(oddCounts_);
+  int evenSum = count(evenCounts_);
+
+  bool incrementOdd = false;
+  bool decrementOdd = false;
+  bool incrementEven = false;
+  bool decrementEven = false;
+
+  if (oddSum > 13) {
+    decrementOdd = true;
+  } else if (oddSum < 4) {
+    incrementOdd = true;
+  }
+  if (evenSum > 13) {
+    decrementEven = true;
+  } else if (evenSum < 4) {
+    incrementEven = true;
+  }
+
+  int mismatch = oddSum + evenSum - numModules;
+  bool oddParityBad = (oddSum & 0x01) == 1;
+  bool evenParityBad = (evenSum & 0x01) == 0;
+  if (mismatch == 1) {
+    if (oddParityBad) {
+      if (evenParityBad) {
+        throw NotFoundException();
+      }
+      decrementOdd = true;
+    } else {
+      if (!evenParityBad) {
+        throw NotFoundException();
+      }
+      decrementEven = true;
+    }
+  } else if (mismatch == -1) {
+    if (oddParityBad) {
+      if (evenParityBad) {
+        throw NotFoundException();
+      }
+      incrementOdd = true;
+    } else {
+      if (!evenParityBad) {
+        throw NotFoundException();
+      }
+      incrementEven = true;
+    }
+  } else if (mismatch == 0) {
+    if (oddParityBad) {
+      if (!evenParityBad) {
+        throw NotFoundException();
+      }
+      // Both bad
+      if (oddSum < evenSum) {
+        incrementOdd = true;
+        decrementEven = true;
+      } else {
+        decrementOdd = true;
+        incrementEven = true;
+      }
+    } else {
+      if (evenParityBad) {
+        throw NotFoundException();
+      }
+      // Nothing to do!
+    }
+  } else {
+    throw NotFoundException();
+  }
+
+  if (incrementOdd) {
+    if (decrementOdd) {
+      throw NotFoundException();
+    }
+    increment(oddCounts_, oddRoundingErrors_);
+  }
+  if (decrementOdd) {
+    decrement(oddCounts_, oddRoundingErrors_);
+  }
+  if (incrementEven) {
+    if (decrementEven) {
+      throw NotFoundException();
+    }
+    increment(evenCounts_, oddRoundingErrors_);
+  }
+  if (decrementEven) {
+    decrement(evenCounts_, evenRoundingErrors_);
+  }
+}
@@ -0,0 +1,85 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __RSS_EXPANDED_READER_H__
+#define __RSS_EXPANDED_READER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/AbstractRSSReader.h>
+#include <zxing/oned/rss/expanded/ExpandedPair.h>
+#include <zxing/oned/rss/expanded/ExpandedRow.h>
+#include <zxing/common/BitArray.h>
+#include <zxing/Result.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/**
+ * Decodes RSS Expanded (GS1 DataBar Expanded), including the stacked
+ * variant. Pairs found on each row are remembered until reset(), so a
+ * symbol split across several rows can be put back together.
+ */
+class RSSExpandedReader : public AbstractRSSReader {
+private:
+  static const int MAX_PAIRS = 11;
+
+  std::vector< Ref<ExpandedPair> > pairs_;
+  std::vector< Ref<ExpandedRow> > rows_;
+  int startEnd_[2];
+  bool startFromEven_;
+
+  std::vector< Ref<ExpandedPair> > const& decodeRow2pairs(int rowNumber, Ref<BitArray> const& row);
+  bool checkRows(bool reverse);
+  bool checkRows(std::vector< Ref<ExpandedRow> > const& collectedRows, int currentRow);
+  void storeRow(int rowNumber, bool wasReversed);
+  bool checkChecksum();
+
+  Ref<ExpandedPair> retrieveNextPair(Ref<BitArray> const& row,
+                                     std::vector< Ref<ExpandedPair> > const& previousPairs,
+                                     int rowNumber);
+  void findNextPair(Ref<BitArray> const& row,
+                    std::vector< Ref<ExpandedPair> > const& previousPairs,
+                    int forcedOffset);
+  Ref<FinderPattern> parseFoundFinderPattern(Ref<BitArray> const& row, int rowNumber, bool oddPattern);
+  Ref<DataCharacter> decodeDataCharacter(Ref<BitArray> const& row,
+                                         Ref<FinderPattern> pattern,
+                                         bool isOddPattern,
+                                         bool leftChar);
+  void adjustOddEvenCounts(int numModules);
+
+  static bool isValidSequence(std::vector< Ref<ExpandedPair> > const& pairs);
+  static bool isPartialRow(std::vector< Ref<ExpandedPair> > const& pairs,
+                           std::vector< Ref<ExpandedRow> > const& rows);
+  static void removePartialRows(std::vector< Ref<ExpandedPair> > const& pairs,
+                                std::vector< Ref<ExpandedRow> >& rows);
+  static Ref<Result> constructResult(std::vector< Ref<ExpandedPair> > const& pairs);
+  static int getNextSecondBar(Ref<BitArray> const& row, int initialPos);
+  static void reverseCounters(std::vector<int>& counters);
+  static bool isNotA1left(Ref<FinderPattern> pattern, bool isOddPattern, bool leftChar);
+
+public:
+  RSSExpandedReader();
+
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, DecodeHints const& hints);
+  void reset();
+};
+
+}
+}
+}
+
+#endif
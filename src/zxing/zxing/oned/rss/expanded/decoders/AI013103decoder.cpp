@@ -0,0 +1,33 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI013103decoder.h>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::oned::rss::AI013103decoder;
+
+AI013103decoder::AI013103decoder(Ref<BitArray> const& information) : AI013x0xDecoder(information) {}
+
+void AI013103decoder::addWeightCode(string& buf, int /* weight */) {
+  buf.append("(3103)");
+}
+
+int AI013103decoder::checkWeight(int weight) {
+  return weight;
+}
@@ -0,0 +1,64 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI01393xDecoder.h>
+#include <zxing/NotFoundException.h>
+#include <sstream>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::NotFoundException;
+using zxing::oned::rss::AI01393xDecoder;
+using zxing::oned::rss::DecodedInformation;
+
+AI01393xDecoder::AI01393xDecoder(Ref<BitArray> const& information) : AI01decoder(information) {}
+
+string AI01393xDecoder::parseInformation() {
+  if (getInformation()->getSize() < HEADER_SIZE + GTIN_SIZE) {
+    throw NotFoundException();
+  }
+
+  string buf;
+
+  encodeCompressedGtin(buf, HEADER_SIZE);
+
+  int lastAIdigit =
+      getGeneralDecoder().extractNumericValueFromBitArray(HEADER_SIZE + GTIN_SIZE, LAST_DIGIT_SIZE);
+
+  buf.append("(393");
+  buf.append(1, (char) ('0' + lastAIdigit));
+  buf.append(1, ')');
+
+  int firstThreeDigits = getGeneralDecoder().extractNumericValueFromBitArray(
+      HEADER_SIZE + GTIN_SIZE + LAST_DIGIT_SIZE, FIRST_THREE_DIGITS_SIZE);
+  std::ostringstream digits;
+  if (firstThreeDigits / 100 == 0) {
+    digits << '0';
+  }
+  if (firstThreeDigits / 10 == 0) {
+    digits << '0';
+  }
+  digits << firstThreeDigits;
+  buf.append(digits.str());
+
+  Ref<DecodedInformation> generalInformation = getGeneralDecoder().decodeGeneralPurposeField(
+      HEADER_SIZE + GTIN_SIZE + LAST_DIGIT_SIZE + FIRST_THREE_DIGITS_SIZE, string());
+  buf.append(generalInformation->getNewString());
+
+  return buf;
+}
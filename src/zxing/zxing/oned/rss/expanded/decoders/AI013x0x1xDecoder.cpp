@@ -0,0 +1,75 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI013x0x1xDecoder.h>
+#include <zxing/NotFoundException.h>
+#include <sstream>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::NotFoundException;
+using zxing::oned::rss::AI013x0x1xDecoder;
+
+AI013x0x1xDecoder::AI013x0x1xDecoder(Ref<BitArray> const& information,
+                                     string const& firstAIdigits,
+                                     string const& dateCode) :
+  AI01weightDecoder(information), dateCode_(dateCode), firstAIdigits_(firstAIdigits) {}
+
+string AI013x0x1xDecoder::parseInformation() {
+  if (getInformation()->getSize() != HEADER_SIZE + GTIN_SIZE + WEIGHT_SIZE + DATE_SIZE) {
+    throw NotFoundException();
+  }
+
+  string buf;
+
+  encodeCompressedGtin(buf, HEADER_SIZE);
+  encodeCompressedWeight(buf, HEADER_SIZE + GTIN_SIZE, WEIGHT_SIZE);
+  encodeCompressedDate(buf, HEADER_SIZE + GTIN_SIZE + WEIGHT_SIZE);
+
+  return buf;
+}
+
+void AI013x0x1xDecoder::encodeCompressedDate(string& buf, int currentPos) {
+  int numericDate = getGeneralDecoder().extractNumericValueFromBitArray(currentPos, DATE_SIZE);
+  if (numericDate == 38400) {
+    return;
+  }
+
+  int day = numericDate % 32;
+  numericDate /= 32;
+  int month = numericDate % 12 + 1;
+  numericDate /= 12;
+  int year = numericDate;
+
+  std::ostringstream date;
+  date << '(' << dateCode_ << ')';
+  date << (year / 10 == 0 ? "0" : "") << year;
+  date << (month / 10 == 0 ? "0" : "") << month;
+  date << (day / 10 == 0 ? "0" : "") << day;
+  buf.append(date.str());
+}
+
+void AI013x0x1xDecoder::addWeightCode(string& buf, int weight) {
+  std::ostringstream code;
+  code << '(' << firstAIdigits_ << weight / 100000 << ')';
+  buf.append(code.str());
+}
+
+int AI013x0x1xDecoder::checkWeight(int weight) {
+  return weight % 100000;
+}
@@ -0,0 +1,54 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __AI013X0X1X_DECODER_H__
+#define __AI013X0X1X_DECODER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI01weightDecoder.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class AI013x0x1xDecoder : public AI01weightDecoder {
+private:
+  static const int HEADER_SIZE = 7 + 1;
+  static const int WEIGHT_SIZE = 20;
+  static const int DATE_SIZE = 16;
+
+  std::string dateCode_;
+  std::string firstAIdigits_;
+
+  void encodeCompressedDate(std::string& buf, int currentPos);
+
+public:
+  AI013x0x1xDecoder(Ref<BitArray> const& information,
+                    std::string const& firstAIdigits,
+                    std::string const& dateCode);
+
+  std::string parseInformation();
+
+protected:
+  void addWeightCode(std::string& buf, int weight);
+  int checkWeight(int weight);
+};
+
+}
+}
+}
+
+#endif
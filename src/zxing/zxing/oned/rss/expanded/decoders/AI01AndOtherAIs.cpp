@@ -0,0 +1,36 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI01AndOtherAIs.h>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::oned::rss::AI01AndOtherAIs;
+
+AI01AndOtherAIs::AI01AndOtherAIs(Ref<BitArray> const& information) : AI01decoder(information) {}
+
+string AI01AndOtherAIs::parseInformation() {
+  string buff("(01)");
+  int initialGtinPosition = buff.length();
+  int firstGtinDigit = getGeneralDecoder().extractNumericValueFromBitArray(HEADER_SIZE, 4);
+  buff.append(1, (char) ('0' + firstGtinDigit));
+
+  encodeCompressedGtinWithoutAI(buff, HEADER_SIZE + 4, initialGtinPosition);
+
+  return getGeneralDecoder().decodeAllCodes(buff, HEADER_SIZE + 44);
+}
@@ -0,0 +1,67 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI01decoder.h>
+#include <sstream>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::oned::rss::AI01decoder;
+
+AI01decoder::AI01decoder(Ref<BitArray> const& information) : AbstractExpandedDecoder(information) {}
+
+void AI01decoder::encodeCompressedGtin(string& buf, int currentPos) {
+  buf.append("(01)");
+  int initialPosition = buf.length();
+  buf.append(1, '9');
+
+  encodeCompressedGtinWithoutAI(buf, currentPos, initialPosition);
+}
+
+void AI01decoder::encodeCompressedGtinWithoutAI(string& buf, int currentPos,
+                                                int initialBufferPosition) {
+  for (int i = 0; i < 4; ++i) {
+    int currentBlock = getGeneralDecoder().extractNumericValueFromBitArray(currentPos + 10 * i, 10);
+    std::ostringstream block;
+    if (currentBlock / 100 == 0) {
+      block << '0';
+    }
+    if (currentBlock / 10 == 0) {
+      block << '0';
+    }
+    block << currentBlock;
+    buf.append(block.str());
+  }
+
+  appendCheckDigit(buf, initialBufferPosition);
+}
+
+void AI01decoder::appendCheckDigit(string& buf, int currentPos) {
+  int checkDigit = 0;
+  for (int i = 0; i < 13; i++) {
+    int digit = buf[i + currentPos] - '0';
+    checkDigit += (i & 0x01) == 0 ? 3 * digit : digit;
+  }
+
+  checkDigit = 10 - (checkDigit % 10);
+  if (checkDigit == 10) {
+    checkDigit = 0;
+  }
+
+  buf.append(1, (char) ('0' + checkDigit));
+}
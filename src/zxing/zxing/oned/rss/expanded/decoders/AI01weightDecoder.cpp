@@ -0,0 +1,44 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AI01weightDecoder.h>
+#include <sstream>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::oned::rss::AI01weightDecoder;
+
+AI01weightDecoder::AI01weightDecoder(Ref<BitArray> const& information) : AI01decoder(information) {}
+
+void AI01weightDecoder::encodeCompressedWeight(string& buf, int currentPos, int weightSize) {
+  int originalWeightNumeric = getGeneralDecoder().extractNumericValueFromBitArray(currentPos, weightSize);
+  addWeightCode(buf, originalWeightNumeric);
+
+  int weightNumeric = checkWeight(originalWeightNumeric);
+
+  std::ostringstream weight;
+  int currentDivisor = 100000;
+  for (int i = 0; i < 5; ++i) {
+    if (weightNumeric / currentDivisor == 0) {
+      weight << '0';
+    }
+    currentDivisor /= 10;
+  }
+  weight << weightNumeric;
+  buf.append(weight.str());
+}
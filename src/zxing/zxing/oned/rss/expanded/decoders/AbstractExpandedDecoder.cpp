@@ -0,0 +1,94 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AbstractExpandedDecoder.h>
+#include <zxing/oned/rss/expanded/decoders/AI01AndOtherAIs.h>
+#include <zxing/oned/rss/expanded/decoders/AnyAIDecoder.h>
+#include <zxing/oned/rss/expanded/decoders/AI013103decoder.h>
+#include <zxing/oned/rss/expanded/decoders/AI01320xDecoder.h>
+#include <zxing/oned/rss/expanded/decoders/AI01392xDecoder.h>
+#include <zxing/oned/rss/expanded/decoders/AI01393xDecoder.h>
+#include <zxing/oned/rss/expanded/decoders/AI013x0x1xDecoder.h>
+#include <zxing/FormatException.h>
+
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::FormatException;
+using zxing::oned::rss::AbstractExpandedDecoder;
+using zxing::oned::rss::AI01AndOtherAIs;
+using zxing::oned::rss::AnyAIDecoder;
+using zxing::oned::rss::AI013103decoder;
+using zxing::oned::rss::AI01320xDecoder;
+using zxing::oned::rss::AI01392xDecoder;
+using zxing::oned::rss::AI01393xDecoder;
+using zxing::oned::rss::AI013x0x1xDecoder;
+using zxing::oned::rss::GeneralAppIdDecoder;
+
+AbstractExpandedDecoder::AbstractExpandedDecoder(Ref<BitArray> const& information) :
+  information_(information), generalDecoder_(information) {}
+
+AbstractExpandedDecoder::~AbstractExpandedDecoder() {}
+
+Ref<AbstractExpandedDecoder> AbstractExpandedDecoder::createDecoder(Ref<BitArray> const& information) {
+  if (information->get(1)) {
+    return Ref<AbstractExpandedDecoder>(new AI01AndOtherAIs(information));
+  }
+  if (!information->get(2)) {
+    return Ref<AbstractExpandedDecoder>(new AnyAIDecoder(information));
+  }
+
+  int fourBitEncodationMethod = GeneralAppIdDecoder::extractNumericValueFromBitArray(information, 1, 4);
+
+  switch (fourBitEncodationMethod) {
+  case 4:
+    return Ref<AbstractExpandedDecoder>(new AI013103decoder(information));
+  case 5:
+    return Ref<AbstractExpandedDecoder>(new AI01320xDecoder(information));
+  }
+
+  int fiveBitEncodationMethod = GeneralAppIdDecoder::extractNumericValueFromBitArray(information, 1, 5);
+  switch (fiveBitEncodationMethod) {
+  case 12:
+    return Ref<AbstractExpandedDecoder>(new AI01392xDecoder(information));
+  case 13:
+    return Ref<AbstractExpandedDecoder>(new AI01393xDecoder(information));
+  }
+
+  int sevenBitEncodationMethod = GeneralAppIdDecoder::extractNumericValueFromBitArray(information, 1, 7);
+  switch (sevenBitEncodationMethod) {
+  case 56:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "310", "11"));
+  case 57:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "320", "11"));
+  case 58:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "310", "13"));
+  case 59:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "320", "13"));
+  case 60:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "310", "15"));
+  case 61:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "320", "15"));
+  case 62:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "310", "17"));
+  case 63:
+    return Ref<AbstractExpandedDecoder>(new AI013x0x1xDecoder(information, "320", "17"));
+  }
+
+  // A damaged symbol can carry any method bits, so this is a format error
+  // rather than a programming one
+  throw FormatException("unknown RSS Expanded encodation method");
+}
@@ -0,0 +1,57 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ABSTRACT_EXPANDED_DECODER_H__
+#define __ABSTRACT_EXPANDED_DECODER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <zxing/common/BitArray.h>
+#include <zxing/oned/rss/expanded/decoders/GeneralAppIdDecoder.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class AbstractExpandedDecoder : public Counted {
+private:
+  Ref<BitArray> information_;
+  GeneralAppIdDecoder generalDecoder_;
+
+protected:
+  explicit AbstractExpandedDecoder(Ref<BitArray> const& information);
+
+  Ref<BitArray> getInformation() const {
+    return information_;
+  }
+
+  GeneralAppIdDecoder& getGeneralDecoder() {
+    return generalDecoder_;
+  }
+
+public:
+  virtual ~AbstractExpandedDecoder();
+
+  virtual std::string parseInformation() = 0;
+
+  static Ref<AbstractExpandedDecoder> createDecoder(Ref<BitArray> const& information);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,41 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ANY_AI_DECODER_H__
+#define __ANY_AI_DECODER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/AbstractExpandedDecoder.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class AnyAIDecoder : public AbstractExpandedDecoder {
+private:
+  static const int HEADER_SIZE = 2 + 1 + 2;
+
+public:
+  explicit AnyAIDecoder(Ref<BitArray> const& information);
+
+  std::string parseInformation();
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,51 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __BLOCK_PARSED_RESULT_H__
+#define __BLOCK_PARSED_RESULT_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/DecodedInformation.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class BlockParsedResult {
+private:
+  Ref<DecodedInformation> decodedInformation_;
+  bool finished_;
+
+public:
+  explicit BlockParsedResult(bool finished) : finished_(finished) {}
+
+  BlockParsedResult(Ref<DecodedInformation> information, bool finished) :
+    decodedInformation_(information), finished_(finished) {}
+
+  Ref<DecodedInformation> getDecodedInformation() const {
+    return decodedInformation_;
+  }
+
+  bool isFinished() const {
+    return finished_;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,80 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __CURRENT_PARSING_STATE_H__
+#define __CURRENT_PARSING_STATE_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class CurrentParsingState {
+private:
+  enum State {
+    NUMERIC,
+    ALPHA,
+    ISO_IEC_646
+  };
+
+  int position_;
+  State encoding_;
+
+public:
+  CurrentParsingState() : position_(0), encoding_(NUMERIC) {}
+
+  int getPosition() const {
+    return position_;
+  }
+
+  void setPosition(int position) {
+    position_ = position;
+  }
+
+  void incrementPosition(int delta) {
+    position_ += delta;
+  }
+
+  bool isAlpha() const {
+    return encoding_ == ALPHA;
+  }
+
+  bool isNumeric() const {
+    return encoding_ == NUMERIC;
+  }
+
+  bool isIsoIec646() const {
+    return encoding_ == ISO_IEC_646;
+  }
+
+  void setNumeric() {
+    encoding_ = NUMERIC;
+  }
+
+  void setAlpha() {
+    encoding_ = ALPHA;
+  }
+
+  void setIsoIec646() {
+    encoding_ = ISO_IEC_646;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,49 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DECODED_CHAR_H__
+#define __DECODED_CHAR_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/DecodedObject.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class DecodedChar : public DecodedObject {
+private:
+  char value_;
+
+public:
+  static const char FNC1 = '$'; // It's not in Alphanumeric neither in ISO/IEC 646 charset
+
+  DecodedChar(int newPosition, char value) : DecodedObject(newPosition), value_(value) {}
+
+  char getValue() const {
+    return value_;
+  }
+
+  bool isFNC1() const {
+    return value_ == FNC1;
+  }
+};
+
+}
+}
+}
+
+#endif
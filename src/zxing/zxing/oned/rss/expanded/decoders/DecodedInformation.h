@@ -0,0 +1,60 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DECODED_INFORMATION_H__
+#define __DECODED_INFORMATION_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <zxing/common/Counted.h>
+#include <zxing/oned/rss/expanded/decoders/DecodedObject.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class DecodedInformation : public Counted, public DecodedObject {
+private:
+  std::string newString_;
+  int remainingValue_;
+  bool remaining_;
+
+public:
+  DecodedInformation(int newPosition, std::string const& newString) :
+    DecodedObject(newPosition), newString_(newString), remainingValue_(0), remaining_(false) {}
+
+  DecodedInformation(int newPosition, std::string const& newString, int remainingValue) :
+    DecodedObject(newPosition), newString_(newString), remainingValue_(remainingValue),
+    remaining_(true) {}
+
+  std::string const& getNewString() const {
+    return newString_;
+  }
+
+  bool isRemaining() const {
+    return remaining_;
+  }
+
+  int getRemainingValue() const {
+    return remainingValue_;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,72 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DECODED_NUMERIC_H__
+#define __DECODED_NUMERIC_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/DecodedObject.h>
+#include <zxing/FormatException.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class DecodedNumeric : public DecodedObject {
+private:
+  int firstDigit_;
+  int secondDigit_;
+
+public:
+  static const int FNC1 = 10;
+
+  DecodedNumeric(int newPosition, int firstDigit, int secondDigit) :
+    DecodedObject(newPosition), firstDigit_(firstDigit), secondDigit_(secondDigit) {
+    if (firstDigit < 0 || firstDigit > 10 || secondDigit < 0 || secondDigit > 10) {
+      throw FormatException();
+    }
+  }
+
+  int getFirstDigit() const {
+    return firstDigit_;
+  }
+
+  int getSecondDigit() const {
+    return secondDigit_;
+  }
+
+  int getValue() const {
+    return firstDigit_ * 10 + secondDigit_;
+  }
+
+  bool isFirstDigitFNC1() const {
+    return firstDigit_ == FNC1;
+  }
+
+  bool isSecondDigitFNC1() const {
+    return secondDigit_ == FNC1;
+  }
+
+  bool isAnyFNC1() const {
+    return firstDigit_ == FNC1 || secondDigit_ == FNC1;
+  }
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,42 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __DECODED_OBJECT_H__
+#define __DECODED_OBJECT_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+class DecodedObject {
+private:
+  int newPosition_;
+
+protected:
+  explicit DecodedObject(int newPosition) : newPosition_(newPosition) {}
+
+public:
+  int getNewPosition() const {
+    return newPosition_;
+  }
+};
+
+}
+}
+}
+
+#endif
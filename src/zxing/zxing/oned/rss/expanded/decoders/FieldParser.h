@@ -0,0 +1,47 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __FIELD_PARSER_H__
+#define __FIELD_PARSER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/**
+ * Splits a run of GS1 element strings into "(AI)data" fields, using the
+ * known lengths of the application identifiers.
+ */
+class FieldParser {
+private:
+  FieldParser();
+
+  static std::string processFixedAI(int aiSize, int fieldSize, std::string const& rawInformation);
+  static std::string processVariableAI(int aiSize, int variableFieldSize,
+                                       std::string const& rawInformation);
+
+public:
+  static std::string parseFieldsInGeneralPurpose(std::string const& rawInformation);
+};
+
+}
+}
+}
+
+#endif
@@ -0,0 +1,361 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/rss/expanded/decoders/GeneralAppIdDecoder.h>
+#include <zxing/oned/rss/expanded/decoders/FieldParser.h>
+#include <zxing/FormatException.h>
+
+using std::string;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::FormatException;
+using zxing::oned::rss::GeneralAppIdDecoder;
+using zxing::oned::rss::FieldParser;
+using zxing::oned::rss::BlockParsedResult;
+using zxing::oned::rss::DecodedChar;
+using zxing::oned::rss::DecodedInformation;
+using zxing::oned::rss::DecodedNumeric;
+
+GeneralAppIdDecoder::GeneralAppIdDecoder(Ref<BitArray> const& information) : information_(information) {}
+
+string GeneralAppIdDecoder::decodeAllCodes(string& buff, int initialPosition) {
+  int currentPosition = initialPosition;
+  string remaining;
+  while (true) {
+    Ref<DecodedInformation> info = decodeGeneralPurposeField(currentPosition, remaining);
+    buff.append(FieldParser::parseFieldsInGeneralPurpose(info->getNewString()));
+    if (info->isRemaining()) {
+      remaining = string(1, (char) ('0' + info->getRemainingValue()));
+    } else {
+      remaining.clear();
+    }
+
+    if (currentPosition == info->getNewPosition()) { // No step forward!
+      break;
+    }
+    currentPosition = info->getNewPosition();
+  }
+  return buff;
+}
+
+bool GeneralAppIdDecoder::isStillNumeric(int pos) {
+  // It's numeric if it still has 7 positions
+  // and one of the first 4 bits is "1".
+  if (pos + 7 > information_->getSize()) {
+    return pos + 4 <= information_->getSize();
+  }
+
+  for (int i = pos; i < pos + 3; ++i) {
+    if (information_->get(i)) {
+      return true;
+    }
+  }
+  return information_->get(pos + 3);
+}
+
+DecodedNumeric GeneralAppIdDecoder::decodeNumeric(int pos) {
+  if (pos + 7 > information_->getSize()) {
+    int numeric = extractNumericValueFromBitArray(pos, 4);
+    if (numeric == 0) {
+      return DecodedNumeric(information_->getSize(), DecodedNumeric::FNC1, DecodedNumeric::FNC1);
+    }
+    return DecodedNumeric(information_->getSize(), numeric - 1, DecodedNumeric::FNC1);
+  }
+  int numeric = extractNumericValueFromBitArray(pos, 7);
+
+  int digit1 = (numeric - 8) / 11;
+  int digit2 = (numeric - 8) % 11;
+
+  return DecodedNumeric(pos + 7, digit1, digit2);
+}
+
+int GeneralAppIdDecoder::extractNumericValueFromBitArray(int pos, int bits) {
+  return extractNumericValueFromBitArray(information_, pos, bits);
+}
+
+int GeneralAppIdDecoder::extractNumericValueFromBitArray(Ref<BitArray> const& information, int pos, int bits) {
+  int value = 0;
+  for (int i = 0; i < bits; ++i) {
+    if (information->get(pos + i)) {
+      value |= 1 << (bits - i - 1);
+    }
+  }
+  return value;
+}
+
+Ref<DecodedInformation> GeneralAppIdDecoder::decodeGeneralPurposeField(int pos,
+                                                                       string const& remaining) {
+  buffer_ = remaining;
+  current_.setPosition(pos);
+
+  Ref<DecodedInformation> lastDecoded = parseBlocks();
+  if (lastDecoded && lastDecoded->isRemaining()) {
+    return Ref<DecodedInformation>(new DecodedInformation(current_.getPosition(), buffer_,
+                                                          lastDecoded->getRemainingValue()));
+  }
+  return Ref<DecodedInformation>(new DecodedInformation(current_.getPosition(), buffer_));
+}
+
+Ref<DecodedInformation> GeneralAppIdDecoder::parseBlocks() {
+  bool isFinished;
+  BlockParsedResult result(false);
+  do {
+    int initialPosition = current_.getPosition();
+
+    if (current_.isAlpha()) {
+      result = parseAlphaBlock();
+    } else if (current_.isIsoIec646()) {
+      result = parseIsoIec646Block();
+    } else { // it must be numeric
+      result = parseNumericBlock();
+    }
+    isFinished = result.isFinished();
+
+    bool positionChanged = initialPosition != current_.getPosition();
+    if (!positionChanged && !isFinished) {
+      break;
+    }
+  } while (!isFinished);
+
+  return result.getDecodedInformation();
+}
+
+BlockParsedResult GeneralAppIdDecoder::parseNumericBlock() {
+  while (isStillNumeric(current_.getPosition())) {
+    DecodedNumeric numeric = decodeNumeric(current_.getPosition());
+    current_.setPosition(numeric.getNewPosition());
+
+    if (numeric.isFirstDigitFNC1()) {
+      Ref<DecodedInformation> information;
+      if (numeric.isSecondDigitFNC1()) {
+        information = new DecodedInformation(current_.getPosition(), buffer_);
+      } else {
+        information = new DecodedInformation(current_.getPosition(), buffer_,
+                                              numeric.getSecondDigit());
+      }
+      return BlockParsedResult(information, true);
+    }
+    buffer_.append(1, (char) ('0' + numeric.getFirstDigit()));
+
+    if (numeric.isSecondDigitFNC1()) {
+      Ref<DecodedInformation> information(new DecodedInformation(current_.getPosition(), buffer_));
+      return BlockParsedResult(information, true);
+    }
+    buffer_.append(1, (char) ('0' + numeric.getSecondDigit()));
+  }
+
+  if (isNumericToAlphaNumericLatch(current_.getPosition())) {
+    current_.setAlpha();
+    current_.incrementPosition(4);
+  }
+  return BlockParsedResult(false);
+}
+
+BlockParsedResult GeneralAppIdDecoder::parseIsoIec646Block() {
+  while (isStillIsoIec646(current_.getPosition())) {
+    DecodedChar iso = decodeIsoIec646(current_.getPosition());
+    current_.setPosition(iso.getNewPosition());
+
+    if (iso.isFNC1()) {
+      Ref<DecodedInformation> information(new DecodedInformation(current_.getPosition(), buffer_));
+      return BlockParsedResult(information, true);
+    }
+    buffer_.append(1, iso.getValue());
+  }
+
+  if (isAlphaOr646ToNumericLatch(current_.getPosition())) {
+    current_.incrementPosition(3);
+    current_.setNumeric();
+  } else if (isAlphaTo646ToAlphaLatch(current_.getPosition())) {
+    if (current_.getPosition() + 5 < information_->getSize()) {
+      current_.incrementPosition(5);
+    } else {
+      current_.setPosition(information_->getSize());
+    }
+    current_.setAlpha();
+  }
+  return BlockParsedResult(false);
+}
+
+BlockParsedResult GeneralAppIdDecoder::parseAlphaBlock() {
+  while (isStillAlpha(current_.getPosition())) {
+    DecodedChar alpha = decodeAlphanumeric(current_.getPosition());
+    current_.setPosition(alpha.getNewPosition());
+
+    if (alpha.isFNC1()) {
+      Ref<DecodedInformation> information(new DecodedInformation(current_.getPosition(), buffer_));
+      return BlockParsedResult(information, true); // end of the char block
+    }
+    buffer_.append(1, alpha.getValue());
+  }
+
+  if (isAlphaOr646ToNumericLatch(current_.getPosition())) {
+    current_.incrementPosition(3);
+    current_.setNumeric();
+  } else if (isAlphaTo646ToAlphaLatch(current_.getPosition())) {
+    if (current_.getPosition() + 5 < information_->getSize()) {
+      current_.incrementPosition(5);
+    } else {
+      current_.setPosition(information_->getSize());
+    }
+    current_.setIsoIec646();
+  }
+  return BlockParsedResult(false);
+}
+
+bool GeneralAppIdDecoder::isStillIsoIec646(int pos) {
+  if (pos + 5 > information_->getSize()) {
+    return false;
+  }
+
+  int fiveBitValue = extractNumericValueFromBitArray(pos, 5);
+  if (fiveBitValue >= 5 && fiveBitValue < 16) {
+    return true;
+  }
+
+  if (pos + 7 > information_->getSize()) {
+    return false;
+  }
+
+  int sevenBitValue = extractNumericValueFromBitArray(pos, 7);
+  if (sevenBitValue >= 64 && sevenBitValue < 116) {
+    return true;
+  }
+
+  if (pos + 8 > information_->getSize()) {
+    return false;
+  }
+
+  int eightBitValue = extractNumericValueFromBitArray(pos, 8);
+  return eightBitValue >= 232 && eightBitValue < 253;
+}
+
+DecodedChar GeneralAppIdDecoder::decodeIsoIec646(int pos) {
+  int fiveBitValue = extractNumericValueFromBitArray(pos, 5);
+  if (fiveBitValue == 15) {
+    return DecodedChar(pos + 5, DecodedChar::FNC1);
+  }
+
+  if (fiveBitValue >= 5 && fiveBitValue < 15) {
+    return DecodedChar(pos + 5, (char) ('0' + fiveBitValue - 5));
+  }
+
+  int sevenBitValue = extractNumericValueFromBitArray(pos, 7);
+
+  if (sevenBitValue >= 64 && sevenBitValue < 90) {
+    return DecodedChar(pos + 7, (char) (sevenBitValue + 1));
+  }
+
+  if (sevenBitValue >= 90 && sevenBitValue < 116) {
+    return DecodedChar(pos + 7, (char) (sevenBitValue + 7));
+  }
+
+  static const char EIGHT_BIT_CHARS[] = "!\"%&'()*+,-./:;<=>?_ ";
+  int eightBitValue = extractNumericValueFromBitArray(pos, 8);
+  if (eightBitValue < 232 || eightBitValue > 252) {
+    throw FormatException();
+  }
+  return DecodedChar(pos + 8, EIGHT_BIT_CHARS[eightBitValue - 232]);
+}
+
+bool GeneralAppIdDecoder::isStillAlpha(int pos) {
+  if (pos + 5 > information_->getSize()) {
+    return false;
+  }
+
+  // We now check if it's a valid 5-bit value (0..9 and FNC1)
+  int fiveBitValue = extractNumericValueFromBitArray(pos, 5);
+  if (fiveBitValue >= 5 && fiveBitValue < 16) {
+    return true;
+  }
+
+  if (pos + 6 > information_->getSize()) {
+    return false;
+  }
+
+  int sixBitValue = extractNumericValueFromBitArray(pos, 6);
+  return sixBitValue >= 16 && sixBitValue < 63; // 63 not included
+}
+
+DecodedChar GeneralAppIdDecoder::decodeAlphanumeric(int pos) {
+  int fiveBitValue = extractNumericValueFromBitArray(pos, 5);
+  if (fiveBitValue == 15) {
+    return DecodedChar(pos + 5, DecodedChar::FNC1);
+  }
+
+  if (fiveBitValue >= 5 && fiveBitValue < 15) {
+    return DecodedChar(pos + 5, (char) ('0' + fiveBitValue - 5));
+  }
+
+  int sixBitValue = extractNumericValueFromBitArray(pos, 6);
+
+  if (sixBitValue >= 32 && sixBitValue < 58) {
+    return DecodedChar(pos + 6, (char) (sixBitValue + 33));
+  }
+
+  static const char SIX_BIT_CHARS[] = "*,-./";
+  if (sixBitValue < 58 || sixBitValue > 62) {
+    throw FormatException("Decoding invalid alphanumeric value");
+  }
+  return DecodedChar(pos + 6, SIX_BIT_CHARS[sixBitValue - 58]);
+}
+
+bool GeneralAppIdDecoder::isAlphaTo646ToAlphaLatch(int pos) {
+  if (pos + 1 > information_->getSize()) {
+    return false;
+  }
+
+  for (int i = 0; i < 5 && i + pos < information_->getSize(); ++i) {
+    if (i == 2) {
+      if (!information_->get(pos + 2)) {
+        return false;
+      }
+    } else if (information_->get(pos + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GeneralAppIdDecoder::isAlphaOr646ToNumericLatch(int pos) {
+  // Next is alphanumeric if there are 3 positions and they are all zeros
+  if (pos + 3 > information_->getSize()) {
+    return false;
+  }
+
+  for (int i = pos; i < pos + 3; ++i) {
+    if (information_->get(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GeneralAppIdDecoder::isNumericToAlphaNumericLatch(int pos) {
+  // Next is alphanumeric if there are 4 positions and they are all zeros, or
+  // if there is a subset of this just before the end of the symbol
+  if (pos + 1 > information_->getSize()) {
+    return false;
+  }
+
+  for (int i = 0; i < 4 && i + pos < information_->getSize(); ++i) {
+    if (information_->get(pos + i)) {
+      return false;
+    }
+  }
+  return true;
+}
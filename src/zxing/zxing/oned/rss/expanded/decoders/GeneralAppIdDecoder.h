@@ -0,0 +1,71 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __GENERAL_APP_ID_DECODER_H__
+#define __GENERAL_APP_ID_DECODER_H__
+
+/*
+ * Copyright (C) 2010 ZXing authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <zxing/common/BitArray.h>
+#include <zxing/oned/rss/expanded/decoders/BlockParsedResult.h>
+#include <zxing/oned/rss/expanded/decoders/CurrentParsingState.h>
+#include <zxing/oned/rss/expanded/decoders/DecodedChar.h>
+#include <zxing/oned/rss/expanded/decoders/DecodedInformation.h>
+#include <zxing/oned/rss/expanded/decoders/DecodedNumeric.h>
+
+namespace zxing {
+namespace oned {
+namespace rss {
+
+/**
+ * Walks the general purpose data field, switching between the numeric,
+ * alphanumeric and ISO/IEC 646 encodations as the latches dictate.
+ */
+class GeneralAppIdDecoder {
+private:
+  Ref<BitArray> information_;
+  CurrentParsingState current_;
+  std::string buffer_;
+
+  bool isStillNumeric(int pos);
+  DecodedNumeric decodeNumeric(int pos);
+  Ref<DecodedInformation> parseBlocks();
+  BlockParsedResult parseNumericBlock();
+  BlockParsedResult parseIsoIec646Block();
+  BlockParsedResult parseAlphaBlock();
+  bool isStillIsoIec646(int pos);
+  DecodedChar decodeIsoIec646(int pos);
+  bool isStillAlpha(int pos);
+  DecodedChar decodeAlphanumeric(int pos);
+  bool isAlphaTo646ToAlphaLatch(int pos);
+  bool isAlphaOr646ToNumericLatch(int pos);
+  bool isNumericToAlphaNumericLatch(int pos);
+
+public:
+  explicit GeneralAppIdDecoder(Ref<BitArray> const& information);
+
+  std::string decodeAllCodes(std::string& buff, int initialPosition);
+  Ref<DecodedInformation> decodeGeneralPurposeField(int pos, std::string const& remaining);
+
+  int extractNumericValueFromBitArray(int pos, int bits);
+  static int extractNumericValueFromBitArray(Ref<BitArray> const& information, int pos, int bits);
+};
+
+}
+}
+}
+
+#endif
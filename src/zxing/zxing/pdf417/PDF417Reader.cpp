@@ -29,7 +29,7 @@ using zxing::ArrayRef;
 using zxing::BinaryBitmap;
 using zxing::DecodeHints;
 
-Ref<Result> PDF417Reader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+Ref<Result> PDF417Reader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
   Ref<DecoderResult> decoderResult;
   /* 2012-05-30 hfn C++ DecodeHintType does not yet know a type "PURE_BARCODE", */
   /* therefore skip this for now, todo: may be add this type later */
@@ -40,7 +40,7 @@ Ref<Result> PDF417Reader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
     points = NO_POINTS;
     } else {
   */
-  Detector detector(image);
+  Detector detector(image, &linesSampler);
   Ref<DetectorResult> detectorResult = detector.detect(hints); /* 2012-09-17 hints ("try_harder") */
   ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
   
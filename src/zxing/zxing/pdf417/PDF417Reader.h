@@ -23,6 +23,7 @@
 
 #include <zxing/Reader.h>
 #include <zxing/pdf417/decoder/Decoder.h>
+#include <zxing/pdf417/detector/LinesSampler.h>
 #include <zxing/DecodeHints.h>
 
 namespace zxing {
@@ -32,6 +33,8 @@ namespace pdf417 {
 class PDF417Reader : public Reader {
  private:
   decoder::Decoder decoder;
+  // Keeps its scratch buffers between frames
+  detector::LinesSampler linesSampler;
 			
   static Ref<BitMatrix> extractPureBits(Ref<BitMatrix> image);
   static int moduleSize(ArrayRef<int> leftTopBlack, Ref<BitMatrix> image);
@@ -39,7 +42,7 @@ class PDF417Reader : public Reader {
   static int findPatternEnd(int x, int y, Ref<BitMatrix> image);
 
  public:
-  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
   void reset();
 };
 
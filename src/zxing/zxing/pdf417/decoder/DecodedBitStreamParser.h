@@ -18,7 +18,6 @@
  * limitations under the License.
  */
 
-#include <bigint/BigInteger.hh>
 #include <zxing/common/Array.h>
 #include <zxing/common/Str.h>
 #include <zxing/common/DecoderResult.h>
@@ -56,14 +55,10 @@ class DecodedBitStreamParser {
   static const int AL;
   static const int PS;
   static const int PAL;
-  static const int EXP900_SIZE;
 
   static const char PUNCT_CHARS[];
   static const char MIXED_CHARS[];
- 
-  static ArrayRef<BigInteger> EXP900;
-  static ArrayRef<BigInteger> initEXP900();
-  
+
   static int textCompaction(ArrayRef<int> codewords, int codeIndex, Ref<String> result);
   static void decodeTextCompaction(ArrayRef<int> textCompactionData,
                                    ArrayRef<int> byteCompactionData,
@@ -71,7 +66,7 @@ class DecodedBitStreamParser {
                                    Ref<String> result);
   static int byteCompaction(int mode, ArrayRef<int> codewords, int codeIndex, Ref<String> result);
   static int numericCompaction(ArrayRef<int> codewords, int codeIndex, Ref<String> result);
-  static Ref<String> decodeBase900toBase10(ArrayRef<int> codewords, int count);
+  static void decodeBase900toBase10(int const* codewords, int count, Ref<String> result);
 
  public:
   DecodedBitStreamParser();
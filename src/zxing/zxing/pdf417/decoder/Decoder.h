@@ -22,7 +22,6 @@
  */
 
 #include <zxing/pdf417/decoder/ec/ErrorCorrection.h>
-#include <zxing/pdf417/decoder/ec/ModulusGF.h>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
 #include <zxing/common/DecoderResult.h>
@@ -43,9 +42,11 @@ namespace decoder {
 
 class Decoder {
 private:
-  static const int MAX_ERRORS;
+  static const int MIN_SPARE_EC_CODEWORDS;
   static const int MAX_EC_CODEWORDS;
 
+  ec::ErrorCorrection errorCorrection_;
+
   void correctErrors(ArrayRef<int> codewords,
 		ArrayRef<int> erasures, int numECCodewords);
   static void verifyCodewordCount(ArrayRef<int> codewords, int numECCodewords);
@@ -16,7 +16,6 @@
  */
 
 #include <stdint.h>
-#include <bigint/BigIntegerUtils.hh>
 #include <zxing/FormatException.h>
 #include <zxing/pdf417/decoder/DecodedBitStreamParser.h>
 #include <zxing/common/DecoderResult.h>
@@ -49,8 +48,6 @@ const int DecodedBitStreamParser::AL = 28;
 const int DecodedBitStreamParser::PS = 29;
 const int DecodedBitStreamParser::PAL = 29;
 
-const int DecodedBitStreamParser::EXP900_SIZE = 16;
-
 const char DecodedBitStreamParser::PUNCT_CHARS[] = {
   ';', '<', '>', '@', '[', '\\', '}', '_', '`', '~', '!',
   '\r', '\t', ',', ':', '\n', '-', '.', '$', '/', '"', '|', '*',
@@ -61,19 +58,6 @@ const char DecodedBitStreamParser::MIXED_CHARS[] = {
   '\r', '\t', ',', ':', '#', '-', '.', '$', '/', '+', '%', '*',
   '=', '^'};
 
-ArrayRef<BigInteger> DecodedBitStreamParser::initEXP900() {
-  ArrayRef<BigInteger> EXP900 (16);
-  EXP900[0] = BigInteger(1);
-  BigInteger nineHundred (900);
-  EXP900[1] = nineHundred;
-  for (int i = 2; i < EXP900->size(); i++) {
-    EXP900[i] = EXP900[i - 1] * nineHundred;
-  }
-  return EXP900;
-}
-
-ArrayRef<BigInteger> DecodedBitStreamParser::EXP900 = initEXP900();
-
 DecodedBitStreamParser::DecodedBitStreamParser(){}
 
 /**
@@ -470,7 +454,7 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
   int count = 0;
   bool end = false;
   
-  ArrayRef<int> numericCodewords = new Array<int>(MAX_NUMERIC_CODEWORDS);
+  int numericCodewords[MAX_NUMERIC_CODEWORDS];
   
   while (codeIndex < codewords[0] && !end) {
     int code = codewords[codeIndex++];
@@ -498,8 +482,7 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
       // while in Numeric Compaction mode) serves  to terminate the
       // current Numeric Compaction mode grouping as described in 5.4.4.2,
       // and then to start a new one grouping.
-      Ref<String> s = decodeBase900toBase10(numericCodewords, count);
-      result->append(s->getText());
+      decodeBase900toBase10(numericCodewords, count, result);
       count = 0;
     }
   }
@@ -549,20 +532,41 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
 
   Remove leading 1 =>  Result is 000213298174000
 */
-Ref<String> DecodedBitStreamParser::decodeBase900toBase10(ArrayRef<int> codewords, int count)
+void DecodedBitStreamParser::decodeBase900toBase10(int const* codewords, int count, Ref<String> result)
 {
-  BigInteger result = BigInteger(0);
+  // 900^15 has 45 decimal digits. The value is accumulated in base 10^9
+  // limbs, least significant first, so each step fits in 64 bits.
+  const uint32_t LIMB = 1000000000;
+  const int MAX_LIMBS = 5;
+  uint32_t limbs[MAX_LIMBS] = { 0 };
+  int numLimbs = 1;
   for (int i = 0; i < count; i++) {
-    result = result + (EXP900[count - i - 1] * BigInteger(codewords[i]));
+    uint64_t carry = codewords[i];
+    for (int k = 0; k < numLimbs; k++) {
+      uint64_t value = (uint64_t)limbs[k] * 900 + carry;
+      limbs[k] = (uint32_t)(value % LIMB);
+      carry = value / LIMB;
+    }
+    if (carry) {
+      limbs[numLimbs++] = (uint32_t)carry;
+    }
+  }
+
+  char digits[9 * MAX_LIMBS];
+  char* end = digits + sizeof(digits);
+  char* start = end;
+  for (int k = 0; k < numLimbs; k++) {
+    uint32_t limb = limbs[k];
+    // All but the most significant limb are zero-padded to 9 digits
+    for (int d = 0; d < 9 && (limb || k < numLimbs - 1); d++) {
+      *--start = (char)('0' + limb % 10);
+      limb /= 10;
+    }
   }
-  string resultString = bigIntegerToString(result);
-  if (resultString[0] != '1') {
+  if (start == end || *start != '1') {
     throw FormatException("DecodedBitStreamParser::decodeBase900toBase10: String does not begin with 1");
   }
-  string resultString2;
-  resultString2.assign(resultString.begin()+1,resultString.end());
-  Ref<String> res (new String(resultString2));
-  return res;
+  result->append(string(start + 1, end));
 }
 
 }
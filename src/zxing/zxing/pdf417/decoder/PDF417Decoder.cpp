@@ -27,7 +27,6 @@
 #include <zxing/common/reedsolomon/ReedSolomonException.h>
 
 using zxing::pdf417::decoder::Decoder;
-using zxing::pdf417::decoder::ec::ErrorCorrection;
 using zxing::Ref;
 using zxing::DecoderResult;
 
@@ -37,7 +36,7 @@ using zxing::BitMatrix;
 using zxing::DecodeHints;
 using zxing::ArrayRef;
 
-const int Decoder::MAX_ERRORS = 3;
+const int Decoder::MIN_SPARE_EC_CODEWORDS = 2;
 const int Decoder::MAX_EC_CODEWORDS = 512;
 
 Ref<DecoderResult> Decoder::decode(Ref<BitMatrix> bits, DecodeHints const& hints) {
@@ -100,13 +99,14 @@ void Decoder::verifyCodewordCount(ArrayRef<int> codewords, int numECCodewords) {
  */
 void Decoder::correctErrors(ArrayRef<int> codewords,
                             ArrayRef<int> erasures, int numECCodewords) {
-  if (erasures->size() > numECCodewords / 2 + MAX_ERRORS ||
+  // Each erasure uses up one EC codeword; keep a couple spare so that a
+  // wrong codeword elsewhere in the symbol can still be detected
+  if (erasures->size() > numECCodewords - MIN_SPARE_EC_CODEWORDS ||
       numECCodewords < 0 || numECCodewords > MAX_EC_CODEWORDS) {
     throw FormatException("PDF:Decoder:correctErrors: Too many errors or EC Codewords corrupted");
   }
 
-  Ref<ErrorCorrection> errorCorrection(new ErrorCorrection);
-  errorCorrection->decode(codewords, numECCodewords, erasures);
+  errorCorrection_.decode(codewords, numECCodewords, erasures);
 
   // 2012-06-27 HFN if, despite of error correction, there are still codewords with invalid
   // value, throw an exception here:
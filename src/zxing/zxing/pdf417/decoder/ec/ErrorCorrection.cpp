@@ -17,15 +17,14 @@
  * 2012-09-19 HFN translation from Java into C++
  */
 
+#include <algorithm>
 #include <zxing/pdf417/decoder/ec/ErrorCorrection.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
 #include <zxing/pdf417/decoder/ec/ModulusGF.h>
 
 using std::vector;
 using zxing::Ref;
 using zxing::ArrayRef;
 using zxing::pdf417::decoder::ec::ErrorCorrection;
-using zxing::pdf417::decoder::ec::ModulusPoly;
 using zxing::pdf417::decoder::ec::ModulusGF;
 
 /**
@@ -44,171 +43,224 @@ ErrorCorrection::ErrorCorrection()
 {
 }
 
+void ErrorCorrection::ensureCapacity(int numECCodewords) {
+  if ((int)syndromes_.size() < numECCodewords) {
+    syndromes_.resize(numECCodewords);
+    erasureLocator_.resize(numECCodewords + 1);
+    sigma_.resize(numECCodewords + 1);
+    previous_.resize(numECCodewords + 1);
+    temp_.resize(numECCodewords + 1);
+    errata_.resize(numECCodewords + 1);
+    omega_.resize(numECCodewords);
+    errorLocations_.resize(numECCodewords);
+  }
+}
+
+int ErrorCorrection::evaluateAt(int const* coefficients, int degree, int a) {
+  int result = coefficients[degree];
+  for (int i = degree - 1; i >= 0; i--) {
+    result = field_.add(field_.multiply(a, result), coefficients[i]);
+  }
+  return result;
+}
+
 void ErrorCorrection::decode(ArrayRef<int> received,
                              int numECCodewords,
                              ArrayRef<int> erasures)
 {
-  Ref<ModulusPoly> poly (new ModulusPoly(field_, received));
-  ArrayRef<int> S( new Array<int>(numECCodewords));
+  int size = received->size();
+  int numErasures = erasures->size();
+  vector<int> const& codewords = received->values();
+  if (numErasures > numECCodewords) {
+    throw ReedSolomonException("Too many erasures");
+  }
+  ensureCapacity(numECCodewords);
+
+  // Syndrome i is the received polynomial evaluated at 3^(i + 1)
+  int* syndromes = &syndromes_[0];
   bool error = false;
-  for (int i = numECCodewords; i > 0; i--) {
-    int eval = poly->evaluateAt(field_.exp(i));
-    S[numECCodewords - i] = eval;
+  for (int i = 0; i < numECCodewords; i++) {
+    int alpha = field_.exp(i + 1);
+    int eval = 0;
+    for (int j = 0; j < size; j++) {
+      eval = field_.add(field_.multiply(alpha, eval), codewords[j]);
+    }
+    syndromes[i] = eval;
     if (eval != 0) {
       error = true;
     }
   }
+  if (!error) {
+    return;
+  }
 
-  if (error) {
-
-    Ref<ModulusPoly> knownErrors = field_.getOne();
-    for (int i=0;i<erasures->size();i++) {
-      int b = field_.exp(received->size() - 1 - erasures[i]);
-      // Add (1 - bx) term:
-      ArrayRef<int> one_minus_b_x(new Array<int>(2));
-      one_minus_b_x[1]=field_.subtract(0,b);
-      one_minus_b_x[0]=1;
-      Ref<ModulusPoly> term (new ModulusPoly(field_,one_minus_b_x));
-      knownErrors = knownErrors->multiply(term);
+  // The erasure locator is the product of (1 - Xx) over the locators X of
+  // the known-missing codewords
+  int* erasureLocator = &erasureLocator_[0];
+  erasureLocator[0] = 1;
+  for (int k = 0; k < numErasures; k++) {
+    int position = erasures[k];
+    if (position < 0 || position >= size) {
+      throw ReedSolomonException("Bad erasure location!");
     }
+    int locator = field_.exp(size - 1 - position);
+    erasureLocator[k + 1] = 0;
+    for (int i = k + 1; i > 0; i--) {
+      erasureLocator[i] = field_.subtract(erasureLocator[i],
+                                          field_.multiply(locator, erasureLocator[i - 1]));
+    }
+  }
 
-    Ref<ModulusPoly> syndrome (new ModulusPoly(field_, S));
-    //syndrome = syndrome.multiply(knownErrors);
+  // The Forney syndromes, erasureLocator * syndromes from x^numErasures up
+  // to x^numECCodewords, only depend on the unknown errors
+  int* forneySyndromes = &errata_[0];
+  int numForneySyndromes = numECCodewords - numErasures;
+  for (int i = 0; i < numForneySyndromes; i++) {
+    int term = 0;
+    for (int j = 0; j <= numErasures; j++) {
+      term = field_.add(term, field_.multiply(erasureLocator[j],
+                                              syndromes[numErasures + i - j]));
+    }
+    forneySyndromes[i] = term;
+  }
 
-    vector<Ref<ModulusPoly> > sigmaOmega (
-        runEuclideanAlgorithm(field_.buildMonomial(numECCodewords, 1), syndrome, numECCodewords));
-    Ref<ModulusPoly> sigma = sigmaOmega[0];
-    Ref<ModulusPoly> omega = sigmaOmega[1];
+  int numErrors = runBerlekampMassey(forneySyndromes, numForneySyndromes);
+  if (findErrorLocations(numErrors, size) != numErrors) {
+    throw ReedSolomonException("Error number inconsistency!");
+  }
+  int numErrata = numErrors + numErasures;
+  for (int k = 0; k < numErasures; k++) {
+    errorLocations_[numErrors + k] = field_.exp(size - 1 - erasures[k]);
+  }
 
-    //sigma = sigma.multiply(knownErrors);
+  // The errata locator covers both errors and erasures
+  int const* sigma = &sigma_[0];
+  int* errata = &errata_[0];
+  for (int i = 0; i <= numErrata; i++) {
+    int term = 0;
+    for (int j = std::max(0, i - numErasures); j <= std::min(i, numErrors); j++) {
+      term = field_.add(term, field_.multiply(sigma[j], erasureLocator[i - j]));
+    }
+    errata[i] = term;
+  }
 
-    ArrayRef<int> errorLocations = findErrorLocations(sigma);
-    ArrayRef<int> errorMagnitudes = findErrorMagnitudes(omega, sigma, errorLocations);
+  // The errata evaluator is syndromes * errata mod x^numECCodewords, of which
+  // only the terms below numErrata can be non-zero
+  int* omega = &omega_[0];
+  for (int i = 0; i < numErrata; i++) {
+    int term = 0;
+    for (int j = 0; j <= i; j++) {
+      term = field_.add(term, field_.multiply(syndromes[i - j], errata[j]));
+    }
+    omega[i] = term;
+  }
 
-    for (int i = 0; i < errorLocations->size(); i++) {
-      int position = received->size() - 1 - field_.log(errorLocations[i]);
-      if (position < 0) {
-        throw ReedSolomonException("Bad error location!");
-      }
-      received[position] = field_.subtract(received[position], errorMagnitudes[i]);
-#if (defined (DEBUG)  && defined _WIN32)
-      {
-        WCHAR szmsg[256];
-        swprintf(szmsg,L"ErrorCorrection::decode: fix @ %d, new value = %d\n",
-                 position, received[position]);
-        OutputDebugString(szmsg);
-      }
-#endif
+  // This is directly applying Forney's Formula, with the formal derivative
+  // of the errata locator evaluated in place
+  for (int k = 0; k < numErrata; k++) {
+    int xiInverse = field_.inverse(errorLocations_[k]);
+    int derivative = 0;
+    for (int i = numErrata; i > 0; i--) {
+      derivative = field_.add(field_.multiply(xiInverse, derivative),
+                              field_.multiply(i, errata[i]));
     }
+    if (derivative == 0) {
+      throw ReedSolomonException("Repeated errata location!");
+    }
+    int numerator = field_.subtract(0, evaluateAt(omega, numErrata - 1, xiInverse));
+    int magnitude = field_.multiply(numerator, field_.inverse(derivative));
+    int position = size - 1 - field_.log(errorLocations_[k]);
+    if (position < 0) {
+      throw ReedSolomonException("Bad error location!");
+    }
+    received[position] = field_.subtract(received[position], magnitude);
   }
 }
 
-vector<Ref<ModulusPoly> >  ErrorCorrection::runEuclideanAlgorithm(Ref<ModulusPoly> a, Ref<ModulusPoly> b, int R)
-{
-  // Assume a's degree is >= b's
-  if (a->getDegree() < b->getDegree()) {
-    Ref<ModulusPoly> temp = a;
-    a = b;
-    b = temp;
-  }
-
-  Ref<ModulusPoly> rLast ( a);
-  Ref<ModulusPoly> r ( b);
-  Ref<ModulusPoly> tLast ( field_.getZero());
-  Ref<ModulusPoly> t ( field_.getOne());
-
-  // Run Euclidean algorithm until r's degree is less than R/2
-  while (r->getDegree() >= R / 2) {
-    Ref<ModulusPoly> rLastLast (rLast);
-    Ref<ModulusPoly> tLastLast (tLast);
-    rLast = r;
-    tLast = t;
-
-    // Divide rLastLast by rLast, with quotient in q and remainder in r
-    if (rLast->isZero()) {
-      // Oops, Euclidean algorithm already terminated?
-      throw ReedSolomonException("Euclidean algorithm already terminated?");
-    }
-    r = rLastLast;
-    Ref<ModulusPoly> q (field_.getZero());
-    int denominatorLeadingTerm = rLast->getCoefficient(rLast->getDegree());
-    int dltInverse = field_.inverse(denominatorLeadingTerm);
-    while (r->getDegree() >= rLast->getDegree() && !r->isZero()) {
-      int degreeDiff = r->getDegree() - rLast->getDegree();
-      int scale = field_.multiply(r->getCoefficient(r->getDegree()), dltInverse);
-      q = q->add(field_.buildMonomial(degreeDiff, scale));
-      r = r->subtract(rLast->multiplyByMonomial(degreeDiff, scale));
-    }
-
-	  t = q->multiply(tLast)->subtract(tLastLast)->negative();
-  }
-
-  int sigmaTildeAtZero = t->getCoefficient(0);
-  if (sigmaTildeAtZero == 0) {
-    throw ReedSolomonException("sigmaTilde = 0!");
-  }
-
-  int inverse = field_.inverse(sigmaTildeAtZero);
-  Ref<ModulusPoly> sigma (t->multiply(inverse));
-  Ref<ModulusPoly> omega (r->multiply(inverse));
-	vector<Ref<ModulusPoly> > v(2);
-	v[0] = sigma;
-	v[1] = omega;
-  return v;
-}
+int ErrorCorrection::runBerlekampMassey(int const* syndromes, int length) {
+  // Finds the shortest error locator sigma, with sigma(0) == 1, that
+  // generates the syndrome sequence
+  int* sigma = &sigma_[0];
+  int* previous = &previous_[0];
+  int* temp = &temp_[0];
+  for (int i = 0; i <= length; i++) {
+    sigma[i] = 0;
+    previous[i] = 0;
+  }
+  sigma[0] = 1;
+  previous[0] = 1;
+  int numErrors = 0;
+  int previousDiscrepancy = 1;
+  int shift = 1;
 
-ArrayRef<int> ErrorCorrection::findErrorLocations(Ref<ModulusPoly> errorLocator)  {
-  // This is a direct application of Chien's search
-  int numErrors = errorLocator->getDegree();
-  ArrayRef<int> result( new Array<int>(numErrors));
-  int e = 0;
-  for (int i = 1; i < field_.getSize() && e < numErrors; i++) {
-    if (errorLocator->evaluateAt(i) == 0) {
-      result[e] = field_.inverse(i);
-      e++;
+  for (int n = 0; n < length; n++) {
+    int discrepancy = syndromes[n];
+    for (int i = 1; i <= numErrors; i++) {
+      discrepancy = field_.add(discrepancy, field_.multiply(sigma[i], syndromes[n - i]));
+    }
+    if (discrepancy == 0) {
+      shift++;
+      continue;
+    }
+    // sigma -= discrepancy / previousDiscrepancy * x^shift * previous
+    int scale = field_.multiply(discrepancy, field_.inverse(previousDiscrepancy));
+    if (2 * numErrors <= n) {
+      for (int i = 0; i <= numErrors; i++) {
+        temp[i] = sigma[i];
+      }
+      for (int i = 0; i + shift <= length; i++) {
+        sigma[i + shift] = field_.subtract(sigma[i + shift], field_.multiply(scale, previous[i]));
+      }
+      std::swap(previous, temp);
+      for (int i = numErrors + 1; i <= length; i++) {
+        previous[i] = 0;
+      }
+      numErrors = n + 1 - numErrors;
+      previousDiscrepancy = discrepancy;
+      shift = 1;
+    } else {
+      for (int i = 0; i + shift <= length; i++) {
+        sigma[i + shift] = field_.subtract(sigma[i + shift], field_.multiply(scale, previous[i]));
+      }
+      shift++;
     }
   }
-  if (e != numErrors) {
-#if (defined (DEBUG) && defined _WIN32)
-	  char sz[128];
-	  sprintf(sz,"Error number inconsistency, %d/%d!",e,numErrors);
-    throw ReedSolomonException(sz);
-#else
-	  throw ReedSolomonException("Error number inconsistency!");
-#endif
+
+  if (2 * numErrors > length) {
+    throw ReedSolomonException("Too many errors");
   }
-#if (defined (DEBUG) && defined _WIN32)
-  {
-    WCHAR szmsg[256];
-    swprintf(szmsg,L"ErrorCorrection::findErrorLocations: found %d errors.\n",
-             e);
-    OutputDebugString(szmsg);
+  for (int i = numErrors + 1; i <= length; i++) {
+    if (sigma[i] != 0) {
+      throw ReedSolomonException("Error locator degree does not match number of errors");
+    }
   }
-#endif
-  return result;
+  return numErrors;
 }
 
-ArrayRef<int> ErrorCorrection::findErrorMagnitudes(Ref<ModulusPoly> errorEvaluator,
-                                                   Ref<ModulusPoly> errorLocator,
-                                                   ArrayRef<int> errorLocations) {
-	int i;
-  int errorLocatorDegree = errorLocator->getDegree();
-  ArrayRef<int> formalDerivativeCoefficients (new Array<int>(errorLocatorDegree));
-  for (i = 1; i <= errorLocatorDegree; i++) {
-    formalDerivativeCoefficients[errorLocatorDegree - i] =
-        field_.multiply(i, errorLocator->getCoefficient(i));
-  }
-  Ref<ModulusPoly> formalDerivative (new ModulusPoly(field_, formalDerivativeCoefficients));
-
-  // This is directly applying Forney's Formula
-  int s = errorLocations->size();
-  ArrayRef<int> result ( new Array<int>(s));
-  for (i = 0; i < s; i++) {
-    int xiInverse = field_.inverse(errorLocations[i]);
-    int numerator = field_.subtract(0, errorEvaluator->evaluateAt(xiInverse));
-    int denominator = field_.inverse(formalDerivative->evaluateAt(xiInverse));
-    result[i] = field_.multiply(numerator, denominator);
+int ErrorCorrection::findErrorLocations(int numErrors, int size) {
+  // Chien's search, only over the positions that exist in a codeword of
+  // this size. Term i of the locator is kept multiplied by 3^(-i*j), so
+  // moving on to the next position costs one multiplication per term.
+  int const* errorLocator = &sigma_[0];
+  int* terms = &temp_[0];
+  int* steps = &previous_[0];
+  int order = field_.getSize() - 1;
+  for (int i = 1; i <= numErrors; i++) {
+    terms[i] = errorLocator[i];
+    steps[i] = field_.exp(order - i % order);
   }
-  return result;
+  int e = 0;
+  for (int j = 0; j < size && e < numErrors; j++) {
+    // Evaluate at 3^(-j), the inverse of the locator of codeword size-1-j
+    int eval = 1;
+    for (int i = 1; i <= numErrors; i++) {
+      eval = field_.add(eval, terms[i]);
+      terms[i] = field_.multiply(terms[i], steps[i]);
+    }
+    if (eval == 0) {
+      errorLocations_[e] = field_.exp(j % order);
+      e++;
+    }
+  }
+  return e;
 }
-
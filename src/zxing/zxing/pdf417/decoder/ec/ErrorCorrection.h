@@ -20,12 +20,10 @@
  * 2012-09-17 HFN translation from Java into C++
  */
 
+#include <vector>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
-#include <zxing/common/DecoderResult.h>
-#include <zxing/common/BitMatrix.h>
 #include <zxing/pdf417/decoder/ec/ModulusGF.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
 #include <zxing/common/reedsolomon/ReedSolomonException.h>
 
 namespace zxing {
@@ -40,6 +38,10 @@ namespace ec {
  * <p>This <a href="http://en.wikipedia.org/wiki/Reed%E2%80%93Solomon_error_correction#Example">example</a>
  * is quite useful in understanding the algorithm.</p>
  *
+ * <p>Known-missing codewords are corrected as erasures, which cost one EC
+ * codeword each instead of two, so 2 * errors + erasures may be as large as
+ * the number of EC codewords.</p>
+ *
  * @author Sean Owen
  * @see com.google.zxing.common.reedsolomon.ReedSolomonDecoder
  */
@@ -48,6 +50,17 @@ class ErrorCorrection: public Counted {
  private:
   ModulusGF &field_;
 
+  // Scratch space, grown on demand and reused by subsequent decode() calls.
+  // Polynomials are stored lowest degree coefficient first.
+  std::vector<int> syndromes_;
+  std::vector<int> erasureLocator_;
+  std::vector<int> sigma_;
+  std::vector<int> previous_;
+  std::vector<int> temp_;
+  std::vector<int> errata_;
+  std::vector<int> omega_;
+  std::vector<int> errorLocations_;
+
  public:
   ErrorCorrection();
   void decode(ArrayRef<int> received,
@@ -55,12 +68,10 @@ class ErrorCorrection: public Counted {
               ArrayRef<int> erasures);
 
  private:
-  std::vector<Ref<ModulusPoly> > runEuclideanAlgorithm(Ref<ModulusPoly> a, Ref<ModulusPoly> b, int R);
-
-  ArrayRef<int> findErrorLocations(Ref<ModulusPoly> errorLocator);
-  ArrayRef<int> findErrorMagnitudes(Ref<ModulusPoly> errorEvaluator,
-                                    Ref<ModulusPoly> errorLocator,
-                                    ArrayRef<int> errorLocations);
+  void ensureCapacity(int numECCodewords);
+  int evaluateAt(int const* coefficients, int degree, int a);
+  int runBerlekampMassey(int const* syndromes, int length);
+  int findErrorLocations(int numErrors, int size);
 };
 
 }
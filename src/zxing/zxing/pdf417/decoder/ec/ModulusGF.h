@@ -18,48 +18,55 @@
  * 2012-09-17 HFN translation from Java into C++
  */
 
-#include <zxing/common/Counted.h>
-#include <zxing/common/Array.h>
-#include <zxing/common/DecoderResult.h>
-#include <zxing/common/BitMatrix.h>
+#include <vector>
 
 namespace zxing {
 namespace pdf417 {
 namespace decoder {
 namespace ec {
 
-class ModulusPoly;
-
 /**
  * <p>A field based on powers of a generator integer, modulo some modulus.</p>
  *
+ * <p>The exp and log tables are built once, when the field is constructed.
+ * The exp table is doubled in length so that multiply() can index it with
+ * the plain sum of two logarithms.</p>
+ *
  * @author Sean Owen
  * @see com.google.zxing.common.reedsolomon.GenericGF
  */
 class ModulusGF {
 
-  public: 
+  public:
 	static ModulusGF PDF417_GF;
 
   private:
-	ArrayRef<int> expTable_;
-	ArrayRef<int> logTable_;
-	Ref<ModulusPoly> zero_;
-	Ref<ModulusPoly> one_;
+	std::vector<int> expTable_;
+	std::vector<int> logTable_;
 	int modulus_;
 
   public:
 	ModulusGF(int modulus, int generator);
-	Ref<ModulusPoly> getZero();
-	Ref<ModulusPoly> getOne();
-	Ref<ModulusPoly> buildMonomial(int degree, int coefficient);
 
-	int add(int a, int b);
-	int subtract(int a, int b);
-	int exp(int a);
+	inline int add(int a, int b) {
+	  int sum = a + b;
+	  return sum >= modulus_ ? sum - modulus_ : sum;
+	}
+	inline int subtract(int a, int b) {
+	  int difference = a - b;
+	  return difference < 0 ? difference + modulus_ : difference;
+	}
+	inline int exp(int a) {
+	  return expTable_[a];
+	}
 	int log(int a);
 	int inverse(int a);
-	int multiply(int a, int b);
+	inline int multiply(int a, int b) {
+	  if (a == 0 || b == 0) {
+	    return 0;
+	  }
+	  return expTable_[logTable_[a] + logTable_[b]];
+	}
 	int getSize();
   
 };
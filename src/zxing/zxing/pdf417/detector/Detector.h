@@ -25,6 +25,7 @@
 #include <zxing/NotFoundException.h>
 #include <zxing/BinaryBitmap.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/pdf417/detector/LinesSampler.h>
 
 namespace zxing {
 namespace pdf417 {
@@ -47,6 +48,7 @@ private:
   static const int STOP_PATTERN_REVERSE_LENGTH;
 
   Ref<BinaryBitmap> image_;
+  LinesSampler* linesSampler_;
   
   static ArrayRef< Ref<ResultPoint> > findVertices(Ref<BitMatrix> matrix, int rowStep);
   static ArrayRef< Ref<ResultPoint> > findVertices180(Ref<BitMatrix> matrix, int rowStep);
@@ -93,7 +95,7 @@ private:
   Ref<BitMatrix> sampleLines(ArrayRef< Ref<ResultPoint> > const& vertices, int dimensionY, int dimension);
 
 public:
-  Detector(Ref<BinaryBitmap> image);
+  Detector(Ref<BinaryBitmap> image, LinesSampler* linesSampler = 0);
   Ref<BinaryBitmap> getImage();
   Ref<DetectorResult> detect();
   Ref<DetectorResult> detect(DecodeHints const& hints);
@@ -15,15 +15,16 @@
  * limitations under the License.
  */
 
-#include <map>
 #include <zxing/pdf417/detector/LinesSampler.h>
 #include <zxing/pdf417/decoder/BitMatrixParser.h>
 #include <zxing/NotFoundException.h>
 #include <zxing/common/Point.h>
+#include <zxing/ZXing.h>
+#include <algorithm>
+#include <cstring>
 #include <cmath>
 #include <qglobal.h>
 
-using std::map;
 using std::vector;
 using std::min;
 using std::abs;
@@ -31,6 +32,7 @@ using zxing::pdf417::detector::LinesSampler;
 using zxing::pdf417::decoder::BitMatrixParser;
 using zxing::Ref;
 using zxing::BitMatrix;
+using zxing::BitArray;
 using zxing::NotFoundException;
 using zxing::Point;
 
@@ -72,19 +74,23 @@ class VoteResult {
 // That solves some of the problems with PDF-417 codes that I had when I tried, 
 // to decode codes from a spezific library.
 
-VoteResult getValueWithMaxVotes(map<int, int>& votes,int expectedLength) {
+VoteResult getValueWithMaxVotes(const int* votes, int size, int expectedLength) {
   VoteResult result;
   int maxVotes = 0;
   int firstVote = 0, secondVote = 0;
-  for (map<int, int>::iterator i = votes.begin(); i != votes.end(); i++) {
-    if (i->second > maxVotes) {
-      maxVotes = i->second;
-      result.setVote(i->first);
-      firstVote = i->first;
+  for (int i = 0; i < size; i++) {
+    if (votes[i] == 0) {
+      // Nobody voted for this one
+      continue;
+    }
+    if (votes[i] > maxVotes) {
+      maxVotes = votes[i];
+      result.setVote(i);
+      firstVote = i;
       result.setIndecisive(false);
-    } else if (i->second == maxVotes) {
+    } else if (votes[i] == maxVotes) {
       if(expectedLength != 0)
-        secondVote = i->first;
+        secondVote = i;
       result.setIndecisive(true);
     }
     if(expectedLength != 0) {
@@ -147,66 +153,77 @@ vector<float> LinesSampler::init_ratios_table() {
 
 const vector<float> LinesSampler::RATIOS_TABLE = init_ratios_table();
 
-LinesSampler::LinesSampler(Ref<BitMatrix> linesMatrix, int dimension)
-    : linesMatrix_(linesMatrix), dimension_(dimension) {}
+LinesSampler::LinesSampler() : symbolsPerLine_(0), dimension_(0) {}
 
 /**
- * Samples a grid from a lines matrix.
+ * Samples a grid from a lines matrix. The scratch buffers are kept by this
+ * object and reused by subsequent calls.
  *
  * @return the potentially decodable bit matrix.
  */
-Ref<BitMatrix> LinesSampler::sample() {
-  const int symbolsPerLine = dimension_ / MODULES_IN_SYMBOL;
+Ref<BitMatrix> LinesSampler::sample(Ref<BitMatrix> linesMatrix, int dimension) {
+  linesMatrix_ = linesMatrix;
+  dimension_ = dimension;
+  symbolsPerLine_ = dimension_ / MODULES_IN_SYMBOL;
+  if (symbolsPerLine_ < 1) {
+    throw NotFoundException("Not enough modules for a single symbol.");
+  }
 
   // XXX
-  vector<float> symbolWidths;
-  computeSymbolWidths(symbolWidths, symbolsPerLine, linesMatrix_);
+  computeSymbolWidths();
 
   // XXX
-  vector<vector<int> > codewords(linesMatrix_->getHeight());
-  vector<vector<int> > clusterNumbers(linesMatrix_->getHeight());
-  linesMatrixToCodewords(clusterNumbers, symbolsPerLine, symbolWidths, linesMatrix_, codewords);
+  linesMatrixToCodewords();
 
   // XXX
-  vector<vector<map<int, int> > > votes =
-      distributeVotes(symbolsPerLine, codewords, clusterNumbers);
+  int rows = distributeVotes();
 
   // XXX
-  vector<vector<int> > detectedCodeWords(votes.size());
-  for (int i = 0; i < (int)votes.size(); i++) {
-    detectedCodeWords[i].resize(votes[i].size(), 0);
-    for (int j = 0; j < (int)votes[i].size(); j++) {
-      if (!votes[i][j].empty()) {
-        detectedCodeWords[i][j] = getValueWithMaxVotes(votes[i][j],0).getVote();
+  // Sorting the votes brings those for the same position together, with
+  // the candidate codewords in ascending order.
+  std::sort(votes_.begin(), votes_.end());
+  detectedCodeWords_.assign(rows * symbolsPerLine_, 0);
+  for (size_t i = 0; i < votes_.size(); ) {
+    const Vote& position = votes_[i];
+    int maxVotes = 0;
+    while (i < votes_.size() && votes_[i].row == position.row && votes_[i].column == position.column) {
+      size_t first = i;
+      while (i < votes_.size() && votes_[i] == votes_[first]) {
+        i++;
+      }
+      if ((int)(i - first) > maxVotes) {
+        maxVotes = (int)(i - first);
+        detectedCodeWords_[position.row * symbolsPerLine_ + position.column] = votes_[first].codeword;
       }
     }
   }
 
   // XXX
-  vector<int> insertLinesAt = findMissingLines(symbolsPerLine, detectedCodeWords);
+  findMissingLines();
 
   // XXX
-  int rowCount = decodeRowCount(symbolsPerLine, detectedCodeWords, insertLinesAt);
-  detectedCodeWords.resize(rowCount);
+  int rowCount = decodeRowCount();
+  detectedCodeWords_.resize(rowCount * symbolsPerLine_, 0);
 
   // XXX
-  Ref<BitMatrix> grid(new BitMatrix(dimension_, detectedCodeWords.size()));
-  codewordsToBitMatrix(detectedCodeWords, grid);
+  Ref<BitMatrix> grid(new BitMatrix(dimension_, rowCount));
+  codewordsToBitMatrix(grid);
 
   return grid;
 }
 
 /**
  * @brief LinesSampler::codewordsToBitMatrix
- * @param codewords
  * @param matrix
  */
-void LinesSampler::codewordsToBitMatrix(vector<vector<int> > &codewords, Ref<BitMatrix> &matrix) {
-  for (int i = 0; i < (int)codewords.size(); i++) {
-    for (int j = 0; j < (int)codewords[i].size(); j++) {
+void LinesSampler::codewordsToBitMatrix(Ref<BitMatrix> &matrix) {
+  int rows = detectedCodeWords_.size() / symbolsPerLine_;
+  for (int i = 0; i < rows; i++) {
+    const int* codewords = &detectedCodeWords_[i * symbolsPerLine_];
+    for (int j = 0; j < symbolsPerLine_; j++) {
       int moduleOffset = j * MODULES_IN_SYMBOL;
       for (int k = 0; k < MODULES_IN_SYMBOL; k++) {
-        if ((codewords[i][j] & (1 << (MODULES_IN_SYMBOL - k - 1))) > 0) {
+        if ((codewords[j] & (1 << (MODULES_IN_SYMBOL - k - 1))) > 0) {
           matrix->set(moduleOffset + k, i);
         }
       }
@@ -252,23 +269,29 @@ int LinesSampler::calculateClusterNumber(int codeword) {
 //#define OUTPUT_CLUSTER_NUMBERS 1
 //#define OUTPUT_EC_LEVEL 1
 
-void LinesSampler::computeSymbolWidths(vector<float> &symbolWidths, const int symbolsPerLine, Ref<BitMatrix> linesMatrix)
+void LinesSampler::computeSymbolWidths()
 {
+  const int width = linesMatrix_->getWidth();
+  const int height = linesMatrix_->getHeight();
   int symbolStart = 0;
   bool lastWasSymbolStart = true;
-  const float symbolWidth = symbolsPerLine > 0 ? (float)linesMatrix->getWidth() / (float)symbolsPerLine : (float)linesMatrix->getWidth();
+  const float symbolWidth = (float)width / (float)symbolsPerLine_;
+  symbolWidths_.clear();
 
   // Use the following property of PDF417 barcodes to detect symbols:
   // Every symbol starts with a black module and every symbol is 17 modules wide,
   // therefore there have to be columns in the line matrix that are completely composed of black pixels.
-  vector<int> blackCount(linesMatrix->getWidth(), 0);
-  for (int x = BARCODE_START_OFFSET; x < linesMatrix->getWidth(); x++) {
-    for (int y = 0; y < linesMatrix->getHeight(); y++) {
-      if (linesMatrix->get(x, y)) {
-        blackCount[x]++;
-      }
+  // Those are found 32 columns at a time, by and-ing the rows together.
+  const int words = (width + 31) >> 5;
+  blackColumns_.assign(words, ~0u);
+  for (int y = 0; y < height; y++) {
+    for (int w = 0; w < words; w++) {
+      blackColumns_[w] &= (unsigned int)linesMatrix_->getBulk(w << 5, y);
     }
-    if (blackCount[x] == linesMatrix->getHeight()) {
+  }
+
+  for (int x = BARCODE_START_OFFSET; x < width; x++) {
+    if ((blackColumns_[x >> 5] >> (x & 0x1f)) & 1) {
       if (!lastWasSymbolStart) {
         float currentWidth = (float)(x - symbolStart);
         // Make sure we really found a symbol by asserting a minimal size of 75% of the expected symbol width.
@@ -280,10 +303,10 @@ void LinesSampler::computeSymbolWidths(vector<float> &symbolWidths, const int sy
           // but if we are more than half an expected symbol width bigger, we assume that
           // we missed one or more symbols and assume that they were the expected symbol width.
           while (currentWidth > 1.5 * symbolWidth) {
-            symbolWidths.push_back(symbolWidth);
+            symbolWidths_.push_back(symbolWidth);
             currentWidth -= symbolWidth;
           }
-          symbolWidths.push_back(currentWidth);
+          symbolWidths_.push_back(currentWidth);
           lastWasSymbolStart = true;
           symbolStart = x;
         }
@@ -296,75 +319,74 @@ void LinesSampler::computeSymbolWidths(vector<float> &symbolWidths, const int sy
   }
 
   // The last symbol ends at the right edge of the matrix, where there usually is no black bar.
-  float currentWidth = (float)(linesMatrix->getWidth() - symbolStart);
+  float currentWidth = (float)(width - symbolStart);
   while (currentWidth > 1.5 * symbolWidth) {
-    symbolWidths.push_back(symbolWidth);
+    symbolWidths_.push_back(symbolWidth);
     currentWidth -= symbolWidth;
   }
-  symbolWidths.push_back(currentWidth);
+  symbolWidths_.push_back(currentWidth);
 
 
 #if PDF417_DIAG && OUTPUT_SYMBOL_WIDTH
   {
-    cout << "symbols per line: " << symbolsPerLine << endl;
-    cout << "symbol width (" << symbolWidths.size() << "): ";
-    for (int i = 0; i < symbolWidths.size(); i++) {
-      cout << symbolWidths[i] << ", ";
+    cout << "symbols per line: " << symbolsPerLine_ << endl;
+    cout << "symbol width (" << symbolWidths_.size() << "): ";
+    for (int i = 0; i < symbolWidths_.size(); i++) {
+      cout << symbolWidths_[i] << ", ";
     }
     cout << endl;
   }
 #endif
 }
 
-void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
-                                          const int symbolsPerLine,
-                                          const vector<float>& symbolWidths,
-                                          Ref<BitMatrix> linesMatrix,
-                                          vector<vector<int> >& codewords)
+void LinesSampler::linesMatrixToCodewords()
 {
-  for (int y = 0; y < linesMatrix->getHeight(); y++) {
-    // Not sure if this is the right way to handle this but avoids an error:
-    if (symbolsPerLine > (int)symbolWidths.size()) {
-      throw NotFoundException("Inconsistent number of symbols in this line.");
-    }
+  const int symbolsPerLine = symbolsPerLine_;
+  const int width = linesMatrix_->getWidth();
+  const int height = linesMatrix_->getHeight();
+  codewords_.assign(height * symbolsPerLine, 0);
+  clusterNumbers_.assign(height * symbolsPerLine, -1);
+  cwStarts_.resize(symbolsPerLine);
+
+  // Not sure if this is the right way to handle this but avoids an error:
+  if (height > 0 && symbolsPerLine > (int)symbolWidths_.size()) {
+    throw NotFoundException("Inconsistent number of symbols in this line.");
+  }
+
+  // TODO: use symbolWidths.size() instead of symbolsPerLine to at least decode some codewords
 
-    // TODO: use symbolWidths.size() instead of symbolsPerLine to at least decode some codewords
+  for (int y = 0; y < height; y++) {
+    int* codewords = &codewords_[y * symbolsPerLine];
+    int* clusterNumbers = &clusterNumbers_[y * symbolsPerLine];
+    row_ = linesMatrix_->getRow(y, row_);
+    BitArray& row = *row_;
 
-    codewords[y].resize(symbolsPerLine, 0);
-    clusterNumbers[y].resize(symbolsPerLine, -1);
-    int line = y;
-    vector<int> barWidths(1, 0);
-    int barCount = 0;
     // Runlength encode the bars in the scanned linesMatrix.
     // We assume that the first bar is black, as determined by the PDF417 standard.
-    bool isSetBar = true;
     // Filter small white bars at the beginning of the barcode.
     // Small white bars may occur due to small deviations in scan line sampling.
-    barWidths[0] += BARCODE_START_OFFSET;
-    for (int x = BARCODE_START_OFFSET; x < linesMatrix->getWidth(); x++) {
-      if (linesMatrix->get(x, line)) {
-        if (!isSetBar) {
-          isSetBar = true;
-          barCount++;
-          barWidths.resize(barWidths.size() + 1);
-        }
-      } else {
-        if (isSetBar) {
-          isSetBar = false;
-          barCount++;
-          barWidths.resize(barWidths.size() + 1);
-        }
-
+    barWidths_.clear();
+    bool isSetBar = true;
+    for (int x = BARCODE_START_OFFSET; x < width; isSetBar = !isSetBar) {
+      int end = isSetBar ? row.getNextUnset(x) : row.getNextSet(x);
+      if (end > width) {
+        end = width;
       }
-      barWidths[barCount]++;
+      barWidths_.push_back(end - x);
+      x = end;
     }
+    if (barWidths_.empty()) {
+      barWidths_.push_back(0);
+    }
+    barWidths_[0] += BARCODE_START_OFFSET;
+    const int barCount = barWidths_.size();
     // Don't forget the last bar.
-    barCount++;
-    barWidths.resize(barWidths.size() + 1);
+    barWidths_.push_back(0);
+    const int* barWidths = &barWidths_[0];
 
 #if PDF417_DIAG && OUTPUT_BAR_WIDTH
     {
-      for (int i = 0; i < barWidths.size(); i++) {
+      for (int i = 0; i < barWidths_.size(); i++) {
         cout << barWidths[i] << ", ";
       }
       cout << endl;
@@ -377,14 +399,16 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
     // We make sure, that the last bar of a symbol is always white, as determined by the PDF417 standard.
     // This helps to reduce the amount of errors done during the symbol recognition.
     // The symbolWidth usually is not constant over the width of the barcode.
+    int* cwStarts = &cwStarts_[0];
     int cwWidth = 0;
     int cwCount = 0;
-    vector<int> cwStarts(symbolsPerLine, 0);
-    cwStarts[0] = 0;
+    for (int i = 0; i < symbolsPerLine; i++) {
+      cwStarts[i] = 0;
+    }
     cwCount++;
     for (int i = 0; i < barCount && cwCount < symbolsPerLine; i++) {
       cwWidth += barWidths[i];
-      if ((float)cwWidth > symbolWidths[cwCount - 1]) {
+      if ((float)cwWidth > symbolWidths_[cwCount - 1]) {
         if ((i % 2) == 1) { // check if bar is white
           i++;
         }
@@ -396,7 +420,7 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 
 #if PDF417_DIAG && OUTPUT_CW_STARTS
     {
-      for (int i = 0; i < cwStarts.size(); i++) {
+      for (int i = 0; i < symbolsPerLine; i++) {
         cout << cwStarts[i] << ", ";
       }
       cout << endl;
@@ -405,10 +429,9 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
 
     ///////////////////////////////////////////
 
-    vector<vector<float> > cwRatios(symbolsPerLine);
+    float cwRatios[BARS_IN_SYMBOL];
     // Distribute bar widths to modules of a codeword.
     for (int i = 0; i < symbolsPerLine; i++) {
-      cwRatios[i].resize(BARS_IN_SYMBOL, 0.0f);
       const int cwStart = cwStarts[i];
       const int cwEnd = (i == symbolsPerLine - 1) ? barCount : cwStarts[i + 1];
       const int cwLength = cwEnd - cwStart;
@@ -429,12 +452,12 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
       // Assume the length of the symbol is symbolWidth and the last (unrecognized) bar uses all remaining space.
       if (cwLength == 7) {
         for (int j = 0; j < cwLength; ++j) {
-          cwRatios[i][j] = (float)barWidths[cwStart + j] / symbolWidths[i];
+          cwRatios[j] = (float)barWidths[cwStart + j] / symbolWidths_[i];
         }
-        cwRatios[i][7] = (symbolWidths[i] - cwWidth) / symbolWidths[i];
+        cwRatios[7] = (symbolWidths_[i] - cwWidth) / symbolWidths_[i];
       } else {
-        for (int j = 0; j < (int)cwRatios[i].size(); ++j) {
-          cwRatios[i][j] = (float)barWidths[cwStart + j] / cwWidth;
+        for (int j = 0; j < BARS_IN_SYMBOL; ++j) {
+          cwRatios[j] = (float)barWidths[cwStart + j] / cwWidth;
         }
       }
 
@@ -444,10 +467,11 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
       // Search for the most possible codeword by comparing the ratios of bar size to symbol width.
       // The sum of the squared differences is used as similarity metric.
       // (Picture it as the square euclidian distance in the space of eight tuples where a tuple represents the bar ratios.)
-      for (int j = 0; j < POSSIBLE_SYMBOLS; j++) {
+      const float* ratios = &RATIOS_TABLE[0];
+      for (int j = 0; j < POSSIBLE_SYMBOLS; j++, ratios += BARS_IN_SYMBOL) {
         float error = 0.0f;
         for (int k = 0; k < BARS_IN_SYMBOL; k++) {
-          float diff = RATIOS_TABLE[j * BARS_IN_SYMBOL + k] - cwRatios[i][k];
+          float diff = ratios[k] - cwRatios[k];
           error += diff * diff;
           if (error >= bestMatchError) {
             break;
@@ -458,61 +482,57 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
           bestMatch = BitMatrixParser::SYMBOL_TABLE[j];
         }
       }
-      codewords[y][i] = bestMatch;
-      clusterNumbers[y][i] = calculateClusterNumber(bestMatch);
+      codewords[i] = bestMatch;
+      clusterNumbers[i] = calculateClusterNumber(bestMatch);
     }
   }
 
 
 #if PDF417_DIAG && OUTPUT_CLUSTER_NUMBERS
   {
-    for (int i = 0; i < clusterNumbers.size(); i++) {
-      for (int j = 0; j < clusterNumbers[i].size(); j++) {
-        cout << clusterNumbers[i][j] << ", ";
+    for (int y = 0; y < height; y++) {
+      for (int i = 0; i < symbolsPerLine; i++) {
+        cout << clusterNumbers_[y * symbolsPerLine + i] << ", ";
       }
       cout << endl;
     }
   }
 #endif
-
-
-#if PDF417_DIAG
-  {
-    Ref<BitMatrix> bits(new BitMatrix(symbolsPerLine * MODULES_IN_SYMBOL, codewords.size()));
-    codewordsToBitMatrix(codewords, bits);
-    static int __cnt__ = 0;
-    stringstream ss;
-    ss << "pdf417-detectedRaw" << __cnt__++ << ".png";
-    bits->writePng(ss.str().c_str(), 8, 16);
-  }
-#endif
 }
 
-vector<vector<map<int,  int> > >
-LinesSampler::distributeVotes(const int symbolsPerLine,
-                              const vector<vector<int> >& codewords,
-                              const vector<vector<int> >& clusterNumbers)
+/**
+ * Collects the votes for the codewords of each row and column into votes_.
+ *
+ * @return the number of rows.
+ */
+int LinesSampler::distributeVotes()
 {
-  // Matrix of votes for codewords which are possible at this position.
-  vector<vector<map<int, int> > > votes(1);
-  votes[0].resize(symbolsPerLine);
+  const int symbolsPerLine = symbolsPerLine_;
+  const int lines = codewords_.size() / symbolsPerLine;
+  votes_.clear();
+  int rows = 1;
 
   int currentRow = 0;
-  map<int, int> clusterNumberVotes;
+  int clusterNumberVotes[9];
   int lastLineClusterNumber = -1;
 
-  for (int y = 0; y < (int)codewords.size(); y++) {
+  for (int y = 0; y < lines; y++) {
+    const int* codewords = &codewords_[y * symbolsPerLine];
+    const int* clusterNumbers = &clusterNumbers_[y * symbolsPerLine];
+
     // Vote for the most probable cluster number for this row.
-    clusterNumberVotes.clear();
-    for (int i = 0; i < (int)codewords[y].size(); i++) {
-      if (clusterNumbers[y][i] != -1) {
-        clusterNumberVotes[clusterNumbers[y][i]] = clusterNumberVotes[clusterNumbers[y][i]] + 1;
+    bool anyVotes = false;
+    memset(clusterNumberVotes, 0, sizeof(clusterNumberVotes));
+    for (int i = 0; i < symbolsPerLine; i++) {
+      if (clusterNumbers[i] != -1) {
+        clusterNumberVotes[clusterNumbers[i]]++;
+        anyVotes = true;
       }
     }
 
     // Ignore lines where no codeword could be read.
-    if (!clusterNumberVotes.empty()) {
-      VoteResult voteResult = getValueWithMaxVotes(clusterNumberVotes,0);
+    if (anyVotes) {
+      VoteResult voteResult = getValueWithMaxVotes(clusterNumberVotes, 9, 0);
       bool lineClusterNumberIsIndecisive = voteResult.isIndecisive();
       int lineClusterNumber = voteResult.getVote();
 
@@ -531,32 +551,23 @@ LinesSampler::distributeVotes(const int symbolsPerLine,
       if ((lineClusterNumber == 0 && lastLineClusterNumber == -1) || (lastLineClusterNumber != -1)) {
         if ((lineClusterNumber == ((lastLineClusterNumber + 3) % 9)) && (lastLineClusterNumber != -1)) {
           currentRow++;
-          if ((int)votes.size() < currentRow + 1) {
-            votes.resize(currentRow + 1);
-            votes[currentRow].resize(symbolsPerLine);
-          }
+          rows = std::max(rows, currentRow + 1);
         }
 
         if ((lineClusterNumber == ((lastLineClusterNumber + 6) % 9)) && (lastLineClusterNumber != -1)) {
           currentRow += 2;
-          if ((int)votes.size() < currentRow + 1) {
-            votes.resize(currentRow + 1);
-            votes[currentRow].resize(symbolsPerLine);
-          }
+          rows = std::max(rows, currentRow + 1);
         }
 
-        for (int i = 0; i < (int)codewords[y].size(); i++) {
-          if (clusterNumbers[y][i] != -1) {
-            if (clusterNumbers[y][i] == lineClusterNumber) {
-              votes[currentRow][i][codewords[y][i]] = votes[currentRow][i][codewords[y][i]] + 1;
-            } else if (clusterNumbers[y][i] == ((lineClusterNumber + 3) % 9)) {
-              if ((int)votes.size() < currentRow + 2) {
-                votes.resize(currentRow + 2);
-                votes[currentRow + 1].resize(symbolsPerLine);
-              }
-              votes[currentRow + 1][i][codewords[y][i]] = votes[currentRow + 1][i][codewords[y][i]] + 1;
-            } else if ((clusterNumbers[y][i] == ((lineClusterNumber + 6) % 9)) && (currentRow > 0)) {
-              votes[currentRow - 1][i][codewords[y][i]] = votes[currentRow - 1][i][codewords[y][i]] + 1;
+        for (int i = 0; i < symbolsPerLine; i++) {
+          if (clusterNumbers[i] != -1) {
+            if (clusterNumbers[i] == lineClusterNumber) {
+              votes_.push_back(Vote(currentRow, i, codewords[i]));
+            } else if (clusterNumbers[i] == ((lineClusterNumber + 3) % 9)) {
+              rows = std::max(rows, currentRow + 2);
+              votes_.push_back(Vote(currentRow + 1, i, codewords[i]));
+            } else if ((clusterNumbers[i] == ((lineClusterNumber + 6) % 9)) && (currentRow > 0)) {
+              votes_.push_back(Vote(currentRow - 1, i, codewords[i]));
             }
           }
         }
@@ -565,71 +576,82 @@ LinesSampler::distributeVotes(const int symbolsPerLine,
     }
   }
 
-  return votes;
+  return rows;
 }
 
+int LinesSampler::getRowClusterNumber(int row) const
+{
+  const int* codewords = &detectedCodeWords_[row * symbolsPerLine_];
+  for (int j = 0; j < symbolsPerLine_; j++) {
+    int clusterNumber = calculateClusterNumber(codewords[j]);
+    if (clusterNumber != -1) {
+      return clusterNumber;
+    }
+  }
+  return -1;
+}
 
-vector<int>
-LinesSampler::findMissingLines(const int symbolsPerLine, vector<vector<int> > &detectedCodeWords) {
-  vector<int> insertLinesAt;
-  if (detectedCodeWords.size() > 1) {
-    for (int i = 0; i < (int)detectedCodeWords.size() - 1; i++) {
-      int clusterNumberRow = -1;
-      for (int j = 0; j < (int)detectedCodeWords[i].size() && clusterNumberRow == -1; j++) {
-        int clusterNumber = calculateClusterNumber(detectedCodeWords[i][j]);
-        if (clusterNumber != -1) {
-          clusterNumberRow = clusterNumber;
-        }
-      }
+void LinesSampler::insertEmptyLines()
+{
+  for (int i = 0; i < (int)insertLinesAt_.size(); i++) {
+    detectedCodeWords_.insert(detectedCodeWords_.begin() + (insertLinesAt_[i] + i) * symbolsPerLine_,
+                              symbolsPerLine_, 0);
+  }
+}
+
+void LinesSampler::findMissingLines() {
+  const int rows = detectedCodeWords_.size() / symbolsPerLine_;
+  insertLinesAt_.clear();
+  if (rows > 1) {
+    for (int i = 0; i < rows - 1; i++) {
+      int clusterNumberRow = getRowClusterNumber(i);
       if (i == 0) {
         // The first line must have the cluster number 0. Insert empty lines to match this.
         if (clusterNumberRow > 0) {
-          insertLinesAt.push_back(0);
+          insertLinesAt_.push_back(0);
           if (clusterNumberRow > 3) {
-            insertLinesAt.push_back(0);
+            insertLinesAt_.push_back(0);
           }
         }
       }
-      int clusterNumberNextRow = -1;
-      for (int j = 0; j < (int)detectedCodeWords[i + 1].size() && clusterNumberNextRow == -1; j++) {
-        int clusterNumber = calculateClusterNumber(detectedCodeWords[i + 1][j]);
-        if (clusterNumber != -1) {
-          clusterNumberNextRow = clusterNumber;
-        }
-      }
+      int clusterNumberNextRow = getRowClusterNumber(i + 1);
       if ((clusterNumberRow + 3) % 9 != clusterNumberNextRow
           && clusterNumberRow != -1
           && clusterNumberNextRow != -1) {
         // The cluster numbers are not consecutive. Insert an empty line between them.
-        insertLinesAt.push_back(i + 1);
+        insertLinesAt_.push_back(i + 1);
         if (clusterNumberRow == clusterNumberNextRow) {
           // There may be two lines missing. This is detected when two consecutive lines have the same cluster number.
-          insertLinesAt.push_back(i + 1);
+          insertLinesAt_.push_back(i + 1);
         }
       }
     }
   }
 
-  for (int i = 0; i < (int)insertLinesAt.size(); i++) {
-    detectedCodeWords.insert(detectedCodeWords.begin() + insertLinesAt[i] + i, vector<int>(symbolsPerLine, 0));
-  }
-
-  return insertLinesAt;
+  insertEmptyLines();
 }
 
-int LinesSampler::decodeRowCount(const int symbolsPerLine, vector<vector<int> > &detectedCodeWords, vector<int> &insertLinesAt)
+int LinesSampler::decodeRowCount()
 {
   // Use the information in the first and last column to determin the number of rows and find more missing rows.
   // For missing rows insert blank space, so the error correction can try to fill them in.
 
-  map<int, int> rowCountVotes;
-  map<int, int> ecLevelVotes;
-  map<int, int> rowNumberVotes;
+  // Codewords are below 929, which limits what can be voted for
+  int rowCountVotes[90];
+  int ecLevelVotes[10];
+  int rowNumberVotes[31];
+  memset(rowCountVotes, 0, sizeof(rowCountVotes));
+  memset(ecLevelVotes, 0, sizeof(ecLevelVotes));
   int lastRowNumber = -1;
-  insertLinesAt.clear();
-
-  for (int i = 0; i + 2 < (int)detectedCodeWords.size(); i += 3) {
-    rowNumberVotes.clear();
+  insertLinesAt_.clear();
+
+  const int symbolsPerLine = symbolsPerLine_;
+  const int rows = detectedCodeWords_.size() / symbolsPerLine;
+  for (int i = 0; i + 2 < rows; i += 3) {
+    memset(rowNumberVotes, 0, sizeof(rowNumberVotes));
+    const int* first = &detectedCodeWords_[i * symbolsPerLine];
+    const int* second = first + symbolsPerLine;
+    const int* third = second + symbolsPerLine;
     int firstCodewordDecodedLeft = -1;
     int secondCodewordDecodedLeft = -1;
     int thirdCodewordDecodedLeft = -1;
@@ -637,83 +659,76 @@ int LinesSampler::decodeRowCount(const int symbolsPerLine, vector<vector<int> >
     int secondCodewordDecodedRight = -1;
     int thirdCodewordDecodedRight = -1;
 
-    if (detectedCodeWords[i][0] != 0) {
-      firstCodewordDecodedLeft = BitMatrixParser::getCodeword(detectedCodeWords[i][0]);
+    if (first[0] != 0) {
+      firstCodewordDecodedLeft = BitMatrixParser::getCodeword(first[0]);
     }
-    if (detectedCodeWords[i + 1][0] != 0) {
-      secondCodewordDecodedLeft = BitMatrixParser::getCodeword(detectedCodeWords[i + 1][0]);
+    if (second[0] != 0) {
+      secondCodewordDecodedLeft = BitMatrixParser::getCodeword(second[0]);
     }
-    if (detectedCodeWords[i + 2][0] != 0) {
-      thirdCodewordDecodedLeft = BitMatrixParser::getCodeword(detectedCodeWords[i + 2][0]);
+    if (third[0] != 0) {
+      thirdCodewordDecodedLeft = BitMatrixParser::getCodeword(third[0]);
     }
 
-    if (detectedCodeWords[i][detectedCodeWords[i].size() - 1] != 0) {
-      firstCodewordDecodedRight = BitMatrixParser::getCodeword(detectedCodeWords[i][detectedCodeWords[i].size() - 1]);
+    if (first[symbolsPerLine - 1] != 0) {
+      firstCodewordDecodedRight = BitMatrixParser::getCodeword(first[symbolsPerLine - 1]);
     }
-    if (detectedCodeWords[i + 1][detectedCodeWords[i + 1].size() - 1] != 0) {
-      secondCodewordDecodedRight = BitMatrixParser::getCodeword(detectedCodeWords[i + 1][detectedCodeWords[i + 1].size() - 1]);
+    if (second[symbolsPerLine - 1] != 0) {
+      secondCodewordDecodedRight = BitMatrixParser::getCodeword(second[symbolsPerLine - 1]);
     }
-    if (detectedCodeWords[i + 2][detectedCodeWords[i + 2].size() - 1] != 0) {
-      thirdCodewordDecodedRight = BitMatrixParser::getCodeword(detectedCodeWords[i + 2][detectedCodeWords[i + 2].size() - 1]);
+    if (third[symbolsPerLine - 1] != 0) {
+      thirdCodewordDecodedRight = BitMatrixParser::getCodeword(third[symbolsPerLine - 1]);
     }
 
     if (firstCodewordDecodedLeft != -1 && secondCodewordDecodedLeft != -1) {
       int leftRowCount = ((firstCodewordDecodedLeft % 30) * 3) + ((secondCodewordDecodedLeft % 30) % 3);
       int leftECLevel = (secondCodewordDecodedLeft % 30) / 3;
 
-      rowCountVotes[leftRowCount] = rowCountVotes[leftRowCount] + 1;
-      ecLevelVotes[leftECLevel] = ecLevelVotes[leftECLevel] + 1;
+      rowCountVotes[leftRowCount]++;
+      ecLevelVotes[leftECLevel]++;
     }
 
     if (secondCodewordDecodedRight != -1 && thirdCodewordDecodedRight != -1) {
       int rightRowCount = ((secondCodewordDecodedRight % 30) * 3) + ((thirdCodewordDecodedRight % 30) % 3);
       int rightECLevel = (thirdCodewordDecodedRight % 30) / 3;
 
-      rowCountVotes[rightRowCount] = rowCountVotes[rightRowCount] + 1;
-      ecLevelVotes[rightECLevel] = ecLevelVotes[rightECLevel] + 1;
+      rowCountVotes[rightRowCount]++;
+      ecLevelVotes[rightECLevel]++;
     }
 
     if (firstCodewordDecodedLeft != -1) {
-      int rowNumber = firstCodewordDecodedLeft / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[firstCodewordDecodedLeft / 30]++;
     }
     if (secondCodewordDecodedLeft != -1) {
-      int rowNumber = secondCodewordDecodedLeft / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[secondCodewordDecodedLeft / 30]++;
     }
     if (thirdCodewordDecodedLeft != -1) {
-      int rowNumber = thirdCodewordDecodedLeft / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[thirdCodewordDecodedLeft / 30]++;
     }
     if (firstCodewordDecodedRight != -1) {
-      int rowNumber = firstCodewordDecodedRight / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[firstCodewordDecodedRight / 30]++;
     }
     if (secondCodewordDecodedRight != -1) {
-      int rowNumber = secondCodewordDecodedRight / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[secondCodewordDecodedRight / 30]++;
     }
     if (thirdCodewordDecodedRight != -1) {
-      int rowNumber = thirdCodewordDecodedRight / 30;
-      rowNumberVotes[rowNumber] = rowNumberVotes[rowNumber] + 1;
+      rowNumberVotes[thirdCodewordDecodedRight / 30]++;
     }
-    int rowNumber = getValueWithMaxVotes(rowNumberVotes,0).getVote();
+    int rowNumber = getValueWithMaxVotes(rowNumberVotes, ZXING_ARRAY_LEN(rowNumberVotes), 0).getVote();
     if (lastRowNumber + 1 < rowNumber) {
       for (int j = lastRowNumber + 1; j < rowNumber; j++) {
-        insertLinesAt.push_back(i);
-        insertLinesAt.push_back(i);
-        insertLinesAt.push_back(i);
+        insertLinesAt_.push_back(i);
+        insertLinesAt_.push_back(i);
+        insertLinesAt_.push_back(i);
       }
     }
     lastRowNumber = rowNumber;
   }
 
-  for (int i = 0; i < (int)insertLinesAt.size(); i++) {
-    detectedCodeWords.insert(detectedCodeWords.begin() + insertLinesAt[i] + i, vector<int>(symbolsPerLine, 0));
-  }
+  insertEmptyLines();
 
-  int rowCount = getValueWithMaxVotes(rowCountVotes,detectedCodeWords.size()).getVote();
-  // int ecLevel = getValueWithMaxVotes(ecLevelVotes);
+  int rowCount = getValueWithMaxVotes(rowCountVotes, ZXING_ARRAY_LEN(rowCountVotes),
+                                      detectedCodeWords_.size() / symbolsPerLine).getVote();
+  // int ecLevel = getValueWithMaxVotes(ecLevelVotes, ZXING_ARRAY_LEN(ecLevelVotes), 0).getVote();
 
 #if PDF417_DIAG && OUTPUT_EC_LEVEL
   {
@@ -17,8 +17,9 @@
  * limitations under the License.
  */
 
-#include <map>
+#include <vector>
 #include <zxing/common/BitMatrix.h>
+#include <zxing/common/BitArray.h>
 #include <zxing/ResultPoint.h>
 #include <zxing/common/Point.h>
 
@@ -35,9 +36,38 @@ private:
   static std::vector<float> init_ratios_table();
   static const int BARCODE_START_OFFSET = 2;
 
+  // A vote for the codeword at the given row and column of the symbol
+  struct Vote {
+    int row;
+    int column;
+    int codeword;
+    Vote(int r, int c, int cw) : row(r), column(c), codeword(cw) {}
+    bool operator < (const Vote& other) const {
+      return row != other.row ? row < other.row :
+        column != other.column ? column < other.column :
+        codeword < other.codeword;
+    }
+    bool operator == (const Vote& other) const {
+      return row == other.row && column == other.column && codeword == other.codeword;
+    }
+  };
+
   Ref<BitMatrix> linesMatrix_;
   int symbolsPerLine_;
   int dimension_;
+
+  // Scratch space reused by subsequent sample() calls. Per-line and
+  // per-row data is stored row by row, symbolsPerLine_ entries per row.
+  Ref<BitArray> row_;
+  std::vector<unsigned int> blackColumns_;
+  std::vector<float> symbolWidths_;
+  std::vector<int> barWidths_;
+  std::vector<int> cwStarts_;
+  std::vector<int> codewords_;
+  std::vector<int> clusterNumbers_;
+  std::vector<Vote> votes_;
+  std::vector<int> detectedCodeWords_;
+  std::vector<int> insertLinesAt_;
   
   static std::vector<Ref<ResultPoint> > findVertices(Ref<BitMatrix> matrix, int rowStep);
   static std::vector<Ref<ResultPoint> > findVertices180(Ref<BitMatrix> matrix, int rowStep);
@@ -84,35 +114,22 @@ private:
                               int dimensionY,
                               int dimension);
 
-  static void codewordsToBitMatrix(std::vector<std::vector<int> > &codewords,
-                                   Ref<BitMatrix> &matrix);
+  void codewordsToBitMatrix(Ref<BitMatrix> &matrix);
   static int calculateClusterNumber(int codeword);
-  static Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image,
-                                   int dimension);
-  static void computeSymbolWidths(std::vector<float>& symbolWidths,
-                                  const int symbolsPerLine, Ref<BitMatrix> linesMatrix);
-  static void linesMatrixToCodewords(std::vector<std::vector<int> > &clusterNumbers,
-                                     const int symbolsPerLine,
-                                     const std::vector<float> &symbolWidths,
-                                     Ref<BitMatrix> linesMatrix,
-                                     std::vector<std::vector<int> > &codewords);
-  static std::vector<std::vector<std::map<int, int> > >
-      distributeVotes(const int symbolsPerLine,
-                      const std::vector<std::vector<int> >& codewords,
-                      const std::vector<std::vector<int> >& clusterNumbers);
-  static std::vector<int>
-      findMissingLines(const int symbolsPerLine,
-                       std::vector<std::vector<int> > &detectedCodeWords);
-  static int decodeRowCount(const int symbolsPerLine,
-                            std::vector<std::vector<int> > &detectedCodeWords,
-                            std::vector<int> &insertLinesAt);
+  void computeSymbolWidths();
+  void linesMatrixToCodewords();
+  int distributeVotes();
+  int getRowClusterNumber(int row) const;
+  void insertEmptyLines();
+  void findMissingLines();
+  int decodeRowCount();
 
   static int round(float d);
   static Point intersection(Line a, Line b);
 
 public:
-  LinesSampler(Ref<BitMatrix> linesMatrix, int dimension);
-  Ref<BitMatrix> sample();
+  LinesSampler();
+  Ref<BitMatrix> sample(Ref<BitMatrix> linesMatrix, int dimension);
 };
 
 }
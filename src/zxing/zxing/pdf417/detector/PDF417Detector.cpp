@@ -73,7 +73,8 @@ const int Detector::STOP_PATTERN_LENGTH = sizeof(STOP_PATTERN) / sizeof(int);
 const int Detector::STOP_PATTERN_REVERSE[] = {1, 2, 1, 1, 1, 3, 1, 1, 7};
 const int Detector::STOP_PATTERN_REVERSE_LENGTH = sizeof(STOP_PATTERN_REVERSE) / sizeof(int);
 
-Detector::Detector(Ref<BinaryBitmap> image) : image_(image) {}
+Detector::Detector(Ref<BinaryBitmap> image, LinesSampler* linesSampler) :
+  image_(image), linesSampler_(linesSampler) {}
 
 Ref<DetectorResult> Detector::detect() {
   return detect(DecodeHints());
@@ -117,7 +118,12 @@ Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
 
   // Deskew and sample lines from image.
   Ref<BitMatrix> linesMatrix = sampleLines(vertices, dimension, yDimension);
-  Ref<BitMatrix> linesGrid(LinesSampler(linesMatrix, dimension).sample());
+  Ref<BitMatrix> linesGrid;
+  if (linesSampler_) {
+    linesGrid = linesSampler_->sample(linesMatrix, dimension);
+  } else {
+    linesGrid = LinesSampler().sample(linesMatrix, dimension);
+  }
 
   ArrayRef< Ref<ResultPoint> > points(4);
   points[0] = vertices[5];
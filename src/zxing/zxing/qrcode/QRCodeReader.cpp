@@ -21,6 +21,7 @@
 
 #include <zxing/qrcode/QRCodeReader.h>
 #include <zxing/qrcode/detector/Detector.h>
+#include <zxing/ReaderException.h>
 
 #include <iostream>
 
@@ -29,14 +30,100 @@ namespace zxing {
 
         using namespace std;
 
-        QRCodeReader::QRCodeReader() :decoder_() {
+        // Number of frames the last known location survives without a successful decode
+        int QRCodeReader::MAX_CONFIDENCE = 3;
+
+        QRCodeReader::QRCodeReader() :decoder_(), confidence_(0), tracked_(false), inverted_(false) {
         }
         //TODO : see if any of the other files in the qrcode tree need tryHarder
-        Ref<Result> QRCodeReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-            Detector detector(image->getBlackMatrix());
-            Ref<DetectorResult> detectorResult(detector.detect(hints));
+        Ref<Result> QRCodeReader::decode(Ref<BinaryBitmap> image, DecodeHints const& hints) {
+            Ref<BitMatrix> matrix(image->getBlackMatrix());
+            tracked_ = false;
+            if (!hints.getTryInverted()) {
+                return decode(matrix, hints);
+            }
+
+            // The other polarity is only flipped when it's needed, most
+            // frames have no code in them at all
+            bool wasInverted = inverted_;
+            try {
+                return decode(wasInverted ? invert(matrix) : matrix, hints);
+            } catch (ReaderException const& re) {
+                (void)re;
+            }
+
+            // The other polarity usually finds nothing, which would make
+            // the next frame forget where this one saw the code. Keep the
+            // tracking state unless the other polarity actually decodes.
+            Ref<FinderPatternInfo> lastInfo(lastInfo_);
+            Ref<AlignmentPattern> lastAlignment(lastAlignment_);
+            int confidence = confidence_;
+            try {
+                Ref<Result> result(decode(wasInverted ? matrix : invert(matrix), hints));
+                inverted_ = !wasInverted;
+                return result;
+            } catch (ReaderException const& re) {
+                (void)re;
+                lastInfo_ = lastInfo;
+                lastAlignment_ = lastAlignment;
+                confidence_ = confidence;
+                throw;
+            }
+        }
+
+        // Flipping the black matrix thresholds the same luminance the other
+        // way round, without another pass over the image. The matrix may be
+        // shared with other readers, so this flips a copy.
+        Ref<BitMatrix> QRCodeReader::invert(Ref<BitMatrix> matrix) {
+            Ref<BitMatrix> inverted(matrix->clone());
+            inverted->flip();
+            return inverted;
+        }
+
+        Ref<Result> QRCodeReader::decode(Ref<BitMatrix> matrix, DecodeHints const& hints) {
+            Detector detector(matrix);
+            Ref<DetectorResult> detectorResult;
+            bool tracked = false;
+            if (confidence_ > 0) {
+                try {
+                    detectorResult = detector.track(hints, lastInfo_, lastAlignment_);
+                    tracked = tracked_ = true;
+                } catch (ReaderException const& re) {
+                    (void)re;
+                    // fall back to the full search
+                }
+            }
+            if (!tracked) {
+                try {
+                    detectorResult = detector.detect(hints);
+                } catch (ReaderException const& re) {
+                    // Nothing in view anymore
+                    confidence_ = 0;
+                    lastInfo_.reset(0);
+                    lastAlignment_.reset(0);
+                    throw;
+                }
+            }
+
+            // Even if the decoding fails, the next frame is likely to
+            // show the code at about the same place
+            lastInfo_ = detector.getFinderPatternInfo();
+            lastAlignment_ = detector.getAlignmentPattern();
+            confidence_ = tracked ? confidence_ - 1 : 1;
+
             ArrayRef< Ref<ResultPoint> > points (detectorResult->getPoints());
-            Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+            Ref<DecoderResult> decoderResult;
+            try {
+                decoderResult = decoder_.decode(detectorResult->getBits(), hints.getTryMirrored());
+            } catch (ReaderException const& re) {
+                (void)re;
+                // Noise and blur flip single modules, which a vote of
+                // several pixels per module often gets right. It's three
+                // times slower, so only for codes that didn't decode.
+                decoderResult = decoder_.decode(detector.resampleGrid(GridSampler::MAJORITY),
+                                                hints.getTryMirrored());
+            }
+            confidence_ = MAX_CONFIDENCE;
             Ref<Result> result(
                                new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat::QR_CODE, decoderResult->charSet()));
             return result;
@@ -45,6 +132,10 @@ namespace zxing {
         QRCodeReader::~QRCodeReader() {
         }
 
+        bool QRCodeReader::wasTracked() const {
+            return tracked_;
+        }
+
     Decoder& QRCodeReader::getDecoder() {
         return decoder_;
     }
@@ -23,6 +23,8 @@
 
 #include <zxing/Reader.h>
 #include <zxing/qrcode/decoder/Decoder.h>
+#include <zxing/qrcode/detector/FinderPatternInfo.h>
+#include <zxing/qrcode/detector/AlignmentPattern.h>
 #include <zxing/DecodeHints.h>
 
 namespace zxing {
@@ -30,7 +32,23 @@ namespace qrcode {
 		
 class QRCodeReader : public Reader {
  private:
+  static int MAX_CONFIDENCE;
+
   Decoder decoder_;
+
+  // Where the code was seen last time. When decoding a sequence of frames,
+  // these are checked before searching the whole image, for as long as
+  // confidence_ stays above zero.
+  Ref<FinderPatternInfo> lastInfo_;
+  Ref<AlignmentPattern> lastAlignment_;
+  int confidence_;
+  // Whether the last decode() got anywhere with track()
+  bool tracked_;
+  // The last code was light on dark; try that polarity first
+  bool inverted_;
+
+  Ref<Result> decode(Ref<BitMatrix> matrix, DecodeHints const& hints);
+  static Ref<BitMatrix> invert(Ref<BitMatrix> matrix);
 			
  protected:
   Decoder& getDecoder();
@@ -39,7 +57,8 @@ class QRCodeReader : public Reader {
   QRCodeReader();
   virtual ~QRCodeReader();
 			
-  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints const& hints);
+  bool wasTracked() const;
 };
 
 }
@@ -24,6 +24,7 @@
 #include <limits>
 #include <iostream>
 #include <cstdarg>
+#include <pthread.h>
 
 using std::vector;
 using std::numeric_limits;
@@ -57,9 +58,18 @@ int ECBlocks::getECCodewordsPerBloc()
   return ecCodewordsPerBloc_;
 }
 
+int ECBlocks::getNumBlocks()
+{
+  int total = 0;
+  for (size_t i = 0; i < ecBlocks_.size(); i++) {
+    total += ecBlocks_[i]->getCount();
+  }
+  return total;
+}
+
 int ECBlocks::getTotalECCodewords()
 {
-    return ecCodewordsPerBloc_ * ecBlocks_.size();
+  return ecCodewordsPerBloc_ * getNumBlocks();
 }
 
 std::vector<ECB*>& ECBlocks::getECBlocks() {
@@ -123,7 +133,8 @@ Ref<Version> Version::getVersionForNumber(int versionNumber) {
 
 Version::Version(int versionNumber, vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
                  ECBlocks *ecBlocks3, ECBlocks *ecBlocks4) :
-    versionNumber_(versionNumber), alignmentPatternCenters_(*alignmentPatternCenters), ecBlocks_(4), totalCodewords_(0) {
+    versionNumber_(versionNumber), alignmentPatternCenters_(*alignmentPatternCenters), ecBlocks_(4), totalCodewords_(0),
+    codewordPlacement_(0) {
   ecBlocks_[0] = ecBlocks1;
   ecBlocks_[1] = ecBlocks2;
   ecBlocks_[2] = ecBlocks3;
@@ -140,6 +151,7 @@ Version::Version(int versionNumber, vector<int> *alignmentPatternCenters, ECBloc
 }
 
 Version::~Version() {
+  delete codewordPlacement_;
   delete &alignmentPatternCenters_;
   for (size_t i = 0; i < ecBlocks_.size(); i++) {
     delete ecBlocks_[i];
@@ -213,6 +225,57 @@ Ref<BitMatrix> Version::buildFunctionPattern() {
   return functionPattern;
 }
 
+namespace {
+
+// Versions are shared between decoders, which may run on different
+// threads. Building a table happens once per version and looking it up
+// once per symbol, so a plain mutex costs nothing worth mentioning.
+pthread_mutex_t codewordPlacementMutex = PTHREAD_MUTEX_INITIALIZER;
+
+class CodewordPlacementLock {
+public:
+  CodewordPlacementLock() { pthread_mutex_lock(&codewordPlacementMutex); }
+  ~CodewordPlacementLock() { pthread_mutex_unlock(&codewordPlacementMutex); }
+};
+
+}
+
+vector<unsigned short> const& Version::getCodewordPlacement() {
+  CodewordPlacementLock lock;
+  if (!codewordPlacement_) {
+    codewordPlacement_ = buildCodewordPlacement();
+  }
+  return *codewordPlacement_;
+}
+
+vector<unsigned short>* Version::buildCodewordPlacement() {
+  int dimension = getDimensionForVersion();
+  Ref<BitMatrix> functionPattern = buildFunctionPattern();
+  size_t numBits = totalCodewords_ * 8;
+  vector<unsigned short>* placement = new vector<unsigned short>();
+  placement->reserve(numBits);
+
+  bool readingUp = true;
+  // Columns in pairs, from right to left
+  for (int x = dimension - 1; x > 0 && placement->size() < numBits; x -= 2) {
+    if (x == 6) {
+      // Skip whole column with vertical alignment pattern
+      x--;
+    }
+    // Alternatingly from bottom to top then top to bottom
+    for (int counter = 0; counter < dimension; counter++) {
+      int y = readingUp ? dimension - 1 - counter : counter;
+      for (int col = 0; col < 2; col++) {
+        if (!functionPattern->get(x - col, y) && placement->size() < numBits) {
+          placement->push_back((unsigned short)((y << 8) | (x - col)));
+        }
+      }
+    }
+    readingUp = !readingUp;
+  }
+  return placement;
+}
+
 static vector<int> *intArray(size_t n...) {
   va_list ap;
   va_start(ap, n);
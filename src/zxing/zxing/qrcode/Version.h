@@ -48,6 +48,7 @@ public:
   ECBlocks(int ecCodewordsPerBloc, ECB *ecBlocks);
   ECBlocks(int ecCodewordsPerBloc, ECB *ecBlocks1, ECB *ecBlocks2);
   int getECCodewordsPerBloc();
+  int getNumBlocks();
   int getTotalECCodewords();
   std::vector<ECB*>& getECBlocks();
   ~ECBlocks();
@@ -60,8 +61,10 @@ private:
   std::vector<int> &alignmentPatternCenters_;
   std::vector<ECBlocks*> ecBlocks_;
   int totalCodewords_;
+  std::vector<unsigned short>* codewordPlacement_;
   Version(int versionNumber, std::vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
           ECBlocks *ecBlocks3, ECBlocks *ecBlocks4);
+  std::vector<unsigned short>* buildCodewordPlacement();
 
 public:
   static unsigned int VERSION_DECODE_INFO[];
@@ -78,6 +81,13 @@ public:
   static Ref<Version> getVersionForNumber(int versionNumber);
   static Ref<Version> decodeVersionInformation(unsigned int versionBits);
   Ref<BitMatrix> buildFunctionPattern();
+  /**
+   * The module holding each codeword bit in the zigzag reading order, most
+   * significant bit of codeword 0 first; function patterns are skipped.
+   * Each entry is (y << 8) | x. Built on first use, under a lock, as all
+   * 40 tables would take 860 KB.
+   */
+  std::vector<unsigned short> const& getCodewordPlacement();
   static int buildVersions();
 };
 }
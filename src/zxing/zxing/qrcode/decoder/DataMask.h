@@ -33,6 +33,12 @@ class DataMask : public Counted {
 private:
   static std::vector<Ref<DataMask> > DATA_MASKS;
 
+  // All eight masks repeat every 12 rows and every 12 columns, so the
+  // mask bits of a 32 bit word of a row only depend on the row mod 12 and
+  // on the word's first column mod 12, which cycles through 0, 8 and 4
+  unsigned int words_[12][3];
+  void buildWords();
+
 protected:
 
 public:
@@ -56,9 +56,6 @@ private:
   static void decodeAlphanumericSegment(Ref<BitSource> bits, std::string &result, int count, bool fc1InEffect);
   static void decodeNumericSegment(Ref<BitSource> bits, std::string &result, int count);
 
-  static void append(std::string &ost, const byte *bufIn, size_t nIn, const char *src);
-  static void append(std::string &ost, std::string const& in, const char *src);
-
 public:
   static Ref<DecoderResult> decode(ArrayRef<byte> bytes,
                                    Version *version,
@@ -25,6 +25,7 @@
 #include <zxing/common/Array.h>
 #include <zxing/common/DecoderResult.h>
 #include <zxing/common/BitMatrix.h>
+#include <zxing/qrcode/decoder/BitMatrixParser.h>
 
 namespace zxing {
 namespace qrcode {
@@ -34,10 +35,15 @@ private:
   ReedSolomonDecoder rsDecoder_;
 
   void correctErrors(ArrayRef<byte> bytes, int numDataCodewords);
+  Ref<DecoderResult> decode(BitMatrixParser& parser);
 
 public:
   Decoder();
-  Ref<DecoderResult> decode(Ref<BitMatrix> bits);
+  /**
+   * @param tryMirrored if the symbol does not decode, transpose it and try
+   *        again, for codes seen from the back
+   */
+  Ref<DecoderResult> decode(Ref<BitMatrix> bits, bool tryMirrored = false);
 };
 
 }
@@ -25,12 +25,15 @@
 namespace zxing {
 namespace qrcode {
 
+using std::vector;
+
 int BitMatrixParser::copyBit(size_t x, size_t y, int versionBits) {
-  return bitMatrix_->get(x, y) ? (versionBits << 1) | 0x1 : versionBits << 1;
+  bool bit = mirror_ ? bitMatrix_->get(y, x) : bitMatrix_->get(x, y);
+  return bit ? (versionBits << 1) | 0x1 : versionBits << 1;
 }
 
 BitMatrixParser::BitMatrixParser(Ref<BitMatrix> bitMatrix) :
-    bitMatrix_(bitMatrix), parsedVersion_(0), parsedFormatInfo_() {
+    bitMatrix_(bitMatrix), parsedVersion_(0), parsedFormatInfo_(), mirror_(false) {
   size_t dimension = bitMatrix->getHeight();
   if ((dimension < 21) || (dimension & 0x03) != 1) {
     throw ReaderException("Dimension must be 1 mod 4 and >= 21");
@@ -120,61 +123,30 @@ ArrayRef<byte> BitMatrixParser::readCodewords() {
   Ref<FormatInformation> formatInfo = readFormatInformation();
   Version *version = readVersion();
 
-
   // Get the data mask for the format used in this QR Code. This will exclude
   // some bits from reading as we wind through the bit matrix.
   DataMask &dataMask = DataMask::forReference((int)formatInfo->getDataMask());
-  //	cout << (int)formatInfo->getDataMask() << endl;
   int dimension = bitMatrix_->getHeight();
   dataMask.unmaskBitMatrix(*bitMatrix_, dimension);
 
-
-  //		cerr << *bitMatrix_ << endl;
-  //	cerr << version->getTotalCodewords() << endl;
-
-  Ref<BitMatrix> functionPattern = version->buildFunctionPattern();
-
-
-  //	cout << *functionPattern << endl;
-
-  bool readingUp = true;
-  ArrayRef<byte> result(version->getTotalCodewords());
-  int resultOffset = 0;
-  int currentByte = 0;
-  int bitsRead = 0;
-  // Read columns in pairs, from right to left
-  for (int x = dimension - 1; x > 0; x -= 2) {
-    if (x == 6) {
-      // Skip whole column with vertical alignment pattern;
-      // saves time and makes the other code proceed more cleanly
-      x--;
-    }
-    // Read alternatingly from bottom to top then top to bottom
-    for (int counter = 0; counter < dimension; counter++) {
-      int y = readingUp ? dimension - 1 - counter : counter;
-      for (int col = 0; col < 2; col++) {
-        // Ignore bits covered by the function pattern
-        if (!functionPattern->get(x - col, y)) {
-          // Read a bit
-          bitsRead++;
-          currentByte <<= 1;
-          if (bitMatrix_->get(x - col, y)) {
-            currentByte |= 1;
-          }
-          // If we've made a whole byte, save it off
-          if (bitsRead == 8) {
-            result[resultOffset++] = (byte)currentByte;
-            bitsRead = 0;
-            currentByte = 0;
-          }
-        }
-      }
-    }
-    readingUp = !readingUp; // switch directions
+  // The zigzag order, with function patterns left out, is the same for
+  // every symbol of a version
+  vector<unsigned short> const& placement = version->getCodewordPlacement();
+  int totalCodewords = version->getTotalCodewords();
+  if (placement.size() != size_t(totalCodewords) * 8) {
+    throw ReaderException("Did not read all codewords");
   }
 
-  if (resultOffset != version->getTotalCodewords()) {
-    throw ReaderException("Did not read all codewords");
+  BitMatrix const& bits = *bitMatrix_;
+  ArrayRef<byte> result(totalCodewords);
+  unsigned short const* module = &placement[0];
+  for (int i = 0; i < totalCodewords; i++) {
+    int currentByte = 0;
+    for (int bit = 0; bit < 8; bit++) {
+      int position = *module++;
+      currentByte = (currentByte << 1) | (int)bits.get(position & 0xff, position >> 8);
+    }
+    result[i] = (byte)currentByte;
   }
   return result;
 }
@@ -44,12 +44,31 @@ DataMask &DataMask::forReference(int reference) {
 }
 
 void DataMask::unmaskBitMatrix(BitMatrix& bits, size_t dimension) {
+  int tailBits = dimension & 0x1f;
+  unsigned int tailMask = tailBits ? (1u << tailBits) - 1 : ~0u;
   for (size_t y = 0; y < dimension; y++) {
-    for (size_t x = 0; x < dimension; x++) {
-      // TODO: check why the coordinates have to be swapped
-      if (isMasked(y, x)) {
-        bits.flip(x, y);
+    unsigned int const* row = words_[y % 12];
+    for (size_t x = 0, word = 0; x < dimension; x += 32, word++) {
+      unsigned int mask = row[word % 3];
+      if (x + 32 > dimension) {
+        mask &= tailMask;
       }
+      bits.setBulk(x, y, (int)((unsigned int)bits.getBulk(x, y) ^ mask));
+    }
+  }
+}
+
+void DataMask::buildWords() {
+  for (size_t y = 0; y < 12; y++) {
+    for (size_t word = 0; word < 3; word++) {
+      unsigned int mask = 0;
+      for (size_t bit = 0; bit < 32; bit++) {
+        // TODO: check why the coordinates have to be swapped
+        if (isMasked(y, word * 32 + bit)) {
+          mask |= 1u << bit;
+        }
+      }
+      words_[y][word] = mask;
     }
   }
 }
@@ -152,6 +171,9 @@ int DataMask::buildDataMasks() {
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask101()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask110()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask111()));
+  for (size_t i = 0; i < DATA_MASKS.size(); i++) {
+    DATA_MASKS[i]->buildWords();
+  }
   return DATA_MASKS.size();
 }
 
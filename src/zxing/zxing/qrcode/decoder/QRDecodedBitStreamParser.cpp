@@ -22,22 +22,8 @@
 #include <zxing/qrcode/decoder/DecodedBitStreamParser.h>
 #include <zxing/common/CharacterSetECI.h>
 #include <zxing/FormatException.h>
-#include <zxing/common/StringUtils.h>
+#include <zxing/common/TextDecoder.h>
 #include <iostream>
-#ifndef NO_ICONV
-#include <iconv.h>
-#endif
-
-// Required for compatibility. TODO : test on Symbian
-#ifdef ZXING_ICONV_CONST
-#undef ICONV_CONST
-#define ICONV_CONST const
-#endif
-
-#ifndef ICONV_CONST
-#define ICONV_CONST /**/
-#endif
-#include <qglobal.h>
 
 
 using namespace std;
@@ -54,59 +40,6 @@ const char DecodedBitStreamParser::ALPHANUMERIC_CHARS[] =
 
 namespace {int GB2312_SUBSET = 1;}
 
-void DecodedBitStreamParser::append(std::string &result,
-                                    string const& in,
-                                    const char *src) {
-    append(result, (byte const*)in.c_str(), in.length(), src);
-}
-
-void DecodedBitStreamParser::append(std::string &result,
-                                    const byte *bufIn,
-                                    size_t nIn,
-                                    const char *src) {
-#ifndef NO_ICONV
-    if (nIn == 0) {
-        return;
-    }
-
-    iconv_t cd = iconv_open(StringUtils::UTF8, src);
-    if (cd == (iconv_t)-1) {
-        result.append((const char *)bufIn, nIn);
-        return;
-    }
-
-    const int maxOut = 4 * nIn + 1;
-    char* bufOut = new char[maxOut];
-
-    ICONV_CONST char *fromPtr = (ICONV_CONST char *)bufIn;
-    size_t nFrom = nIn;
-    char *toPtr = (char *)bufOut;
-    size_t nTo = maxOut;
-
-    while (nFrom > 0) {
-#if defined(Q_OS_SYMBIAN)
-    size_t oneway = iconv(cd,(const char**) &fromPtr, &nFrom, &toPtr, &nTo);
-#else
-    size_t oneway = iconv(cd,(char**) &fromPtr, &nFrom, &toPtr, &nTo);
-#endif
-        if (oneway == (size_t)(-1)) {
-            iconv_close(cd);
-            delete[] bufOut;
-            throw ReaderException("error converting characters");
-        }
-    }
-    iconv_close(cd);
-
-    int nResult = maxOut - nTo;
-    bufOut[nResult] = '\0';
-    result.append((const char *)bufOut);
-    delete[] bufOut;
-#else
-    Q_UNUSED(src);
-    result.append((const char *)bufIn, nIn);
-#endif
-}
-
 void DecodedBitStreamParser::decodeHanziSegment(Ref<BitSource> bits_,
                                                 string& result,
                                                 int count) {
@@ -139,7 +72,7 @@ void DecodedBitStreamParser::decodeHanziSegment(Ref<BitSource> bits_,
     }
 
     try {
-        append(result, buffer, nBytes, StringUtils::GB2312);
+        TextDecoder::append(result, buffer, nBytes, TextDecoder::GBK);
     } catch (ReaderException const& ignored) {
         (void)ignored;
         delete [] buffer;
@@ -173,7 +106,7 @@ void DecodedBitStreamParser::decodeKanjiSegment(Ref<BitSource> bits, std::string
         count--;
     }
     try {
-        append(result, buffer, nBytes, StringUtils::SHIFT_JIS);
+        TextDecoder::append(result, buffer, nBytes, TextDecoder::SHIFT_JIS);
     } catch (ReaderException const& ignored) {
         (void)ignored;
         delete [] buffer;
@@ -201,18 +134,18 @@ std::string DecodedBitStreamParser::decodeByteSegment(Ref<BitSource> bits_,
         readBytes[i] = (byte) bits.readBits(8);
     }
     string encoding;
-    if (currentCharacterSetECI == 0) {
-        // The spec isn't clear on this mode; see
-        // section 6.4.5: t does not say which encoding to assuming
-        // upon decoding. I have seen ISO-8859-1 used as well as
-        // Shift_JIS -- without anything like an ECI designator to
-        // give a hint.
-        encoding = StringUtils::guessEncoding(readBytes, count, hints);
-    } else {
-        encoding = currentCharacterSetECI->name();
-    }
     try {
-        append(result, readBytes, nBytes, encoding.c_str());
+        if (currentCharacterSetECI == 0) {
+            // The spec isn't clear on this mode; see
+            // section 6.4.5: t does not say which encoding to assuming
+            // upon decoding. I have seen ISO-8859-1 used as well as
+            // Shift_JIS -- without anything like an ECI designator to
+            // give a hint.
+            encoding = TextDecoder::appendGuessed(result, readBytes, nBytes, hints);
+        } else {
+            encoding = currentCharacterSetECI->name();
+            TextDecoder::append(result, readBytes, nBytes, encoding.c_str());
+        }
     } catch (ReaderException const& ignored) {
         (void)ignored;
         throw FormatException();
@@ -271,7 +204,7 @@ void DecodedBitStreamParser::decodeNumericSegment(Ref<BitSource> bits, std::stri
         }
         bytes[i++] = ALPHANUMERIC_CHARS[digitBits];
     }
-    append(result, bytes, nBytes, StringUtils::ASCII);
+    result.append((char const*) bytes, nBytes);
     delete[] bytes;
 }
 
@@ -325,7 +258,7 @@ void DecodedBitStreamParser::decodeAlphanumericSegment(Ref<BitSource> bits_,
         }
         s = r.str();
     }
-    append(result, s, StringUtils::ASCII);
+    result.append(s);
 }
 
 namespace {
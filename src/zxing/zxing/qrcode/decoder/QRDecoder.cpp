@@ -63,12 +63,29 @@ void Decoder::correctErrors(ArrayRef<byte> codewordBytes, int numDataCodewords)
   }
 }
 
-Ref<DecoderResult> Decoder::decode(Ref<BitMatrix> bits) {
-  // Construct a parser and read version, error-correction level
+Ref<DecoderResult> Decoder::decode(Ref<BitMatrix> bits, bool tryMirrored) {
   BitMatrixParser parser(bits);
+  if (!tryMirrored) {
+    return decode(parser);
+  }
+  try {
+    return decode(parser);
+  } catch (ReaderException const& re) {
+    (void)re;
+    // The sampled symbol is a mirror image when the code was seen from the
+    // back. Put the data mask back, check that the format and version read
+    // transposed, and only then transpose the symbol in place.
+    parser.remask();
+    parser.setMirror(true);
+    parser.readVersion();
+    parser.readFormatInformation();
+    parser.mirror();
+    return decode(parser);
+  }
+}
 
-  // std::cerr << *bits << std::endl;
-
+Ref<DecoderResult> Decoder::decode(BitMatrixParser& parser) {
+  // Read version, error-correction level
   Version *version = parser.readVersion();
   ErrorCorrectionLevel &ecLevel = parser.readFormatInformation()->getErrorCorrectionLevel();
 
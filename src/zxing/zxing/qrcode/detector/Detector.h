@@ -26,6 +26,7 @@
 #include <zxing/common/BitMatrix.h>
 #include <zxing/qrcode/detector/AlignmentPattern.h>
 #include <zxing/common/PerspectiveTransform.h>
+#include <zxing/common/GridSampler.h>
 #include <zxing/ResultPointCallback.h>
 #include <zxing/qrcode/detector/FinderPatternInfo.h>
 
@@ -39,12 +40,17 @@ class Detector : public Counted {
 private:
   Ref<BitMatrix> image_;
   Ref<ResultPointCallback> callback_;
+  Ref<FinderPatternInfo> info_;
+  Ref<AlignmentPattern> alignment_;
+  Ref<PerspectiveTransform> transform_;
+  int dimension_;
 
 protected:
   Ref<BitMatrix> getImage() const;
   Ref<ResultPointCallback> getResultPointCallback() const;
 
-  static Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform>);
+  static Ref<BitMatrix> sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform>,
+                                   GridSampler::Sampling sampling = GridSampler::NEAREST);
   static int computeDimension(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft,
                               float moduleSize);
   float calculateModuleSize(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft);
@@ -53,13 +59,27 @@ protected:
   float sizeOfBlackWhiteBlackRun(int fromX, int fromY, int toX, int toY);
   Ref<AlignmentPattern> findAlignmentInRegion(float overallEstModuleSize, int estAlignmentX, int estAlignmentY,
       float allowanceFactor);
-  Ref<DetectorResult> processFinderPatternInfo(Ref<FinderPatternInfo> info);
+  Ref<DetectorResult> processFinderPatternInfo(Ref<FinderPatternInfo> info,
+      Ref<ResultPoint> expectedAlignment = Ref<ResultPoint>());
 public:
   virtual Ref<PerspectiveTransform> createTransform(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref <
       ResultPoint > bottomLeft, Ref<ResultPoint> alignmentPattern, int dimension);
 
   Detector(Ref<BitMatrix> image);
   Ref<DetectorResult> detect(DecodeHints const& hints);
+  /**
+   * Like detect() but only verifies that the patterns found in a previous
+   * image of the same code are still there, give or take a few modules.
+   */
+  Ref<DetectorResult> track(DecodeHints const& hints, Ref<FinderPatternInfo> previousInfo,
+      Ref<AlignmentPattern> previousAlignment);
+
+  /** The patterns the last successful detect() or track() was based on */
+  Ref<FinderPatternInfo> getFinderPatternInfo() const;
+  Ref<AlignmentPattern> getAlignmentPattern() const;
+
+  /** Samples the grid of the last detect() or track() again, the other way */
+  Ref<BitMatrix> resampleGrid(GridSampler::Sampling sampling) const;
 
 
 };
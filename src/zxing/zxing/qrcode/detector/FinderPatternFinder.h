@@ -41,6 +41,7 @@ private:
 protected:
   static int MIN_SKIP;
   static int MAX_MODULES;
+  static int TRACKING_RADIUS;
 
   Ref<BitMatrix> image_;
   std::vector<Ref<FinderPattern> > possibleCenters_;
@@ -49,6 +50,19 @@ protected:
   Ref<ResultPointCallback> callback_;
   mutable int crossCheckStateCount[5];
 
+  // Run lengths of the row (or the part of it) being scanned, starting
+  // with a (possibly empty) white run
+  Ref<BitArray> row_;
+  std::vector<int> runs_;
+
+  // Column-major copy of the 32 columns sharing a word with the last
+  // vertical cross-check, covering rows [columnsTop_, columnsBottom_)
+  std::vector<unsigned int> columns_;
+  int columnsX_;
+  int columnsTop_;
+  int columnsBottom_;
+  int columnWords_;
+
   /** stateCount must be int[5] */
   static float centerFromEnd(int* stateCount, int end);
   static bool foundPatternCross(int* stateCount);
@@ -56,8 +70,12 @@ protected:
   float crossCheckVertical(size_t startI, size_t centerJ, int maxCount, int originalStateCountTotal);
   float crossCheckHorizontal(size_t startJ, size_t centerI, int maxCount, int originalStateCountTotal);
 
+  void encodeRow(int y, int left, int right);
+  unsigned int const* transposedColumn(int x, int top, int bottom);
+
   /** stateCount must be int[5] */
   bool handlePossibleCenter(int* stateCount, size_t i, size_t j);
+  Ref<FinderPattern> findInRegion(Ref<FinderPattern> previous);
   int findRowSkip();
   bool haveMultiplyConfirmedCenters();
   std::vector<Ref<FinderPattern> > selectBestPatterns();
@@ -73,6 +91,8 @@ public:
   static float distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2);
   FinderPatternFinder(Ref<BitMatrix> image, Ref<ResultPointCallback>const&);
   Ref<FinderPatternInfo> find(DecodeHints const& hints);
+  /** Only looks around the patterns found in a previous image of the same code */
+  Ref<FinderPatternInfo> findNear(Ref<FinderPatternInfo> previous);
 };
 }
 }
@@ -52,7 +52,7 @@ using zxing::qrcode::FinderPatternInfo;
 using zxing::ResultPoint;
 
 Detector::Detector(Ref<BitMatrix> image) :
-  image_(image) {
+  image_(image), dimension_(0) {
 }
 
 Ref<BitMatrix> Detector::getImage() const {
@@ -70,7 +70,43 @@ Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
   return processFinderPatternInfo(info);
 }
 
-Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> info){
+Ref<DetectorResult> Detector::track(DecodeHints const& hints, Ref<FinderPatternInfo> previousInfo,
+                                    Ref<AlignmentPattern> previousAlignment) {
+  callback_ = hints.getResultPointCallback();
+  FinderPatternFinder finder(image_, hints.getResultPointCallback());
+  Ref<FinderPatternInfo> info(finder.findNear(previousInfo));
+
+  // Expect the alignment pattern to have moved along with the finder patterns
+  Ref<ResultPoint> expectedAlignment;
+  if (previousAlignment != 0) {
+    float dx = (info->getBottomLeft()->getX() - previousInfo->getBottomLeft()->getX() +
+                info->getTopLeft()->getX() - previousInfo->getTopLeft()->getX() +
+                info->getTopRight()->getX() - previousInfo->getTopRight()->getX()) / 3.0f;
+    float dy = (info->getBottomLeft()->getY() - previousInfo->getBottomLeft()->getY() +
+                info->getTopLeft()->getY() - previousInfo->getTopLeft()->getY() +
+                info->getTopRight()->getY() - previousInfo->getTopRight()->getY()) / 3.0f;
+    expectedAlignment.reset(new ResultPoint(previousAlignment->getX() + dx, previousAlignment->getY() + dy));
+  }
+  return processFinderPatternInfo(info, expectedAlignment);
+}
+
+Ref<FinderPatternInfo> Detector::getFinderPatternInfo() const {
+  return info_;
+}
+
+Ref<AlignmentPattern> Detector::getAlignmentPattern() const {
+  return alignment_;
+}
+
+Ref<BitMatrix> Detector::resampleGrid(GridSampler::Sampling sampling) const {
+  if (transform_ == 0) {
+    throw zxing::ReaderException("nothing detected");
+  }
+  return sampleGrid(image_, dimension_, transform_, sampling);
+}
+
+Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> info,
+                                                       Ref<ResultPoint> expectedAlignment){
   Ref<FinderPattern> topLeft(info->getTopLeft());
   Ref<FinderPattern> topRight(info->getTopRight());
   Ref<FinderPattern> bottomLeft(info->getBottomLeft());
@@ -100,8 +136,19 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
     int estAlignmentY = (int)(topLeft->getY() + correctionToTopLeft * (bottomRightY - topLeft->getY()));
 
 
+    // Where the alignment pattern was in the previous image is usually
+    // a better guess than the estimate
+    if (expectedAlignment != 0) {
+      try {
+        alignmentPattern = findAlignmentInRegion(moduleSize, (int)expectedAlignment->getX(),
+                                                 (int)expectedAlignment->getY(), 4.0f);
+      } catch (zxing::ReaderException const& re) {
+        (void)re;
+      }
+    }
+
     // Kind of arbitrary -- expand search radius before giving up
-    for (int i = 4; i <= 16; i <<= 1) {
+    for (int i = 4; i <= 16 && alignmentPattern == 0; i <<= 1) {
       try {
         alignmentPattern = findAlignmentInRegion(moduleSize, estAlignmentX, estAlignmentY, (float)i);
         break;
@@ -126,6 +173,11 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
     points[3].reset(alignmentPattern);
   }
 
+  info_ = info;
+  alignment_ = alignmentPattern;
+  transform_ = transform;
+  dimension_ = dimension;
+
   Ref<DetectorResult> result(new DetectorResult(bits, points));
   return result;
 }
@@ -158,9 +210,10 @@ Ref<PerspectiveTransform> Detector::createTransform(Ref<ResultPoint> topLeft, Re
   return transform;
 }
 
-Ref<BitMatrix> Detector::sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform) {
+Ref<BitMatrix> Detector::sampleGrid(Ref<BitMatrix> image, int dimension, Ref<PerspectiveTransform> transform,
+                                    GridSampler::Sampling sampling) {
   GridSampler &sampler = GridSampler::getInstance();
-  return sampler.sampleGrid(image, dimension, transform);
+  return sampler.sampleGrid(image, dimension, transform, sampling);
 }
 
 int Detector::computeDimension(Ref<ResultPoint> topLeft, Ref<ResultPoint> topRight, Ref<ResultPoint> bottomLeft,
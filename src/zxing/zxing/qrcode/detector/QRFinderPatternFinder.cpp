@@ -27,6 +27,7 @@
 
 using std::sort;
 using std::max;
+using std::min;
 using std::abs;
 using std::vector;
 using zxing::Ref;
@@ -43,6 +44,81 @@ using zxing::DecodeHints;
 
 namespace {
 
+// N.B.: These only work for 32 bit ints ...
+int numberOfTrailingZeros(unsigned int i) {
+#if defined(__clang__) || defined(__GNUC__)
+  return __builtin_ctz(i);
+#else
+  int n = 0;
+  while ((i & 1) == 0) {
+    i >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+int numberOfLeadingZeros(unsigned int i) {
+#if defined(__clang__) || defined(__GNUC__)
+  return __builtin_clz(i);
+#else
+  int n = 0;
+  while ((i & 0x80000000u) == 0) {
+    i <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+// Transposes a 32x32 bit block in place: bit c of word r ends up as bit r of word c
+void transpose32(unsigned int* a) {
+  unsigned int m = 0x0000FFFFu;
+  for (int j = 16; j != 0; j >>= 1, m ^= m << j) {
+    for (int k = 0; k < 32; k = (k + j + 1) & ~j) {
+      unsigned int t = ((a[k] >> j) ^ a[k + j]) & m;
+      a[k + j] ^= t;
+      a[k] ^= t << j;
+    }
+  }
+}
+
+// First index at or after 'from' whose pixel is not 'black', or 'length'
+int nextRunEnd(unsigned int const* column, int from, int length, bool black) {
+  if (from >= length) {
+    return length;
+  }
+  int words = (length + 31) >> 5;
+  int offset = from >> 5;
+  unsigned int other = black ? ~column[offset] : column[offset];
+  other &= ~0u << (from & 0x1f);
+  while (other == 0) {
+    if (++offset == words) {
+      return length;
+    }
+    other = black ? ~column[offset] : column[offset];
+  }
+  int result = (offset << 5) + numberOfTrailingZeros(other);
+  return result > length ? length : result;
+}
+
+// Last index at or before 'from' whose pixel is not 'black', or -1
+int previousRunEnd(unsigned int const* column, int from, bool black) {
+  if (from < 0) {
+    return -1;
+  }
+  int offset = from >> 5;
+  unsigned int other = black ? ~column[offset] : column[offset];
+  other &= ~0u >> (31 - (from & 0x1f));
+  while (other == 0) {
+    if (--offset < 0) {
+      return -1;
+    }
+    other = black ? ~column[offset] : column[offset];
+  }
+  return (offset << 5) + 31 - numberOfLeadingZeros(other);
+}
+
 class FurthestFromAverageComparator {
 private:
   const float averageModuleSize_;
@@ -80,6 +156,8 @@ public:
 int FinderPatternFinder::CENTER_QUORUM = 2;
 int FinderPatternFinder::MIN_SKIP = 3;
 int FinderPatternFinder::MAX_MODULES = 57;
+// How far (in modules) a pattern may have moved between two frames
+int FinderPatternFinder::TRACKING_RADIUS = 7;
 
 float FinderPatternFinder::centerFromEnd(int* stateCount, int end) {
   return (float)(end - stateCount[4] - stateCount[3]) - stateCount[2] / 2.0f;
@@ -112,51 +190,54 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
   int maxI = image_->getHeight();
   int *stateCount = getCrossCheckStateCount();
 
+  // A pattern reaching further than this from startI fails the size check
+  // below anyway, so only that part of the column has to be looked at
+  int reach = 2 * originalStateCountTotal + 2;
+  int top = max((int)startI - reach, 0);
+  int bottom = min((int)startI + reach + 1, maxI);
+  unsigned int const* column = transposedColumn(centerJ, top, bottom);
+  top = columnsTop_;
+  bottom = columnsBottom_;
+  int length = bottom - top;
+
   // Start counting up from center
-  int i = startI;
-  while (i >= 0 && image_->get(centerJ, i)) {
-    stateCount[2]++;
-    i--;
-  }
+  int i = startI - top;
+  int end = previousRunEnd(column, i, true);
+  stateCount[2] += i - end;
+  i = end;
   if (i < 0) {
     return nan();
   }
-  while (i >= 0 && !image_->get(centerJ, i) && stateCount[1] <= maxCount) {
-    stateCount[1]++;
-    i--;
-  }
+  end = previousRunEnd(column, i, false);
+  stateCount[1] += i - end;
+  i = end;
   // If already too many modules in this state or ran off the edge:
   if (i < 0 || stateCount[1] > maxCount) {
     return nan();
   }
-  while (i >= 0 && image_->get(centerJ, i) && stateCount[0] <= maxCount) {
-    stateCount[0]++;
-    i--;
-  }
+  end = previousRunEnd(column, i, true);
+  stateCount[0] += i - end;
   if (stateCount[0] > maxCount) {
     return nan();
   }
 
   // Now also count down from center
-  i = startI + 1;
-  while (i < maxI && image_->get(centerJ, i)) {
-    stateCount[2]++;
-    i++;
-  }
-  if (i == maxI) {
+  i = startI + 1 - top;
+  end = nextRunEnd(column, i, length, true);
+  stateCount[2] += end - i;
+  i = end;
+  if (i == length) {
     return nan();
   }
-  while (i < maxI && !image_->get(centerJ, i) && stateCount[3] < maxCount) {
-    stateCount[3]++;
-    i++;
-  }
-  if (i == maxI || stateCount[3] >= maxCount) {
+  end = nextRunEnd(column, i, length, false);
+  stateCount[3] += end - i;
+  i = end;
+  if (i == length || stateCount[3] >= maxCount) {
     return nan();
   }
-  while (i < maxI && image_->get(centerJ, i) && stateCount[4] < maxCount) {
-    stateCount[4]++;
-    i++;
-  }
+  end = nextRunEnd(column, i, length, true);
+  stateCount[4] += end - i;
+  i = end;
   if (stateCount[4] >= maxCount) {
     return nan();
   }
@@ -168,7 +249,48 @@ float FinderPatternFinder::crossCheckVertical(size_t startI, size_t centerJ, int
     return nan();
   }
 
-  return foundPatternCross(stateCount) ? centerFromEnd(stateCount, i) : nan();
+  return foundPatternCross(stateCount) ? centerFromEnd(stateCount, i + top) : nan();
+}
+
+unsigned int const* FinderPatternFinder::transposedColumn(int x, int top, int bottom) {
+  int firstX = x & ~0x1f;
+  if (firstX != columnsX_ || top < columnsTop_ || bottom > columnsBottom_) {
+    // Candidates are confirmed on consecutive rows, so copy a taller strip
+    // than asked for and let the following cross-checks reuse it
+    int height = image_->getHeight();
+    int margin = bottom - top;
+    columnsX_ = firstX;
+    columnsTop_ = max(top - margin, 0);
+    columnsBottom_ = min(bottom + margin, height);
+    columnWords_ = (columnsBottom_ - columnsTop_ + 31) >> 5;
+    columns_.resize(32 * columnWords_);
+
+    unsigned int block[32];
+    for (int word = 0; word < columnWords_; word++) {
+      int y = columnsTop_ + (word << 5);
+      for (int r = 0; r < 32; r++) {
+        block[r] = y + r < columnsBottom_ ? (unsigned int)image_->getBulk(firstX, y + r) : 0;
+      }
+      transpose32(block);
+      for (int c = 0; c < 32; c++) {
+        columns_[c * columnWords_ + word] = block[c];
+      }
+    }
+  }
+  return &columns_[(x - firstX) * columnWords_];
+}
+
+void FinderPatternFinder::encodeRow(int y, int left, int right) {
+  row_ = image_->getRow(y, row_);
+  BitArray& row = *row_;
+
+  runs_.clear();
+  bool black = false;
+  for (int x = left; x < right; black = !black) {
+    int end = min(black ? row.getNextUnset(x) : row.getNextSet(x), right);
+    runs_.push_back(end - x);
+    x = end;
+  }
 }
 
 float FinderPatternFinder::crossCheckHorizontal(size_t startJ, size_t centerI, int maxCount,
@@ -266,6 +388,81 @@ bool FinderPatternFinder::handlePossibleCenter(int* stateCount, size_t i, size_t
   return false;
 }
 
+Ref<FinderPattern> FinderPatternFinder::findInRegion(Ref<FinderPattern> previous) {
+  int radius = (int)(TRACKING_RADIUS * previous->getEstimatedModuleSize());
+  int centerX = (int)previous->getX();
+  int centerY = (int)previous->getY();
+  int left = max(centerX - radius, 0);
+  int right = min(centerX + radius + 1, (int)image_->getWidth());
+  int top = max(centerY - radius, 0);
+  int bottom = min(centerY + radius + 1, (int)image_->getHeight());
+  size_t first = possibleCenters_.size();
+
+  int stateCount[5];
+  for (int i = top; i < bottom; i += 2) {
+    // Same run-length scan as find(), without the row skipping
+    encodeRow(i, left, right);
+    memset(stateCount, 0, sizeof(stateCount));
+    int currentState = 0;
+    int j = left;
+    size_t numRuns = runs_.size();
+    for (size_t run = 0; run < numRuns; j += runs_[run], run++) {
+      int length = runs_[run];
+      if (length == 0) {
+        continue;
+      }
+      if ((run & 1) == 1) {
+        // Black run
+        if ((currentState & 1) == 1) { // Counting white pixels
+          currentState++;
+        }
+        stateCount[currentState] += length;
+      } else { // White run
+        if ((currentState & 1) == 0) { // Counting black pixels
+          if (currentState == 4) { // A winner?
+            if (foundPatternCross(stateCount) && handlePossibleCenter(stateCount, i, j)) {
+              // The first white pixel only ends the pattern, the rest
+              // start a new one
+              memset(stateCount, 0, sizeof(stateCount));
+              currentState = 0;
+              if (length > 1) {
+                currentState = 1;
+                stateCount[1] = length - 1;
+              }
+            } else {
+              stateCount[0] = stateCount[2];
+              stateCount[1] = stateCount[3];
+              stateCount[2] = stateCount[4];
+              stateCount[3] = length;
+              stateCount[4] = 0;
+              currentState = 3;
+            }
+          } else {
+            stateCount[++currentState] += length;
+          }
+        } else { // Counting white pixels
+          stateCount[currentState] += length;
+        }
+      }
+    }
+    if (foundPatternCross(stateCount)) {
+      handlePossibleCenter(stateCount, i, right);
+    }
+  }
+
+  // The most often confirmed of the centers found in this region
+  Ref<FinderPattern> best;
+  for (size_t index = first; index < possibleCenters_.size(); index++) {
+    if (best == 0 || possibleCenters_[index]->getCount() > best->getCount()) {
+      best = possibleCenters_[index];
+    }
+  }
+  if (best == 0) {
+    throw zxing::ReaderException("Finder pattern has moved");
+  }
+  return best;
+}
+
 int FinderPatternFinder::findRowSkip() {
   size_t max = possibleCenters_.size();
   if (max <= 1) {
@@ -424,7 +621,8 @@ float FinderPatternFinder::distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2) {
 
 FinderPatternFinder::FinderPatternFinder(Ref<BitMatrix> image,
                                            Ref<ResultPointCallback>const& callback) :
-    image_(image), possibleCenters_(), hasSkipped_(false), callback_(callback) {
+    image_(image), possibleCenters_(), hasSkipped_(false), callback_(callback),
+    columnsX_(-1), columnsTop_(0), columnsBottom_(0), columnWords_(0) {
 }
 
 Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
@@ -452,73 +650,75 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
       iSkip = MIN_SKIP;
   }
 
-  // This is slightly faster than using the Ref. Efficiency is important here
-  BitMatrix& matrix = *image_;
-
   for (size_t i = iSkip - 1; i < maxI && !done; i += iSkip) {
-    // Get a row of black/white values
+    // Get a row of black/white values, as alternating white and black runs
+    encodeRow(i, 0, maxJ);
 
     memset(stateCount, 0, sizeof(stateCount));
     int currentState = 0;
-    for (size_t j = 0; j < maxJ; j++) {
-      if (matrix.get(j, i)) {
-        // Black pixel
+    size_t j = 0;
+    size_t numRuns = runs_.size();
+    for (size_t run = 0; run < numRuns; j += runs_[run], run++) {
+      int length = runs_[run];
+      if (length == 0) {
+        continue;
+      }
+      if ((run & 1) == 1) {
+        // Black run
         if ((currentState & 1) == 1) { // Counting white pixels
           currentState++;
         }
-        stateCount[currentState]++;
-      } else { // White pixel
+        stateCount[currentState] += length;
+      } else { // White run
         if ((currentState & 1) == 0) { // Counting black pixels
           if (currentState == 4) { // A winner?
-            if (foundPatternCross(stateCount)) { // Yes
-              bool confirmed = handlePossibleCenter(stateCount, i, j);
-              if (confirmed) {
-                // Start examining every other line. Checking each line turned out to be too
-                // expensive and didn't improve performance.
-                iSkip = 2;
-                if (hasSkipped_) {
-                  done = haveMultiplyConfirmedCenters();
-                } else {
-                  int rowSkip = findRowSkip();
-                  if (rowSkip > stateCount[2]) {
-                    // Skip rows between row of lower confirmed center
-                    // and top of presumed third confirmed center
-                    // but back up a bit to get a full chance of detecting
-                    // it, entire width of center of finder pattern
-
-                    // Skip by rowSkip, but back off by stateCount[2] (size
-                    // of last center of pattern we saw) to be conservative,
-                    // and also back off by iSkip which is about to be
-                    // re-added
-                    i += rowSkip - stateCount[2] - iSkip;
-                    j = maxJ - 1;
-                  }
-                }
+            if (foundPatternCross(stateCount) && handlePossibleCenter(stateCount, i, j)) { // Yes
+              // Start examining every other line. Checking each line turned out to be too
+              // expensive and didn't improve performance.
+              iSkip = 2;
+              bool skipRow = false;
+              if (hasSkipped_) {
+                done = haveMultiplyConfirmedCenters();
               } else {
-                stateCount[0] = stateCount[2];
-                stateCount[1] = stateCount[3];
-                stateCount[2] = stateCount[4];
-                stateCount[3] = 1;
-                stateCount[4] = 0;
-                currentState = 3;
-                continue;
+                int rowSkip = findRowSkip();
+                if (rowSkip > stateCount[2]) {
+                  // Skip rows between row of lower confirmed center
+                  // and top of presumed third confirmed center
+                  // but back up a bit to get a full chance of detecting
+                  // it, entire width of center of finder pattern
+
+                  // Skip by rowSkip, but back off by stateCount[2] (size
+                  // of last center of pattern we saw) to be conservative,
+                  // and also back off by iSkip which is about to be
+                  // re-added
+                  i += rowSkip - stateCount[2] - iSkip;
+                  skipRow = true;
+                }
               }
-              // Clear state to start looking again
-              currentState = 0;
+              // Clear state to start looking again. The first white pixel
+              // only ends the pattern, the rest start a new one
               memset(stateCount, 0, sizeof(stateCount));
+              currentState = 0;
+              if (skipRow) {
+                break;
+              }
+              if (length > 1) {
+                currentState = 1;
+                stateCount[1] = length - 1;
+              }
             } else { // No, shift counts back by two
               stateCount[0] = stateCount[2];
               stateCount[1] = stateCount[3];
               stateCount[2] = stateCount[4];
-              stateCount[3] = 1;
+              stateCount[3] = length;
               stateCount[4] = 0;
               currentState = 3;
             }
           } else {
-            stateCount[++currentState]++;
+            stateCount[++currentState] += length;
           }
         } else { // Counting white pixels
-          stateCount[currentState]++;
+          stateCount[currentState] += length;
         }
       }
     }
@@ -550,6 +750,16 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
   return result;
 }
 
+Ref<FinderPatternInfo> FinderPatternFinder::findNear(Ref<FinderPatternInfo> previous) {
+  vector<Ref<FinderPattern> > patterns(3);
+  patterns[0] = findInRegion(previous->getBottomLeft());
+  patterns[1] = findInRegion(previous->getTopLeft());
+  patterns[2] = findInRegion(previous->getTopRight());
+
+  Ref<FinderPatternInfo> result(new FinderPatternInfo(orderBestPatterns(patterns)));
+  return result;
+}
+
 Ref<BitMatrix> FinderPatternFinder::getImage() {
   return image_;
 }
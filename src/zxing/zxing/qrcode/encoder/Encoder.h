@@ -99,12 +99,6 @@ private:
 
   static void appendECI(const zxing::common::CharacterSetECI& eci, BitArray& bits);
 
-  /**
-   * The mask penalty calculation is complicated.  See Table 21 of JISX0510:2004 (p.45) for details.
-   * Basically it applies four rules and summate all penalties.
-   */
-  static int calculateMaskPenalty(const ByteMatrix& matrix);
-
   static int calculateBitsNeeded(const Mode &mode, const BitArray &headerBits, const BitArray &dataBits, const
                                  Ref<Version> version);
   static bool willFit(int numInputBits, Ref<Version> version, const ErrorCorrectionLevel &ecLevel);
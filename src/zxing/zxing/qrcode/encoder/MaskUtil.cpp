@@ -3,6 +3,49 @@
 #include <stdlib.h>
 #include <algorithm> 
 
+namespace {
+
+int bitCount(unsigned int i)
+{
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_popcount(i);
+#else
+    int n = 0;
+    for (; i; i &= i - 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+
+// Bits of word i of a line whose bit x is module x + k of the line.
+// Modules past either end of the line are white.
+inline unsigned int shiftedWord(unsigned int const* line, int words, int i, int k)
+{
+    if (k > 0) {
+        unsigned int bits = line[i] >> k;
+        if (i + 1 < words) {
+            bits |= line[i + 1] << (32 - k);
+        }
+        return bits;
+    } else {
+        unsigned int bits = line[i] << -k;
+        if (i > 0) {
+            bits |= line[i - 1] >> (32 + k);
+        }
+        return bits;
+    }
+}
+
+// Bits of word i that are below module limit
+inline unsigned int maskBelow(int i, int limit)
+{
+    int count = limit - (i << 5);
+    return (count >= 32) ? ~0u : (count > 0) ? ((1u << count) - 1) : 0u;
+}
+
+}
+
 namespace zxing {
 namespace qrcode {
 
@@ -206,5 +249,78 @@ int MaskUtil::applyMaskPenaltyRule1Internal(const ByteMatrix& matrix, bool isHor
     return penalty;
 }
 
+/**
+ * Rule 1, word by word: a run of L >= 5 modules of one colour costs
+ * N1 + (L - 5). It has L - 4 windows of five same coloured modules and
+ * L - 5 windows of six, so the sum over all runs is
+ * N1 * windows5 - (N1 - 1) * windows6.
+ * Rule 3 looks for 1011101 with four white modules on either side and
+ * rule 2 for four equal modules at x and x + 1 of two neighbouring lines.
+ */
+void MaskUtil::applyPackedPenaltyRules(unsigned int const* lines, int dimension, bool blocks2x2,
+                                       int* penalty1, int* blocks, int* patterns)
+{
+    int words = (dimension + 31) >> 5;
+    int windows5 = 0;
+    int windows6 = 0;
+    for (int y = 0; y < dimension; y++) {
+        unsigned int const* line = lines + y * words;
+        for (int i = 0; i < words; i++) {
+            unsigned int r0 = line[i];
+            unsigned int r1 = shiftedWord(line, words, i, 1);
+            unsigned int r2 = shiftedWord(line, words, i, 2);
+            unsigned int r3 = shiftedWord(line, words, i, 3);
+            unsigned int r4 = shiftedWord(line, words, i, 4);
+            unsigned int r5 = shiftedWord(line, words, i, 5);
+            unsigned int r6 = shiftedWord(line, words, i, 6);
+
+            unsigned int black5 = r0 & r1 & r2 & r3 & r4;
+            unsigned int white5 = ~(r0 | r1 | r2 | r3 | r4);
+            windows5 += bitCount((black5 | white5) & maskBelow(i, dimension - 4));
+            windows6 += bitCount(((black5 & r5) | (white5 & ~r5)) & maskBelow(i, dimension - 5));
+
+            // Black at x + 6 means that the pattern is inside the line
+            unsigned int pattern = r0 & ~r1 & r2 & r3 & r4 & ~r5 & r6;
+            if (pattern) {
+                unsigned int whiteAfter = ~(shiftedWord(line, words, i, 7) |
+                                            shiftedWord(line, words, i, 8) |
+                                            shiftedWord(line, words, i, 9) |
+                                            shiftedWord(line, words, i, 10));
+                unsigned int whiteBefore = ~(shiftedWord(line, words, i, -1) |
+                                             shiftedWord(line, words, i, -2) |
+                                             shiftedWord(line, words, i, -3) |
+                                             shiftedWord(line, words, i, -4));
+                *patterns += bitCount(pattern & (whiteBefore | whiteAfter));
+            }
+
+            if (blocks2x2 && y + 1 < dimension) {
+                unsigned int const* next = line + words;
+                unsigned int n0 = next[i];
+                unsigned int n1 = shiftedWord(next, words, i, 1);
+                *blocks += bitCount(~(r0 ^ r1) & ~(r0 ^ n0) & ~(n0 ^ n1) & maskBelow(i, dimension - 1));
+            }
+        }
+    }
+    *penalty1 += N1 * windows5 - (N1 - 1) * windows6;
+}
+
+int MaskUtil::calculateMaskPenalty(unsigned int const* rows, unsigned int const* columns, int dimension)
+{
+    int penalty1 = 0;
+    int blocks = 0;
+    int patterns = 0;
+    applyPackedPenaltyRules(rows, dimension, true, &penalty1, &blocks, &patterns);
+    applyPackedPenaltyRules(columns, dimension, false, &penalty1, &blocks, &patterns);
+
+    int numDarkCells = 0;
+    int totalWords = dimension * ((dimension + 31) >> 5);
+    for (int i = 0; i < totalWords; i++) {
+        numDarkCells += bitCount(rows[i]);
+    }
+    int numTotalCells = dimension * dimension;
+    int fivePercentVariances = abs(numDarkCells * 2 - numTotalCells) * 10 / numTotalCells;
+    return penalty1 + N2 * blocks + N3 * patterns + N4 * fivePercentVariances;
+}
+
 }
 }
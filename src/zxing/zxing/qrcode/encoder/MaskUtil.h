@@ -25,6 +25,14 @@ private:
    */
   static int applyMaskPenaltyRule1Internal(const ByteMatrix& matrix, bool isHorizontal);
 
+  /**
+   * Rules 1 and 3 along the lines of a packed symbol, rule 2 too if asked.
+   * Adds the rule 1 penalty to *penalty1, the number of 2x2 blocks to
+   * *blocks and the number of finder-like patterns to *patterns.
+   */
+  static void applyPackedPenaltyRules(unsigned int const* lines, int dimension, bool blocks2x2,
+                                      int* penalty1, int* blocks, int* patterns);
+
 public:
   /**
    * Apply mask penalty rule 1 and return the penalty. Find repetitive cells with the same color and
@@ -52,6 +60,15 @@ public:
    */
   static int applyMaskPenaltyRule4(const ByteMatrix& matrix);
 
+  /**
+   * Sum of the four rules for a symbol packed a word at a time, the way
+   * BitMatrix packs its bits: module i of a line is bit (i & 0x1f) of word
+   * (i >> 5), with (dimension + 31) / 32 words per line. rows has the
+   * symbol a row at a time and columns the same symbol a column at a time.
+   * The result is the same as that of the four rules above.
+   */
+  static int calculateMaskPenalty(unsigned int const* rows, unsigned int const* columns, int dimension);
+
   /**
    * Return the mask bit for "getMaskPattern" at "x" and "y". See 8.8 of JISX0510:2004 for mask
    * pattern conditions.
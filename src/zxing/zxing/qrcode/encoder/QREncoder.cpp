@@ -9,6 +9,7 @@
 #include <QList>
 #include <math.h>
 #include <limits>
+#include <algorithm>
 #include "MatrixUtil.h"
 #include <string>
 #include "zxing/common/StringUtils.h"
@@ -29,14 +30,6 @@ const int Encoder::ALPHANUMERIC_TABLE[Encoder::ALPHANUMERIC_TABLE_SIZE] = {
 
 const std::string Encoder::DEFAULT_BYTE_MODE_ENCODING = "ISO-8859-1";
 
-int Encoder::calculateMaskPenalty(const ByteMatrix& matrix)
-{
-    return MaskUtil::applyMaskPenaltyRule1(matrix)
-            + MaskUtil::applyMaskPenaltyRule2(matrix)
-            + MaskUtil::applyMaskPenaltyRule3(matrix)
-            + MaskUtil::applyMaskPenaltyRule4(matrix);
-}
-
 Ref<QRCode> Encoder::encode(const std::string& content, ErrorCorrectionLevel &ecLevel)
 {
     return encode(content, ecLevel, NULL);
@@ -74,16 +67,8 @@ Ref<QRCode> Encoder::encode(const std::string& content, ErrorCorrectionLevel &ec
     BitArray dataBits;
     appendBytes(content, mode, dataBits, encoding);
 
-    Ref<Version> version;
-    if (hints != NULL/* && hints->containsKey(EncodeHintType.QR_VERSION)*/) {
-        version = Version::getVersionForNumber(1);
-        int bitsNeeded = calculateBitsNeeded(mode, headerBits, dataBits, version);
-        if (!willFit(bitsNeeded, version, ecLevel)) {
-            throw new WriterException("Data too big for requested version");
-        }
-    } else {
-        version = recommendVersion(ecLevel, mode, headerBits, dataBits);
-    }
+    // EncodeHint has no way to ask for a particular version
+    Ref<Version> version = recommendVersion(ecLevel, mode, headerBits, dataBits);
 
     BitArray headerAndDataBits;
     headerAndDataBits.appendBitArray(headerBits);
@@ -103,7 +88,7 @@ Ref<QRCode> Encoder::encode(const std::string& content, ErrorCorrectionLevel &ec
     Ref<BitArray> finalBits(interleaveWithECBytes(headerAndDataBits,
                                                   version->getTotalCodewords(),
                                                   numDataBytes,
-                                                  ecBlocks.getECBlocks().size()));
+                                                  ecBlocks.getNumBlocks()));
 
     Ref<QRCode> qrCode(new QRCode);
 
@@ -145,7 +130,8 @@ bool Encoder::willFit(int numInputBits, Ref<Version> version, const ErrorCorrect
    */
 int Encoder::getAlphanumericCode(int code)
 {
-    if (code < ALPHANUMERIC_TABLE_SIZE) {
+    // Bytes above 0x7f arrive here as negative chars
+    if (code >= 0 && code < ALPHANUMERIC_TABLE_SIZE) {
         return ALPHANUMERIC_TABLE[code];
     }
     return -1;
@@ -205,18 +191,120 @@ Mode Encoder::chooseMode(const std::string& content, const std::string& encoding
 //    return true;
 //}
 
+namespace {
+
+inline void setPacked(unsigned int* line, int i, bool value)
+{
+    if (value) {
+        line[i >> 5] |= 1u << (i & 0x1f);
+    } else {
+        line[i >> 5] &= ~(1u << (i & 0x1f));
+    }
+}
+
+inline bool getPacked(unsigned int const* line, int i)
+{
+    return ((line[i >> 5] >> (i & 0x1f)) & 1) != 0;
+}
+
+}
+
+/**
+ * Only the data modules and the type information depend on the mask, so
+ * the symbol is built once without a mask and packed a row and a column
+ * at a time, along with which of its modules hold data. Each mask is then
+ * XORed into the data modules a word at a time (the masks repeat every 12
+ * rows and every 12 columns), the type information in row and column 8
+ * is replaced and MaskUtil scores the packed symbol.
+ */
 int Encoder::chooseMaskPattern(Ref<BitArray> bits,
                                ErrorCorrectionLevel& ecLevel,
                                Ref<Version> version,
                                Ref<ByteMatrix> matrix)
 {
+    static const int MASK_PERIOD = 12;
+    ByteMatrix& symbol = *matrix;
+    int dimension = (int) symbol.getWidth();
+    int rowSize = (dimension + 31) >> 5;
+    int planeSize = dimension * rowSize;
+
+    MatrixUtil::clearMatrix(symbol);
+    MatrixUtil::embedBasicPatterns(*version, symbol);
+    MatrixUtil::embedTypeInfo(ecLevel, 0, symbol);
+    MatrixUtil::maybeEmbedVersionInfo(*version, symbol);
+
+    // Rows are followed by columns in each of these
+    std::vector<unsigned int> data(2 * planeSize);
+    std::vector<unsigned int> unmasked(2 * planeSize);
+    std::vector<unsigned int> masked(2 * planeSize);
+    std::vector<unsigned int> pattern(2 * MASK_PERIOD * rowSize);
+    unsigned int* dataRows = &data[0];
+    unsigned int* dataColumns = dataRows + planeSize;
+    for (int y = 0; y < dimension; y++) {
+        for (int x = 0; x < dimension; x++) {
+            if (symbol.get(x, y) == 255) {
+                setPacked(dataRows + y * rowSize, x, true);
+                setPacked(dataColumns + x * rowSize, y, true);
+            }
+        }
+    }
 
+    MatrixUtil::embedDataBits(*bits, -1, symbol);
+    unsigned int* unmaskedRows = &unmasked[0];
+    unsigned int* unmaskedColumns = unmaskedRows + planeSize;
+    for (int y = 0; y < dimension; y++) {
+        for (int x = 0; x < dimension; x++) {
+            if (symbol.get(x, y) == 1) {
+                setPacked(unmaskedRows + y * rowSize, x, true);
+                setPacked(unmaskedColumns + x * rowSize, y, true);
+            }
+        }
+    }
+
+    unsigned int* maskedRows = &masked[0];
+    unsigned int* maskedColumns = maskedRows + planeSize;
+    unsigned int* patternRows = &pattern[0];
+    unsigned int* patternColumns = patternRows + MASK_PERIOD * rowSize;
     int minPenalty = std::numeric_limits<int>::max();  // Lower penalty is better.
     int bestMaskPattern = -1;
     // We try all mask patterns to choose the best one.
     for (int maskPattern = 0; maskPattern < QRCode::NUM_MASK_PATTERNS; maskPattern++) {
-        MatrixUtil::buildMatrix(*bits, ecLevel, *version, maskPattern, *matrix);
-        int penalty = calculateMaskPenalty(*matrix);
+        std::fill(pattern.begin(), pattern.end(), 0);
+        for (int i = 0; i < MASK_PERIOD; i++) {
+            for (int j = 0; j < dimension; j++) {
+                if (MaskUtil::getDataMaskBit(maskPattern, j, i)) {
+                    setPacked(patternRows + i * rowSize, j, true);
+                }
+                if (MaskUtil::getDataMaskBit(maskPattern, i, j)) {
+                    setPacked(patternColumns + i * rowSize, j, true);
+                }
+            }
+        }
+        for (int i = 0; i < dimension; i++) {
+            unsigned int const* rowMask = patternRows + (i % MASK_PERIOD) * rowSize;
+            unsigned int const* columnMask = patternColumns + (i % MASK_PERIOD) * rowSize;
+            for (int k = i * rowSize, w = 0; w < rowSize; k++, w++) {
+                maskedRows[k] = unmaskedRows[k] ^ (rowMask[w] & dataRows[k]);
+                maskedColumns[k] = unmaskedColumns[k] ^ (columnMask[w] & dataColumns[k]);
+            }
+        }
+
+        // Row and column 8 hold the type information for this mask
+        MatrixUtil::embedTypeInfo(ecLevel, maskPattern, symbol);
+        for (int i = 0; i < dimension; i++) {
+            if (!getPacked(dataRows + 8 * rowSize, i)) {
+                bool black = (symbol.get(i, 8) == 1);
+                setPacked(maskedRows + 8 * rowSize, i, black);
+                setPacked(maskedColumns + i * rowSize, 8, black);
+            }
+            if (!getPacked(dataColumns + 8 * rowSize, i)) {
+                bool black = (symbol.get(8, i) == 1);
+                setPacked(maskedColumns + 8 * rowSize, i, black);
+                setPacked(maskedRows + i * rowSize, 8, black);
+            }
+        }
+
+        int penalty = MaskUtil::calculateMaskPenalty(maskedRows, maskedColumns, dimension);
         if (penalty < minPenalty) {
             minPenalty = penalty;
             bestMaskPattern = maskPattern;
@@ -0,0 +1,180 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "MaskTest.h"
+
+#include <zxing/Exception.h>
+#include <zxing/qrcode/ErrorCorrectionLevel.h>
+#include <zxing/qrcode/encoder/ByteMatrix.h>
+#include <zxing/qrcode/encoder/Encoder.h>
+#include <zxing/qrcode/encoder/MaskUtil.h>
+#include <zxing/qrcode/encoder/MatrixUtil.h>
+#include <zxing/qrcode/encoder/QRCode.h>
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace zxing;
+using namespace zxing::qrcode;
+
+#define NUMERIC "0123456789"
+#define ALPHANUMERIC "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:"
+#define BYTES "abcdefghijklmnopqrstuvwxyz0123456789?&=/.:-_"
+
+static const int NUM_MASK_PATTERNS = 8;
+
+// Reproducible on every platform, unlike rand()
+static unsigned int nextRandom(unsigned int* aSeed)
+{
+    *aSeed = *aSeed * 1103515245 + 12345;
+    return (*aSeed >> 16) & 0x7fff;
+}
+
+// MaskUtil::calculateMaskPenalty() wants BitMatrix layout
+static void pack(const ByteMatrix& aMatrix, std::vector<unsigned int>* aRows,
+    std::vector<unsigned int>* aColumns)
+{
+    const int n = (int)aMatrix.getWidth();
+    const int rowSize = (n + 31) >> 5;
+    aRows->assign(n * rowSize, 0);
+    aColumns->assign(n * rowSize, 0);
+    for (int y = 0; y < n; y++) {
+        for (int x = 0; x < n; x++) {
+            if (aMatrix.get(x, y) == 1) {
+                (*aRows)[y * rowSize + (x >> 5)] |= 1u << (x & 0x1f);
+                (*aColumns)[x * rowSize + (y >> 5)] |= 1u << (y & 0x1f);
+            }
+        }
+    }
+}
+
+static int referencePenalty(const ByteMatrix& aMatrix)
+{
+    return MaskUtil::applyMaskPenaltyRule1(aMatrix) +
+        MaskUtil::applyMaskPenaltyRule2(aMatrix) +
+        MaskUtil::applyMaskPenaltyRule3(aMatrix) +
+        MaskUtil::applyMaskPenaltyRule4(aMatrix);
+}
+
+// Rebuilds the symbol with each of the masks from the one the encoder
+// chose, scores it both ways and picks the mask the way the encoder did
+// before it had packed bitplanes: the first one with the lowest penalty
+static bool checkSymbol(Ref<QRCode> aCode, ErrorCorrectionLevel& aLevel)
+{
+    const Ref<ByteMatrix> matrix(aCode->getMatrix());
+    const Ref<Version> versionRef(aCode->getVersion());
+    const ByteMatrix& symbol = *matrix;
+    const Version& version = *versionRef;
+    const int chosen = aCode->getMaskPattern();
+    const int n = (int)symbol.getWidth();
+
+    // Whatever the function patterns leave empty is data
+    ByteMatrix functions(n, n);
+    MatrixUtil::clearMatrix(functions);
+    MatrixUtil::embedBasicPatterns(version, functions);
+    MatrixUtil::embedTypeInfo(aLevel, 0, functions);
+    MatrixUtil::maybeEmbedVersionInfo(version, functions);
+
+    int bestMask = -1;
+    int minPenalty = 0;
+    for (int mask = 0; mask < NUM_MASK_PATTERNS; mask++) {
+        ByteMatrix masked(n, n);
+        for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+                bool black = (symbol.get(x, y) == 1);
+                if (functions.get(x, y) == 255) {
+                    black ^= MaskUtil::getDataMaskBit(chosen, x, y) ^
+                        MaskUtil::getDataMaskBit(mask, x, y);
+                }
+                masked.set(x, y, black);
+            }
+        }
+        MatrixUtil::embedTypeInfo(aLevel, mask, masked);
+
+        std::vector<unsigned int> rows, columns;
+        pack(masked, &rows, &columns);
+        const int packed = MaskUtil::calculateMaskPenalty(&rows[0],
+            &columns[0], n);
+        const int reference = referencePenalty(masked);
+        if (packed != reference) {
+            printf("mask penalty: version %d-%s mask %d: %d instead of %d\n",
+                version.getVersionNumber(), aLevel.name().c_str(), mask,
+                packed, reference);
+            return false;
+        }
+        if (bestMask < 0 || reference < minPenalty) {
+            minPenalty = reference;
+            bestMask = mask;
+        }
+    }
+    if (bestMask != chosen) {
+        printf("mask penalty: version %d-%s got mask %d instead of %d\n",
+            version.getVersionNumber(), aLevel.name().c_str(), chosen,
+            bestMask);
+        return false;
+    }
+    return true;
+}
+
+// Payloads of each mode grow by a quarter until they no longer fit into
+// version 40, which covers the versions with and without version info
+// and alignment patterns, at every error correction level
+bool MaskTest::testMaskPenalty()
+{
+    ErrorCorrectionLevel* levels[] = {
+        &ErrorCorrectionLevel::L, &ErrorCorrectionLevel::M,
+        &ErrorCorrectionLevel::Q, &ErrorCorrectionLevel::H
+    };
+    const std::string alphabets[] = {
+        std::string(NUMERIC), std::string(ALPHANUMERIC), std::string(BYTES)
+    };
+    unsigned int seed = 1;
+    int symbols = 0;
+    for (size_t i = 0; i < sizeof(levels)/sizeof(levels[0]); i++) {
+        for (size_t k = 0; k < sizeof(alphabets)/sizeof(alphabets[0]); k++) {
+            const std::string& alphabet = alphabets[k];
+            for (int length = 1; ; length += length / 4 + 1) {
+                std::string text;
+                for (int j = 0; j < length; j++) {
+                    text += alphabet[nextRandom(&seed) % alphabet.size()];
+                }
+                Ref<QRCode> code;
+                try {
+                    code = Encoder::encode(text, *levels[i]);
+                } catch (zxing::Exception&) {
+                    // Doesn't fit any more
+                    break;
+                }
+                if (!checkSymbol(code, *levels[i])) {
+                    return false;
+                }
+                symbols++;
+            }
+        }
+    }
+    printf("mask penalty: %d symbols OK\n", symbols);
+    return true;
+}
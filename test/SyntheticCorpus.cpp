@@ -0,0 +1,291 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "SyntheticCorpus.h"
+
+#include <zxing/EncodeHint.h>
+#include <zxing/Exception.h>
+#include <zxing/qrcode/ErrorCorrectionLevel.h>
+#include <zxing/qrcode/encoder/ByteMatrix.h>
+#include <zxing/qrcode/encoder/Encoder.h>
+#include <zxing/qrcode/encoder/QRCode.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#define QUIET_ZONE  (4)     // Modules
+#define MAX_SIZE    (790)   // Pixels, below what gets scaled down
+
+#ifndef M_PI
+#  define M_PI 3.14159265358979323846
+#endif
+
+static const char* const TEXTS[] = {
+    "https://github.com/monich/sailfish-barcode",
+    "1234567890123456789012345678901234567890",
+    "HELLO WORLD 0123456789 $%*+-./:",
+    "WIFI:S:Home network;T:WPA;P:correct horse battery staple;;",
+    "BEGIN:VCARD\nVERSION:3.0\nN:Doe;John\nTEL:+1-555-0100\n"
+    "EMAIL:john.doe@example.com\nEND:VCARD",
+    // Cyrillic, to get the UTF-8 ECI
+    "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82, "
+    "\xd0\xbc\xd0\xb8\xd1\x80!",
+    "geo:60.1699,24.9384?z=15",
+    "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+    "eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim "
+    "ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut "
+    "aliquip ex ea commodo consequat. Duis aute irure dolor in "
+    "reprehenderit in voluptate velit esse cillum dolore eu fugiat.",
+    // Japanese
+    "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe3\x83\x86\xe3"
+    "\x82\xad\xe3\x82\xb9\xe3\x83\x88",
+    "MECARD:N:Smith,Anna;TEL:0123456789;;"
+};
+
+static const int TEXT_COUNT = sizeof(TEXTS)/sizeof(TEXTS[0]);
+static const int EC_LEVEL_COUNT = 4;
+
+// ==========================================================================
+// Random
+// ==========================================================================
+
+// xorshift32, rand() differs between C libraries
+class Random {
+public:
+    Random(unsigned int aSeed) : iState(aSeed ? aSeed : 1) {}
+
+    unsigned int next()
+    {
+        iState ^= iState << 13;
+        iState ^= iState >> 17;
+        iState ^= iState << 5;
+        return iState;
+    }
+
+    // [aMin, aMax]
+    int range(int aMin, int aMax)
+        { return aMin + (int)(next() % (unsigned int)(aMax - aMin + 1)); }
+
+    // [aMin, aMax)
+    double uniform(double aMin, double aMax)
+        { return aMin + (aMax - aMin) * (next() >> 8) / 16777216.0; }
+
+private:
+    unsigned int iState;
+};
+
+// ==========================================================================
+// Homography
+// ==========================================================================
+
+// Maps the unit square onto a quadrilateral and back, the way
+// zxing::PerspectiveTransform does but in double precision
+class Homography {
+public:
+    Homography(const double* aX, const double* aY);
+
+    void unmap(double aX, double aY, double* aU, double* aV) const;
+
+private:
+    double iInv[9];
+};
+
+Homography::Homography(const double* x, const double* y)
+{
+    double a11, a21, a31, a12, a22, a32, a13, a23;
+    const double dx3 = x[0] - x[1] + x[2] - x[3];
+    const double dy3 = y[0] - y[1] + y[2] - y[3];
+    if (dx3 == 0 && dy3 == 0) {
+        a11 = x[1] - x[0]; a21 = x[2] - x[1]; a31 = x[0];
+        a12 = y[1] - y[0]; a22 = y[2] - y[1]; a32 = y[0];
+        a13 = a23 = 0;
+    } else {
+        const double dx1 = x[1] - x[2], dx2 = x[3] - x[2];
+        const double dy1 = y[1] - y[2], dy2 = y[3] - y[2];
+        const double denominator = dx1 * dy2 - dx2 * dy1;
+        a13 = (dx3 * dy2 - dx2 * dy3) / denominator;
+        a23 = (dx1 * dy3 - dx3 * dy1) / denominator;
+        a11 = x[1] - x[0] + a13 * x[1];
+        a21 = x[3] - x[0] + a23 * x[3];
+        a31 = x[0];
+        a12 = y[1] - y[0] + a13 * y[1];
+        a22 = y[3] - y[0] + a23 * y[3];
+        a32 = y[0];
+    }
+
+    // The adjugate is as good as the inverse for projective mapping
+    iInv[0] = a22 - a23 * a32;
+    iInv[1] = a23 * a31 - a21;
+    iInv[2] = a21 * a32 - a22 * a31;
+    iInv[3] = a13 * a32 - a12;
+    iInv[4] = a11 - a13 * a31;
+    iInv[5] = a12 * a31 - a11 * a32;
+    iInv[6] = a12 * a23 - a13 * a22;
+    iInv[7] = a13 * a21 - a11 * a23;
+    iInv[8] = a11 * a22 - a12 * a21;
+}
+
+void Homography::unmap(double aX, double aY, double* aU, double* aV) const
+{
+    const double w = iInv[6] * aX + iInv[7] * aY + iInv[8];
+    *aU = (iInv[0] * aX + iInv[1] * aY + iInv[2]) / w;
+    *aV = (iInv[3] * aX + iInv[4] * aY + iInv[5]) / w;
+}
+
+// ==========================================================================
+// SyntheticCorpus
+// ==========================================================================
+
+int SyntheticCorpus::count()
+{
+    // Each text at each error correction level
+    return TEXT_COUNT * EC_LEVEL_COUNT;
+}
+
+bool SyntheticCorpus::generate(int aIndex, Sample* aSample)
+{
+    if (aIndex < 0 || aIndex >= count()) {
+        return false;
+    }
+
+    static zxing::qrcode::ErrorCorrectionLevel* const EC_LEVELS[] = {
+        &zxing::qrcode::ErrorCorrectionLevel::L,
+        &zxing::qrcode::ErrorCorrectionLevel::M,
+        &zxing::qrcode::ErrorCorrectionLevel::Q,
+        &zxing::qrcode::ErrorCorrectionLevel::H
+    };
+
+    const std::string text(TEXTS[aIndex % TEXT_COUNT]);
+    zxing::Ref<zxing::qrcode::ByteMatrix> matrix;
+    try {
+        bool ascii = true;
+        for (size_t i = 0; i < text.size() && ascii; i++) {
+            ascii = !(text[i] & 0x80);
+        }
+        zxing::EncodeHint hints;
+        hints.setCharacterSet("UTF-8");
+        matrix = zxing::qrcode::Encoder::encode(text,
+            *EC_LEVELS[aIndex / TEXT_COUNT], ascii ? NULL : &hints)->
+            getMatrix();
+    } catch (zxing::Exception& e) {
+        fprintf(stderr, "Failed to encode sample %d: %s\n", aIndex, e.what());
+        return false;
+    }
+
+    Random random(0x9e3779b9u ^ ((unsigned int)aIndex * 2654435761u));
+    const int dim = (int)matrix->getWidth();
+    const int n = dim + 2 * QUIET_ZONE;
+
+    // Every few samples is a light on dark or mirrored one, the rest is
+    // randomly rotated, skewed, lit, blurred and noisy
+    const bool inverted = (aIndex % 8) == 5;
+    const bool mirrored = (aIndex % 8) == 6;
+    const double angle = (aIndex % 3) ?
+        random.uniform(-0.3, 0.3) : random.uniform(0, 2 * M_PI);
+    const double skew = random.uniform(0, 0.07);
+    const double canvasScale = random.uniform(1.5, 1.8);
+    const double maxModuleSize = MAX_SIZE / (n * 1.8);
+    const double moduleSize = random.uniform(3.5, 6.5);
+    const int light = random.range(190, 250);
+    const int dark = random.range(10, 80);
+    const int shade = random.range(0, 50);
+    // Small modules can take less blur
+    const int blur = random.range(0, (moduleSize < 4.5) ? 1 : 2);
+    const int noise = random.range(0, 20);
+
+    const double side = n * ((moduleSize < maxModuleSize) ?
+        moduleSize : maxModuleSize);
+    const int width = (int)(side * canvasScale);
+    const int height = (int)(side * random.uniform(1.5, canvasScale));
+    const double cx = width / 2.0 + random.uniform(-0.05, 0.05) * side;
+    const double cy = height / 2.0 + random.uniform(-0.05, 0.05) * side;
+    const double c = cos(angle), s = sin(angle);
+    static const int CORNER_X[4] = { -1, 1, 1, -1 };
+    static const int CORNER_Y[4] = { -1, -1, 1, 1 };
+    double qx[4], qy[4];
+    for (int i = 0; i < 4; i++) {
+        const double x = CORNER_X[i] * side / 2;
+        const double y = CORNER_Y[i] * side / 2;
+        qx[i] = cx + c * x - s * y + random.uniform(-skew, skew) * side;
+        qy[i] = cy + s * x + c * y + random.uniform(-skew, skew) * side;
+    }
+    const Homography homography(qx, qy);
+
+    // Render with 2x2 samples per pixel
+    std::vector<int> pixels(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int hits = 0;
+            for (int k = 0; k < 4; k++) {
+                double u, v;
+                homography.unmap(x + 0.25 + 0.5 * (k & 1),
+                    y + 0.25 + 0.5 * (k >> 1), &u, &v);
+                const int mx = (int)floor(u * n) - QUIET_ZONE;
+                const int my = (int)floor(v * n) - QUIET_ZONE;
+                if (mx >= 0 && mx < dim && my >= 0 && my < dim &&
+                    matrix->get(mirrored ? (dim - 1 - mx) : mx, my) == 1) {
+                    hits++;
+                }
+            }
+            // Darker towards the bottom right corner
+            const int paper = light - shade * (x + y) / (width + height);
+            pixels[y * width + x] = paper - (paper - dark) * hits / 4;
+        }
+    }
+
+    for (int pass = 0; pass < blur; pass++) {
+        std::vector<int> blurred(pixels.size());
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int sum = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    const int yy = (y + dy < 0) ? 0 :
+                        (y + dy >= height) ? (height - 1) : (y + dy);
+                    for (int dx = -1; dx <= 1; dx++) {
+                        const int xx = (x + dx < 0) ? 0 :
+                            (x + dx >= width) ? (width - 1) : (x + dx);
+                        sum += pixels[yy * width + xx];
+                    }
+                }
+                blurred[y * width + x] = sum / 9;
+            }
+        }
+        pixels.swap(blurred);
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "synthetic/qr-%02d", aIndex);
+    aSample->iName = name;
+    aSample->iText = text;
+    aSample->iWidth = width;
+    aSample->iHeight = height;
+    aSample->iPixels.resize(width * height);
+    for (int i = 0; i < width * height; i++) {
+        int value = pixels[i] + (noise ? random.range(-noise, noise) : 0);
+        value = (value < 0) ? 0 : (value > 255) ? 255 : value;
+        aSample->iPixels[i] = (unsigned char)(inverted ? (255 - value) : value);
+    }
+    return true;
+}
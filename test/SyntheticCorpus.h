@@ -0,0 +1,57 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef BARCODE_SYNTHETIC_CORPUS_H
+#define BARCODE_SYNTHETIC_CORPUS_H
+
+#include <string>
+#include <vector>
+
+// QR codes made by the bundled encoder and then put through perspective,
+// blur, uneven lighting and noise. Everything is computed from the sample
+// index with plain C++ (no Qt, no rand()) so that the same images come out
+// on every build, which is what makes the expected results meaningful.
+class SyntheticCorpus {
+public:
+    class Sample {
+    public:
+        Sample() : iWidth(0), iHeight(0) {}
+
+    public:
+        std::string iName;
+        std::string iText;                  // UTF-8
+        int iWidth;
+        int iHeight;
+        std::vector<unsigned char> iPixels; // 8-bit gray, row after row
+    };
+
+    static int count();
+    static bool generate(int aIndex, Sample* aSample);
+
+private:
+    SyntheticCorpus();
+};
+
+#endif // BARCODE_SYNTHETIC_CORPUS_H
@@ -0,0 +1,160 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "TrackingTest.h"
+#include "Decoder.h"
+
+#include <QDir>
+
+#include <zxing/Exception.h>
+#include <zxing/qrcode/ErrorCorrectionLevel.h>
+#include <zxing/qrcode/encoder/ByteMatrix.h>
+#include <zxing/qrcode/encoder/Encoder.h>
+#include <zxing/qrcode/encoder/QRCode.h>
+
+#include <stdio.h>
+
+#define QR_TEXT "https://sailfishos.org/tracking"
+#define DM_FILE "corpus/DATA_MATRIX/dm-03.png"
+#define DM_TEXT "0123456789ABCDEF"
+// The middle of the symbol in DM_FILE, away from the L and timing sides
+#define DM_DAMAGE QRect(62, 62, 50, 50)
+#define QR_MODULE_SIZE (4)
+#define QR_OFFSET (100)
+
+// Draws the code as the viewfinder would show it. A damaged code has
+// the middle inverted, finder and alignment patterns are left alone,
+// so it's found but doesn't decode.
+static QImage qrFrame(bool aDamaged)
+{
+    zxing::Ref<zxing::qrcode::ByteMatrix> matrix;
+    try {
+        matrix = zxing::qrcode::Encoder::encode(QR_TEXT,
+            zxing::qrcode::ErrorCorrectionLevel::L)->getMatrix();
+    } catch (zxing::Exception& e) {
+        fprintf(stderr, "Failed to encode %s: %s\n", QR_TEXT, e.what());
+        return QImage();
+    }
+
+    const int n = (int)matrix->getWidth();
+    const int size = n * QR_MODULE_SIZE + 2 * QR_OFFSET;
+    QImage image(size, size, QImage::Format_RGB32);
+    image.fill(qRgb(255, 255, 255));
+    for (int y = 0; y < n; y++) {
+        for (int x = 0; x < n; x++) {
+            bool dark = matrix->get(x, y) == 1;
+            if (aDamaged && x >= 9 && y >= 9 && x < n - 9 && y < n - 9 &&
+                !(x >= n - 10 && y >= n - 10)) {
+                dark = !dark;
+            }
+            if (dark) {
+                for (int dy = 0; dy < QR_MODULE_SIZE; dy++) {
+                    QRgb* row = (QRgb*)image.scanLine(QR_OFFSET +
+                        y * QR_MODULE_SIZE + dy) + QR_OFFSET +
+                        x * QR_MODULE_SIZE;
+                    for (int dx = 0; dx < QR_MODULE_SIZE; dx++) {
+                        row[dx] = qRgb(0, 0, 0);
+                    }
+                }
+            }
+        }
+    }
+    return image;
+}
+
+// The damaged frame fails upright and then rotated, like it would in
+// BarcodeScanner. The rotated attempt must not make the QR reader forget
+// where it has seen the code.
+bool TrackingTest::testQrCode()
+{
+    const QImage damaged(qrFrame(true));
+    const QImage good(qrFrame(false));
+    if (damaged.isNull() || good.isNull()) {
+        return false;
+    }
+
+    Decoder decoder;
+    Profiler::Frame frame;
+    if (decoder.decode(damaged, &frame).isValid() ||
+        decoder.decodeRotated(damaged, &frame).isValid()) {
+        printf("tracking QR_CODE: damaged frame decoded\n");
+        return false;
+    }
+
+    Profiler::Frame nextFrame;
+    const Decoder::Result result(decoder.decode(good, &nextFrame));
+    if (!result.isValid() || result.getText() != QR_TEXT) {
+        printf("tracking QR_CODE: good frame didn't decode\n");
+        return false;
+    }
+    if (!nextFrame.iReaderTracked[Profiler::ReaderQrCode]) {
+        printf("tracking QR_CODE: good frame wasn't tracked\n");
+        return false;
+    }
+    printf("tracking QR_CODE: OK\n");
+    return true;
+}
+
+// A symbol that's found but doesn't decode must still be tracked in the
+// next frame, since the scanner stops at the first one that decodes
+bool TrackingTest::testDataMatrix(QString aDataDir)
+{
+    const QString path(QDir(aDataDir).filePath(DM_FILE));
+    const QImage good(QImage(path).convertToFormat(QImage::Format_RGB32));
+    if (good.isNull()) {
+        fprintf(stderr, "Can't load %s\n", qPrintable(path));
+        return false;
+    }
+
+    QImage damaged(good);
+    const QRect damage(DM_DAMAGE);
+    for (int y = damage.top(); y <= damage.bottom(); y++) {
+        QRgb* row = (QRgb*)damaged.scanLine(y);
+        for (int x = damage.left(); x <= damage.right(); x++) {
+            const int gray = 255 - qGray(row[x]);
+            row[x] = qRgb(gray, gray, gray);
+        }
+    }
+
+    Decoder decoder;
+    Profiler::Frame frame;
+    if (decoder.decode(damaged, &frame).isValid()) {
+        printf("tracking DATA_MATRIX: damaged frame decoded\n");
+        return false;
+    }
+
+    Profiler::Frame nextFrame;
+    const Decoder::Result result(decoder.decode(good, &nextFrame));
+    if (!result.isValid() || result.getText() != DM_TEXT) {
+        printf("tracking DATA_MATRIX: good frame didn't decode\n");
+        return false;
+    }
+    if (!nextFrame.iReaderTracked[Profiler::ReaderDataMatrix]) {
+        printf("tracking DATA_MATRIX: good frame wasn't tracked\n");
+        return false;
+    }
+    printf("tracking DATA_MATRIX: OK\n");
+    return true;
+}
@@ -0,0 +1,458 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Slava Monich
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "Decoder.h"
+#include "MaskTest.h"
+#include "SyntheticCorpus.h"
+#include "TrackingTest.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QTextStream>
+
+#include <stdio.h>
+#include <string.h>
+
+// Same as in BarcodeScanner::Private::decodingThread()
+#define MAX_SIZE (800)
+
+#define GOLDEN_FILE "golden.txt"
+#define XFAIL_FILE  "xfail.txt"
+#define CORPUS_DIR  "corpus"
+
+#define RET_OK          (0)
+#define RET_MISMATCH    (1)
+#define RET_ERR         (2)
+
+// ==========================================================================
+// GoldenTest
+// ==========================================================================
+
+class GoldenTest {
+public:
+    GoldenTest(bool aVerbose);
+
+    bool loadExpectedFailures(QString aFile);
+    void run(QString aName, QImage aImage, QString aFormat, QString aText);
+    int compare(QString aGoldenFile);
+    bool save(QString aGoldenFile);
+    void report();
+
+private:
+    class FormatStats {
+    public:
+        FormatStats() : iSamples(0), iHits(0) {}
+        int iSamples;
+        int iHits;
+    };
+
+    Decoder::Result decode(QImage aImage);
+    static QString escape(QString aText);
+    static bool sameResult(QString aExpected, QString aActual);
+
+private:
+    bool iVerbose;
+    int iUnexpectedPasses;
+    QMap<QString,QString> iExpectedFailures;
+    QStringList iNames;
+    QMap<QString,QString> iResults;
+    QMap<QString,FormatStats> iStats;
+};
+
+GoldenTest::GoldenTest(bool aVerbose) :
+    iVerbose(aVerbose),
+    iUnexpectedPasses(0)
+{
+}
+
+// Samples that are known not to decode, name<TAB>reason. They are not
+// golden results, just reported as XFAIL on every run until they start
+// decoding, which then fails the run as XPASS.
+bool GoldenTest::loadExpectedFailures(QString aFile)
+{
+    QFile file(aFile);
+    if (!file.exists()) {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fprintf(stderr, "Can't open %s\n", qPrintable(aFile));
+        return false;
+    }
+    while (!file.atEnd()) {
+        const QString line(QString::fromUtf8(file.readLine()).
+            remove('\n'));
+        if (!line.isEmpty() && !line.startsWith('#')) {
+            iExpectedFailures.insert(line.section('\t', 0, 0),
+                line.section('\t', 1));
+        }
+    }
+    return true;
+}
+
+// The same steps as BarcodeScanner::Private::decodingThread() takes
+// after cropping, with the optional inverted and mirrored retries on.
+// Each image gets its own Decoder so that the readers don't track a code
+// found in the previous image and the results don't depend on the order
+// in which the images are decoded.
+Decoder::Result GoldenTest::decode(QImage aImage)
+{
+    Decoder decoder;
+    decoder.setTryInverted(true);
+    decoder.setTryMirrored(true);
+    qreal scale;
+    QImage scaledImage(Decoder::scaleDown(aImage, MAX_SIZE, &scale));
+    Decoder::Result result(decoder.decode(scaledImage));
+    if (!result.isValid()) {
+        result = decoder.decodeRotated(scaledImage);
+    }
+    if (result.isValid() && scale > 1) {
+        QList<QPointF> points = result.getPoints();
+        for (int i = 0; i < points.size(); i++) {
+            points[i] *= scale;
+        }
+        result = Decoder::Result(result.getText(), points,
+            result.getFormat());
+    }
+    return result;
+}
+
+QString GoldenTest::escape(QString aText)
+{
+    QString text(aText);
+    text.replace('\\', "\\\\");
+    text.replace('\n', "\\n");
+    text.replace('\r', "\\r");
+    text.replace('\t', "\\t");
+    return text;
+}
+
+void GoldenTest::run(QString aName, QImage aImage, QString aFormat,
+    QString aText)
+{
+    const Decoder::Result result(decode(aImage));
+    QString line(aName);
+    line += '\t';
+    if (result.isValid()) {
+        QStringList points;
+        const QList<QPointF> found(result.getPoints());
+        for (int i = 0; i < found.size(); i++) {
+            points.append(QString::number(found.at(i).x(), 'f', 2) + ',' +
+                QString::number(found.at(i).y(), 'f', 2));
+        }
+        line += result.getFormatName() + '\t' + points.join(' ') + '\t' +
+            escape(result.getText());
+    } else {
+        line += '-';
+    }
+
+    const bool hit = result.isValid() &&
+        result.getFormatName() == aFormat &&
+        (aText.isNull() || result.getText() == aText);
+    FormatStats& stats = iStats[aFormat];
+    stats.iSamples++;
+    if (hit) {
+        stats.iHits++;
+    }
+    if (iVerbose) {
+        printf("%s %s\n", qPrintable(aName), hit ? "OK" : "MISS");
+    }
+
+    if (iExpectedFailures.contains(aName)) {
+        if (hit) {
+            printf("XPASS %s\n", qPrintable(line));
+            iUnexpectedPasses++;
+        } else {
+            printf("XFAIL %s (%s)\n", qPrintable(aName),
+                qPrintable(iExpectedFailures.value(aName)));
+        }
+        return;
+    }
+
+    iNames.append(aName);
+    iResults.insert(aName, line);
+}
+
+// Points are allowed to move by a rounding error
+bool GoldenTest::sameResult(QString aExpected, QString aActual)
+{
+    if (aExpected == aActual) {
+        return true;
+    }
+    const QStringList expected(aExpected.split('\t'));
+    const QStringList actual(aActual.split('\t'));
+    if (expected.count() != 4 || actual.count() != 4 ||
+        expected.at(1) != actual.at(1) || expected.at(3) != actual.at(3)) {
+        return false;
+    }
+    const QStringList expectedPoints(expected.at(2).split(' '));
+    const QStringList actualPoints(actual.at(2).split(' '));
+    if (expectedPoints.count() != actualPoints.count()) {
+        return false;
+    }
+    for (int i = 0; i < expectedPoints.count(); i++) {
+        const QStringList e(expectedPoints.at(i).split(','));
+        const QStringList a(actualPoints.at(i).split(','));
+        if (e.count() != 2 || a.count() != 2 ||
+            qAbs(e.at(0).toDouble() - a.at(0).toDouble()) > 0.1 ||
+            qAbs(e.at(1).toDouble() - a.at(1).toDouble()) > 0.1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int GoldenTest::compare(QString aGoldenFile)
+{
+    QFile file(aGoldenFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fprintf(stderr, "Can't open %s\n", qPrintable(aGoldenFile));
+        return RET_ERR;
+    }
+
+    QMap<QString,QString> expected;
+    QStringList missing;
+    while (!file.atEnd()) {
+        const QString line(QString::fromUtf8(file.readLine()).
+            remove('\n'));
+        if (!line.isEmpty() && !line.startsWith('#')) {
+            const QString name(line.section('\t', 0, 0));
+            expected.insert(name, line);
+            if (!iResults.contains(name)) {
+                missing.append(name);
+            }
+        }
+    }
+
+    int failures = 0;
+    for (int i = 0; i < iNames.count(); i++) {
+        const QString name(iNames.at(i));
+        const QString actual(iResults.value(name));
+        if (!expected.contains(name)) {
+            printf("NEW  %s\n", qPrintable(actual));
+            failures++;
+        } else if (!sameResult(expected.value(name), actual)) {
+            printf("WAS  %s\nNOW  %s\n", qPrintable(expected.value(name)),
+                qPrintable(actual));
+            failures++;
+        }
+    }
+    for (int i = 0; i < missing.count(); i++) {
+        printf("GONE %s\n", qPrintable(missing.at(i)));
+        failures++;
+    }
+
+    if (failures) {
+        printf("%d of %d result(s) changed. If that's intended, run with "
+            "--update and commit %s\n", failures, iNames.count(),
+            GOLDEN_FILE);
+        return RET_MISMATCH;
+    }
+    if (iUnexpectedPasses) {
+        printf("%d sample(s) listed in %s decode now. Remove them from "
+            "there, run with --update and commit both files\n",
+            iUnexpectedPasses, XFAIL_FILE);
+        return RET_MISMATCH;
+    }
+    printf("All %d results match %s\n", iNames.count(), GOLDEN_FILE);
+    return RET_OK;
+}
+
+bool GoldenTest::save(QString aGoldenFile)
+{
+    QFile file(aGoldenFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        fprintf(stderr, "Can't write %s\n", qPrintable(aGoldenFile));
+        return false;
+    }
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    out << "# Expected decoder output, regenerate with barcode-test --update\n"
+        "# name<TAB>format<TAB>points<TAB>text, or name<TAB>- if nothing "
+        "is found\n";
+    for (int i = 0; i < iNames.count(); i++) {
+        out << iResults.value(iNames.at(i)) << '\n';
+    }
+    printf("Wrote %d results to %s\n", iNames.count(), qPrintable(aGoldenFile));
+    return true;
+}
+
+void GoldenTest::report()
+{
+    printf("\n%-20s %8s %8s\n", "format", "samples", "decoded");
+    QMapIterator<QString,FormatStats> it(iStats);
+    while (it.hasNext()) {
+        it.next();
+        printf("%-20s %8d %8d\n", qPrintable(it.key()),
+            it.value().iSamples, it.value().iHits);
+    }
+    printf("\n");
+}
+
+// ==========================================================================
+// main
+// ==========================================================================
+
+static QImage sampleImage(const SyntheticCorpus::Sample& aSample)
+{
+    QImage image(aSample.iWidth, aSample.iHeight, QImage::Format_Indexed8);
+    QVector<QRgb> gray(256);
+    for (int i = 0; i < 256; i++) {
+        gray[i] = qRgb(i, i, i);
+    }
+    image.setColorTable(gray);
+    for (int y = 0; y < aSample.iHeight; y++) {
+        memcpy(image.scanLine(y), &aSample.iPixels[y * aSample.iWidth],
+            aSample.iWidth);
+    }
+    return image;
+}
+
+// Writes synthetic samples the way the benchmark expects them
+static int generate(QString aDir)
+{
+    const QString format(QLatin1String(zxing::BarcodeFormat::
+        barcodeFormatNames[zxing::BarcodeFormat::QR_CODE]));
+    QDir dir(aDir);
+    if (!dir.mkpath(format)) {
+        fprintf(stderr, "Can't create %s\n", qPrintable(dir.filePath(format)));
+        return RET_ERR;
+    }
+    dir.cd(format);
+    const int n = SyntheticCorpus::count();
+    for (int i = 0; i < n; i++) {
+        SyntheticCorpus::Sample sample;
+        if (SyntheticCorpus::generate(i, &sample)) {
+            const QString base(dir.filePath(QFileInfo(QString::
+                fromStdString(sample.iName)).fileName()));
+            QFile text(base + ".txt");
+            if (!sampleImage(sample).save(base + ".png") ||
+                !text.open(QIODevice::WriteOnly)) {
+                fprintf(stderr, "Can't write %s\n", qPrintable(base));
+                return RET_ERR;
+            }
+            text.write(sample.iText.data(), sample.iText.size());
+        }
+    }
+    printf("Wrote %d samples to %s\n", n, qPrintable(dir.path()));
+    return RET_OK;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decodes the test corpus and compares "
+        "the results with " GOLDEN_FILE ".");
+    parser.addHelpOption();
+    parser.addPositionalArgument("DIR", "Directory with " GOLDEN_FILE
+        " and " CORPUS_DIR " (default " TEST_DATA_DIR ")", "[DIR]");
+    QCommandLineOption updateOption(QStringList() << "u" << "update",
+        "Write the results to " GOLDEN_FILE " instead of checking them");
+    QCommandLineOption generateOption(QStringList() << "g" << "generate",
+        "Write the synthetic samples to OUT for the benchmark and exit",
+        "OUT");
+    QCommandLineOption verboseOption(QStringList() << "v" << "verbose",
+        "Print the result for each sample");
+    parser.addOption(updateOption);
+    parser.addOption(generateOption);
+    parser.addOption(verboseOption);
+    parser.process(app);
+
+    if (parser.isSet(generateOption)) {
+        return generate(parser.value(generateOption));
+    }
+
+    const QStringList args(parser.positionalArguments());
+    if (args.count() > 1) {
+        parser.showHelp(RET_ERR);
+    }
+    const QDir dataDir(args.isEmpty() ? QString(TEST_DATA_DIR) : args.at(0));
+
+    // Images in directories named after the format, FILE.txt next to
+    // FILE.png has the text. Sorted, because readers keep state between
+    // frames and the order matters.
+    QStringList files;
+    QDirIterator it(dataDir.filePath(CORPUS_DIR), QStringList() << "*.png",
+        QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.append(dataDir.relativeFilePath(it.next()));
+    }
+    files.sort();
+
+    GoldenTest test(parser.isSet(verboseOption));
+    if (!test.loadExpectedFailures(dataDir.filePath(XFAIL_FILE))) {
+        return RET_ERR;
+    }
+    for (int i = 0; i < files.count(); i++) {
+        const QString path(dataDir.filePath(files.at(i)));
+        const QFileInfo info(path);
+        QFile text(info.dir().filePath(info.completeBaseName() + ".txt"));
+        QString expected;
+        if (text.open(QIODevice::ReadOnly)) {
+            expected = QString::fromUtf8(text.readAll());
+        }
+        QImage image(path);
+        if (image.isNull()) {
+            fprintf(stderr, "Can't load %s\n", qPrintable(path));
+            return RET_ERR;
+        }
+        test.run(files.at(i), image, info.dir().dirName(), expected);
+    }
+
+    const QString qrCode(QLatin1String(zxing::BarcodeFormat::
+        barcodeFormatNames[zxing::BarcodeFormat::QR_CODE]));
+    const int n = SyntheticCorpus::count();
+    for (int i = 0; i < n; i++) {
+        SyntheticCorpus::Sample sample;
+        if (SyntheticCorpus::generate(i, &sample)) {
+            test.run(QString::fromStdString(sample.iName),
+                sampleImage(sample), qrCode,
+                QString::fromUtf8(sample.iText.data(), sample.iText.size()));
+        }
+    }
+
+    test.report();
+    const QString golden(dataDir.filePath(GOLDEN_FILE));
+    if (parser.isSet(updateOption)) {
+        return test.save(golden) ? RET_OK : RET_ERR;
+    }
+
+    int ret = test.compare(golden);
+    if (!TrackingTest::testQrCode() && ret == RET_OK) {
+        ret = RET_MISMATCH;
+    }
+    if (!TrackingTest::testDataMatrix(dataDir.path()) && ret == RET_OK) {
+        ret = RET_MISMATCH;
+    }
+    if (!MaskTest::testMaskPenalty() && ret == RET_OK) {
+        ret = RET_MISMATCH;
+    }
+    return ret;
+}
@@ -0,0 +1,47 @@
+# Decodes the images in corpus/ plus synthetic QR codes and fails if
+# anything comes out differently from what golden.txt says, if the
+# readers that track codes across frames stop doing so, or if the QR
+# encoder picks a different mask than the MaskUtil rules would:
+#
+#   qmake && make check
+#
+# Samples listed in xfail.txt are reported as XFAIL instead and fail the
+# run if they start decoding. After an intended change in the results, run
+# barcode-test --update and commit golden.txt. barcode-test --generate DIR
+# writes the synthetic samples out so that the benchmark can run on them
+# too.
+
+TEMPLATE = app
+TARGET = barcode-test
+CONFIG += console
+CONFIG -= app_bundle
+QT = core gui
+
+DEFINES += TEST_DATA_DIR=\\\"$$PWD\\\"
+
+INCLUDEPATH += \
+    ../src/scanner \
+    ../harbour-lib/include
+
+SOURCES += \
+    main.cpp \
+    MaskTest.cpp \
+    SyntheticCorpus.cpp \
+    TrackingTest.cpp \
+    ../src/scanner/Decoder.cpp \
+    ../src/scanner/ImageSource.cpp \
+    ../src/scanner/Profiler.cpp
+
+HEADERS += \
+    MaskTest.h \
+    SyntheticCorpus.h \
+    TrackingTest.h \
+    ../src/scanner/Decoder.h \
+    ../src/scanner/ImageSource.h \
+    ../src/scanner/Profiler.h
+
+include(../src/zxing/zxing.pri)
+
+check.commands = ./$${TARGET}
+check.depends = $${TARGET}
+QMAKE_EXTRA_TARGETS += check